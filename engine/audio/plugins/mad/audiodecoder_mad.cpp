@@ -26,6 +26,9 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDateTime>
 #include <QDebug>
 
 #include <math.h>
@@ -34,8 +37,20 @@
 
 #define XING_MAGIC (('X' << 24) | ('i' << 16) | ('n' << 8) | 'g')
 #define INPUT_BUFFER_SIZE (32*1024)
+#define SEEK_INDEX_MAGIC (('Q' << 24) | ('L' << 16) | ('S' << 8) | 'I')
+#define SEEK_INDEX_VERSION 1
+#define SEEK_INDEX_EXTENSION ".qlcseek"
 #define USE_DITHERING
 
+AudioDecoderMAD::AudioDecoderMAD()
+    : AudioDecoder()
+{
+    // seek() might run on the AudioPrefetcher worker, while the total
+    // time is read by the thread owning the decoder
+    connect(this, SIGNAL(totalTimeChanged(qint64)),
+            this, SLOT(slotTotalTimeChanged(qint64)));
+}
+
 AudioDecoderMAD::~AudioDecoderMAD()
 {
     deinit();
@@ -67,6 +82,9 @@ bool AudioDecoderMAD::initialize(const QString &path)
     m_output_at = 0;
     m_skip_frames = 0;
     m_eof = false;
+    m_seekIndex.clear();
+    m_seekIndexPending = false;
+    m_frameSamples = 0;
 
     m_left_dither.random = 0;
     m_left_dither.error[0] = 0;
@@ -107,6 +125,15 @@ bool AudioDecoderMAD::initialize(const QString &path)
         qDebug("DecoderMAD: Can't find a valid MPEG header.");
         return false;
     }
+
+    // scanning a whole file takes a while, so a missing index is built
+    // only when needed, by the first seek
+    if (!m_input.isSequential() && !loadSeekIndex())
+        m_seekIndexPending = true;
+
+    qint64 total = indexTotalTime();
+    if (total >= 0)
+        m_totalTime = total;
     mad_stream_buffer(&m_stream, (unsigned char *) m_input_buf, m_input_bytes);
     m_stream.error = MAD_ERROR_BUFLEN;
     mad_frame_mute (&m_frame);
@@ -138,6 +165,9 @@ void AudioDecoderMAD::deinit()
     m_output_at = 0;
     m_skip_frames = 0;
     m_eof = false;
+    m_seekIndex.clear();
+    m_seekIndexPending = false;
+    m_frameSamples = 0;
 
     if (m_input.isOpen())
         m_input.close();
@@ -388,7 +418,39 @@ qint64 AudioDecoderMAD::read(char *data, qint64 size)
 }
 void AudioDecoderMAD::seek(qint64 pos)
 {
-    if(m_totalTime > 0)
+    // seeking to the beginning doesn't need the index. Otherwise, this is
+    // run by the AudioPrefetcher worker, so building the index here
+    // doesn't block the caller.
+    if (m_seekIndexPending && pos > 0)
+    {
+        m_seekIndexPending = false;
+        buildSeekIndex();
+        saveSeekIndex();
+
+        qint64 total = indexTotalTime();
+        if (total >= 0)
+            emit totalTimeChanged(total);
+    }
+
+    if (!m_seekIndex.isEmpty() && m_freq > 0 && m_frameSamples > 0)
+    {
+        qint64 frame = (pos * m_freq) / (qint64(m_frameSamples) * 1000);
+        frame = qBound(qint64(0), frame, qint64(m_seekIndex.count() - 1));
+
+        // start a couple of frames earlier to fill the bit reservoir,
+        // and drop them once decoded
+        int skip = int(qMin(frame, qint64(2)));
+        m_input.seek(m_seekIndex.at(int(frame) - skip));
+        mad_frame_mute(&m_frame);
+        mad_synth_mute(&m_synth);
+        m_stream.error = MAD_ERROR_BUFLEN;
+        m_stream.sync = 0;
+        m_input_bytes = 0;
+        m_stream.next_frame = 0;
+        m_skip_frames = skip;
+        m_eof = 0;
+    }
+    else if(m_totalTime > 0)
     {
         qint64 seek_pos = qint64(pos * m_input.size() / m_totalTime);
         m_input.seek(seek_pos);
@@ -433,6 +495,150 @@ bool AudioDecoderMAD::fillBuffer()
     return true;
 }
 
+/*****************************************************************************
+ * Seek index
+ ****************************************************************************/
+
+QString AudioDecoderMAD::seekIndexPath() const
+{
+    return m_input.fileName() + SEEK_INDEX_EXTENSION;
+}
+
+bool AudioDecoderMAD::loadSeekIndex()
+{
+    QFile file(seekIndexPath());
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QFileInfo info(m_input.fileName());
+    QDataStream stream(&file);
+    quint32 magic = 0, version = 0, frameSamples = 0;
+    qint64 size = 0, modified = 0;
+    QVector<quint32> index;
+
+    stream >> magic >> version >> size >> modified >> frameSamples >> index;
+
+    if (stream.status() != QDataStream::Ok || magic != quint32(SEEK_INDEX_MAGIC) ||
+        version != SEEK_INDEX_VERSION || frameSamples == 0 || index.isEmpty())
+    {
+        qDebug() << "DecoderMAD: invalid seek index" << file.fileName();
+        return false;
+    }
+
+    // the audio file has been replaced since the index was saved
+    if (size != info.size() || modified != info.lastModified().toMSecsSinceEpoch())
+        return false;
+
+    m_seekIndex = index;
+    m_frameSamples = frameSamples;
+
+    return true;
+}
+
+void AudioDecoderMAD::saveSeekIndex() const
+{
+    if (m_seekIndex.isEmpty())
+        return;
+
+    QFile file(seekIndexPath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        // e.g. a read only folder. The index is built again next time.
+        qDebug() << "DecoderMAD: cannot save seek index" << file.fileName();
+        return;
+    }
+
+    QFileInfo info(m_input.fileName());
+    QDataStream stream(&file);
+
+    stream << quint32(SEEK_INDEX_MAGIC) << quint32(SEEK_INDEX_VERSION)
+           << qint64(info.size()) << qint64(info.lastModified().toMSecsSinceEpoch())
+           << m_frameSamples << m_seekIndex;
+}
+
+qint64 AudioDecoderMAD::indexTotalTime() const
+{
+    // the index gives the exact duration, even for VBR files without Xing header
+    if (m_seekIndex.isEmpty() || m_freq <= 0)
+        return -1;
+
+    return (qint64(m_seekIndex.count()) * m_frameSamples * 1000) / m_freq;
+}
+
+void AudioDecoderMAD::slotTotalTimeChanged(qint64 time)
+{
+    m_totalTime = time;
+}
+
+void AudioDecoderMAD::buildSeekIndex()
+{
+    QFile file(m_input.fileName());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    // only the headers are decoded, so scanning a whole file is quick
+    QByteArray buffer(INPUT_BUFFER_SIZE, 0);
+    unsigned char *data = (unsigned char *) buffer.data();
+    qint64 bufferPos = 0; // file offset of the first buffer byte
+
+    struct mad_stream stream;
+    struct mad_header header;
+    mad_stream_init(&stream);
+    mad_header_init(&header);
+
+    m_seekIndex.clear();
+    m_frameSamples = 0;
+
+    forever
+    {
+        if (stream.buffer == NULL || stream.error == MAD_ERROR_BUFLEN)
+        {
+            size_t remaining = 0;
+
+            if (stream.next_frame != NULL)
+            {
+                remaining = stream.bufend - stream.next_frame;
+                bufferPos += stream.next_frame - data;
+                memmove(data, stream.next_frame, remaining);
+            }
+
+            qint64 len = file.read((char *) data + remaining, INPUT_BUFFER_SIZE - remaining);
+            if (len <= 0)
+                break;
+
+            mad_stream_buffer(&stream, data, remaining + len);
+            stream.error = MAD_ERROR_NONE;
+        }
+
+        if (mad_header_decode(&header, &stream) < 0)
+        {
+            if (stream.error == MAD_ERROR_LOSTSYNC)
+            {
+                uint tagSize = findID3v2((uchar *)stream.this_frame,
+                                         (ulong) (stream.bufend - stream.this_frame));
+                if (tagSize > 0)
+                    mad_stream_skip(&stream, tagSize);
+                continue;
+            }
+            else if (stream.error == MAD_ERROR_BUFLEN || MAD_RECOVERABLE(stream.error))
+                continue;
+
+            qDebug("DecoderMAD: seek index stopped: %s", mad_stream_errorstr(&stream));
+            break;
+        }
+
+        if (m_frameSamples == 0)
+            m_frameSamples = 32 * MAD_NSBSAMPLES(&header);
+
+        m_seekIndex.append(quint32(bufferPos + (stream.this_frame - data)));
+    }
+
+    mad_header_finish(&header);
+    mad_stream_finish(&stream);
+
+    qDebug() << "DecoderMAD: indexed" << m_seekIndex.count() << "frames";
+}
+
 uint AudioDecoderMAD::findID3v2(uchar *data, ulong size) //retuns ID3v2 tag size
 {
     if (size < 10)
@@ -30,6 +30,7 @@
 #define AUDIODECODER_MAD_H
 
 #include <QFile>
+#include <QVector>
 #include <QStringList>
 
 #include "audiodecoder.h"
@@ -52,6 +53,7 @@ class AudioDecoderMAD : public AudioDecoder
 #endif
 
 public:
+    AudioDecoderMAD();
     virtual ~AudioDecoderMAD();
 
     /** @reimpl */
@@ -75,6 +77,10 @@ public:
     /** @reimpl */
     QStringList supportedFormats();
 
+private slots:
+    /** Store the duration computed by seek(), in the decoder's thread */
+    void slotTotalTimeChanged(qint64 time);
+
 private:
     // helper functions
     qint64 madOutput(char *data, qint64 size);
@@ -84,6 +90,14 @@ private:
     bool findXingHeader(struct mad_bitptr, unsigned int);
     uint findID3v2(uchar *data, ulong size);
 
+    // seek index
+    QString seekIndexPath() const;
+    bool loadSeekIndex();
+    void saveSeekIndex() const;
+    void buildSeekIndex();
+    /** Return the duration given by the seek index, or -1 without index */
+    qint64 indexTotalTime() const;
+
     QFile m_input;
     bool m_inited, m_eof;
     qint64 m_totalTime;
@@ -92,6 +106,15 @@ private:
     long m_freq, m_len;
     qint64 m_output_bytes, m_output_at;
 
+    /** File offset of each MPEG frame, to seek to the exact frame of a
+     *  given time. Loaded from the file's .qlcseek companion, or built by
+     *  scanning the frame headers and saved there on first seek. */
+    QVector<quint32> m_seekIndex;
+    /** True if the index could not be loaded and must be built */
+    bool m_seekIndexPending;
+    /** Number of samples per channel of each frame */
+    quint32 m_frameSamples;
+
     // file input buffer
     char *m_input_buf;
     qint64 m_input_bytes;
@@ -23,6 +23,7 @@
 #include <QDebug>
 #include <QFile>
 
+#include "audioprefetcher.h"
 #include "audiodecoder.h"
 #include "audiorenderer.h"
 #include "audioplugincache.h"
@@ -57,7 +58,9 @@ Audio::Audio(Doc* doc)
   : Function(doc, Function::Audio)
   , m_doc(doc)
   , m_decoder(NULL)
+  , m_prefetcher(NULL)
   , m_audio_out(NULL)
+  , m_outputStartTime(0)
   , m_audioDevice(QString())
   , m_startTime(UINT_MAX)
   , m_color(96, 128, 83)
@@ -79,6 +82,7 @@ Audio::~Audio()
         m_audio_out->stop();
         delete m_audio_out;
     }
+    delete m_prefetcher;
     if (m_decoder != NULL)
         delete m_decoder;
 }
@@ -169,6 +173,8 @@ bool Audio::setSourceFileName(QString filename)
         // unload previous source
         if (m_decoder != NULL)
         {
+            // a preloaded output still uses the decoder
+            releaseOutput();
             delete m_decoder;
             m_decoder = NULL;
         }
@@ -194,6 +200,9 @@ bool Audio::setSourceFileName(QString filename)
         return false;
 
     m_audioDuration = m_decoder->totalTime();
+    // the prefetcher worker may find a more accurate duration when seeking
+    connect(m_decoder, SIGNAL(totalTimeChanged(qint64)),
+            this, SLOT(slotTotalTimeChanged(qint64)));
     emit changed(id());
 
     return true;
@@ -230,15 +239,19 @@ void Audio::slotEndOfStream()
 {
     if (m_audio_out != NULL)
     {
-        m_audio_out->stop();
-        m_audio_out->deleteLater();
-        m_audio_out = NULL;
+        releaseOutput();
         m_decoder->seek(0);
     }
     if (!stopped())
         stop(FunctionParent::master());
 }
 
+void Audio::slotTotalTimeChanged(qint64 time)
+{
+    m_audioDuration = time;
+    emit changed(id());
+}
+
 void Audio::slotFunctionRemoved(quint32 fid)
 {
     Q_UNUSED(fid)
@@ -334,31 +347,79 @@ void Audio::preRun(MasterTimer* timer)
 {
     if (m_decoder != NULL)
     {
-        m_decoder->seek(elapsed());
-        AudioParameters ap = m_decoder->audioParameters();
+        // use the output prepared by preload(), unless it's for another position
+        if (m_audio_out == NULL || m_outputStartTime != elapsed())
+        {
+            releaseOutput();
+            createOutput(elapsed());
+        }
+
+        m_audio_out->adjustIntensity(getAttributeValue(Intensity));
+        m_audio_out->setFadeIn(fadeInSpeed());
+        m_audio_out->start();
+        connect(m_audio_out, SIGNAL(endOfStreamReached()),
+                this, SLOT(slotEndOfStream()));
+    }
+
+    Function::preRun(timer);
+}
+
+void Audio::preload(quint32 startTime)
+{
+    if (m_decoder == NULL || isRunning())
+        return;
+
+    if (m_audio_out != NULL && m_outputStartTime == startTime)
+        return;
+
+    qDebug() << Q_FUNC_INFO << "Preloading" << name() << "at" << startTime;
+
+    releaseOutput();
+    createOutput(startTime);
+}
+
+void Audio::cancelPreload()
+{
+    if (isRunning() == false)
+        releaseOutput();
+}
+
+void Audio::createOutput(quint32 startTime)
+{
+    // decode ahead on a worker, so the renderer starts as soon as
+    // the first chunk at the starting position is ready
+    m_prefetcher = new AudioPrefetcher(m_decoder);
+    m_prefetcher->seek(startTime);
+    AudioParameters ap = m_prefetcher->audioParameters();
 #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
  #if defined(__APPLE__) || defined(Q_OS_MAC)
-        //m_audio_out = new AudioRendererCoreAudio();
-        m_audio_out = new AudioRendererPortAudio(m_audioDevice);
+    //m_audio_out = new AudioRendererCoreAudio();
+    m_audio_out = new AudioRendererPortAudio(m_audioDevice);
  #elif defined(WIN32) || defined(Q_OS_WIN)
-        m_audio_out = new AudioRendererWaveOut(m_audioDevice);
+    m_audio_out = new AudioRendererWaveOut(m_audioDevice);
  #else
-        m_audio_out = new AudioRendererAlsa(m_audioDevice);
+    m_audio_out = new AudioRendererAlsa(m_audioDevice);
  #endif
-        m_audio_out->moveToThread(QCoreApplication::instance()->thread());
+    m_audio_out->moveToThread(QCoreApplication::instance()->thread());
 #else
-        m_audio_out = new AudioRendererQt(m_audioDevice);
+    m_audio_out = new AudioRendererQt(m_audioDevice);
 #endif
-        m_audio_out->setDecoder(m_decoder);
-        m_audio_out->initialize(ap.sampleRate(), ap.channels(), ap.format());
-        m_audio_out->adjustIntensity(getAttributeValue(Intensity));
-        m_audio_out->setFadeIn(fadeInSpeed());
-        m_audio_out->start();
-        connect(m_audio_out, SIGNAL(endOfStreamReached()),
-                this, SLOT(slotEndOfStream()));
+    m_audio_out->setDecoder(m_prefetcher);
+    m_audio_out->initialize(ap.sampleRate(), ap.channels(), ap.format());
+    m_outputStartTime = startTime;
+}
+
+void Audio::releaseOutput()
+{
+    if (m_audio_out != NULL)
+    {
+        m_audio_out->stop();
+        m_audio_out->deleteLater();
+        m_audio_out = NULL;
     }
 
-    Function::preRun(timer);
+    delete m_prefetcher;
+    m_prefetcher = NULL;
 }
 
 void Audio::setPause(bool enable)
@@ -27,6 +27,7 @@
 #include "function.h"
 
 class QXmlStreamReader;
+class AudioPrefetcher;
 
 /** @addtogroup engine_functions Functions
  * @{
@@ -144,11 +145,14 @@ signals:
 
 protected slots:
     void slotEndOfStream();
+    void slotTotalTimeChanged(qint64 time);
 
 private:
     /** Instance of an AudioDecoder to perform actual audio decoding */
     AudioDecoder *m_decoder;
-    /** output interface to render audio data got from m_decoder */
+    /** Decodes m_decoder ahead of m_audio_out while the Audio is running */
+    AudioPrefetcher *m_prefetcher;
+    /** output interface to render audio data got from m_prefetcher */
     AudioRenderer *m_audio_out;
     /** Audio device to use for rendering */
     QString m_audioDevice;
@@ -191,6 +195,23 @@ public:
 
     /** @reimpl */
     void postRun(MasterTimer* timer, QList<Universe *> universes);
+
+    /** @reimpl */
+    void preload(quint32 startTime);
+
+    /** @reimpl */
+    void cancelPreload();
+
+private:
+    /** Create the prefetcher and the renderer, ready to play from $startTime */
+    void createOutput(quint32 startTime);
+
+    /** Stop and destroy the prefetcher and the renderer, if any */
+    void releaseOutput();
+
+private:
+    /** The position in milliseconds m_audio_out has been created for */
+    quint32 m_outputStartTime;
 };
 
 /** @} */
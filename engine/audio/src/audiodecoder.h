@@ -83,6 +83,13 @@ public:
      */
     AudioParameters audioParameters() const;
 
+signals:
+    /*!
+     * Emitted when the total time has been computed again, more accurately.
+     * This can happen in seek(), hence in the thread of the caller.
+     */
+    void totalTimeChanged(qint64 time);
+
 protected:
     /*!
      * Use this function inside initialize() reimplementation to tell other plugins about audio parameters.
@@ -0,0 +1,243 @@
+/*
+  Q Light Controller Plus
+  audioprefetcher.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QMutexLocker>
+#include <QThread>
+#include <QDebug>
+
+#include <string.h>
+
+#include "audioprefetcher.h"
+
+/** Bytes requested to the source decoder at once. Must fit a whole MP3 frame */
+#define PREFETCH_CHUNK_SIZE     (8 * 1024)
+
+/** Size of the ring buffer. About 1.5 seconds of 44.1kHz 16 bit stereo audio */
+#define PREFETCH_BUFFER_SIZE    (32 * PREFETCH_CHUNK_SIZE)
+
+class AudioPrefetcher::Worker : public QThread
+{
+public:
+    Worker(AudioPrefetcher* prefetcher)
+        : m_prefetcher(prefetcher)
+    {
+    }
+
+protected:
+    void run()
+    {
+        m_prefetcher->decodeLoop();
+    }
+
+private:
+    AudioPrefetcher* m_prefetcher;
+};
+
+AudioPrefetcher::AudioPrefetcher(AudioDecoder *source)
+    : AudioDecoder()
+    , m_worker(NULL)
+    , m_source(source)
+    , m_totalTime(0)
+    , m_bitrate(0)
+    , m_readPos(0)
+    , m_used(0)
+    , m_eof(false)
+    , m_exit(false)
+    , m_seekPending(false)
+    , m_seekTime(0)
+    , m_seeking(false)
+{
+    Q_ASSERT(source != NULL);
+
+    AudioParameters ap = source->audioParameters();
+    configure(ap.sampleRate(), ap.channels(), ap.format());
+    m_totalTime = source->totalTime();
+    m_bitrate = source->bitrate();
+
+    m_ring.resize(PREFETCH_BUFFER_SIZE);
+
+    // the source emits it from the worker, while it seeks
+    connect(source, SIGNAL(totalTimeChanged(qint64)),
+            this, SLOT(slotSourceTotalTimeChanged(qint64)), Qt::DirectConnection);
+
+    m_worker = new Worker(this);
+    m_worker->start(QThread::HighPriority);
+}
+
+AudioPrefetcher::~AudioPrefetcher()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_exit = true;
+        m_spaceReady.wakeAll();
+        m_dataReady.wakeAll();
+    }
+
+    m_worker->wait();
+    delete m_worker;
+}
+
+AudioDecoder *AudioPrefetcher::source() const
+{
+    return m_source;
+}
+
+AudioDecoder *AudioPrefetcher::createCopy()
+{
+    return m_source->createCopy();
+}
+
+QStringList AudioPrefetcher::supportedFormats()
+{
+    return m_source->supportedFormats();
+}
+
+bool AudioPrefetcher::initialize(const QString &path)
+{
+    Q_UNUSED(path)
+
+    // the source is initialized by its owner
+    return true;
+}
+
+qint64 AudioPrefetcher::totalTime()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_totalTime;
+}
+
+void AudioPrefetcher::slotSourceTotalTimeChanged(qint64 time)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_totalTime = time;
+    }
+    emit totalTimeChanged(time);
+}
+
+int AudioPrefetcher::bitrate()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_bitrate;
+}
+
+void AudioPrefetcher::seek(qint64 time)
+{
+    QMutexLocker locker(&m_mutex);
+
+    // whatever has been decoded so far is not needed anymore
+    m_readPos = 0;
+    m_used = 0;
+    m_eof = false;
+
+    m_seekPending = true;
+    m_seekTime = time;
+    m_seeking = true;
+    m_spaceReady.wakeAll();
+}
+
+qint64 AudioPrefetcher::read(char *data, qint64 maxSize)
+{
+    QMutexLocker locker(&m_mutex);
+
+    while (m_exit == false && (m_seeking == true || (m_used == 0 && m_eof == false)))
+        m_dataReady.wait(&m_mutex);
+
+    int size = int(qMin(maxSize, qint64(m_used)));
+    if (size <= 0)
+        return 0;
+
+    // copy up to the end of the ring, then from its beginning
+    int first = qMin(size, m_ring.size() - m_readPos);
+    memcpy(data, m_ring.constData() + m_readPos, first);
+    if (size > first)
+        memcpy(data + first, m_ring.constData(), size - first);
+
+    m_readPos = (m_readPos + size) % m_ring.size();
+    m_used -= size;
+    m_spaceReady.wakeAll();
+
+    return size;
+}
+
+/****************************************************************************
+ * Worker
+ ****************************************************************************/
+
+void AudioPrefetcher::writeRing(const char *data, int size)
+{
+    int writePos = (m_readPos + m_used) % m_ring.size();
+    int first = qMin(size, m_ring.size() - writePos);
+
+    memcpy(m_ring.data() + writePos, data, first);
+    if (size > first)
+        memcpy(m_ring.data(), data + first, size - first);
+
+    m_used += size;
+}
+
+void AudioPrefetcher::decodeLoop()
+{
+    QByteArray chunk(PREFETCH_CHUNK_SIZE, 0);
+    QMutexLocker locker(&m_mutex);
+
+    while (m_exit == false)
+    {
+        if (m_seekPending == true)
+        {
+            qint64 time = m_seekTime;
+            m_seekPending = false;
+
+            locker.unlock();
+            m_source->seek(time);
+            locker.relock();
+
+            // a newer request arrived meanwhile
+            if (m_seekPending == true)
+                continue;
+
+            m_seeking = false;
+            m_dataReady.wakeAll();
+        }
+
+        if (m_eof == true || m_ring.size() - m_used < PREFETCH_CHUNK_SIZE)
+        {
+            m_spaceReady.wait(&m_mutex);
+            continue;
+        }
+
+        locker.unlock();
+        qint64 size = m_source->read(chunk.data(), PREFETCH_CHUNK_SIZE);
+        int bitrate = m_source->bitrate();
+        locker.relock();
+
+        // decoded at a position that is not wanted anymore
+        if (m_seekPending == true)
+            continue;
+
+        m_bitrate = bitrate;
+
+        if (size <= 0)
+            m_eof = true;
+        else
+            writeRing(chunk.constData(), int(size));
+
+        m_dataReady.wakeAll();
+    }
+}
@@ -0,0 +1,124 @@
+/*
+  Q Light Controller Plus
+  audioprefetcher.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef AUDIOPREFETCHER_H
+#define AUDIOPREFETCHER_H
+
+#include <QWaitCondition>
+#include <QByteArray>
+#include <QMutex>
+
+#include "audiodecoder.h"
+
+/** @addtogroup engine_audio Audio
+ * @{
+ */
+
+/**
+ * AudioPrefetcher decodes the audio of another decoder ahead of playback,
+ * on a worker thread, into a ring buffer. AudioRenderer reads from it like
+ * from any other decoder, so a slow disk or an expensive frame never
+ * starves the audio output.
+ *
+ * Seeking is handed over to the worker too: seek() returns immediately
+ * and the next read() waits only for the first chunk decoded at the
+ * new position.
+ *
+ * The source decoder must not be used by anyone else while the
+ * prefetcher exists.
+ */
+class AudioPrefetcher : public AudioDecoder
+{
+    Q_OBJECT
+
+public:
+    AudioPrefetcher(AudioDecoder* source);
+    ~AudioPrefetcher();
+
+    /** Return the decoder prefetched by this object */
+    AudioDecoder* source() const;
+
+    /** @reimpl */
+    AudioDecoder *createCopy();
+
+    /** @reimpl */
+    QStringList supportedFormats();
+
+    /** @reimpl */
+    bool initialize(const QString &path);
+
+    /** @reimpl */
+    qint64 totalTime();
+
+    /** @reimpl */
+    void seek(qint64 time);
+
+    /**
+     * @reimpl
+     * Waits until some data has been decoded, so 0 is returned only
+     * at the end of the stream.
+     */
+    qint64 read(char *data, qint64 maxSize);
+
+    /** @reimpl */
+    int bitrate();
+
+private slots:
+    /** Called by the worker when seeking has given the source a new total time */
+    void slotSourceTotalTimeChanged(qint64 time);
+
+private:
+    /** Decode ahead until the object is destroyed. Run by the worker. */
+    void decodeLoop();
+
+    /** Append $size bytes to the ring buffer. m_mutex must be locked. */
+    void writeRing(const char* data, int size);
+
+private:
+    class Worker;
+    Worker* m_worker;
+
+    AudioDecoder* m_source;
+    qint64 m_totalTime;
+    int m_bitrate;
+
+    QMutex m_mutex;
+    /** Signalled when data has been decoded, or at the end of the stream */
+    QWaitCondition m_dataReady;
+    /** Signalled when data has been read, or when there's a new request */
+    QWaitCondition m_spaceReady;
+
+    QByteArray m_ring;
+    int m_readPos;
+    int m_used;
+
+    bool m_eof;
+    bool m_exit;
+
+    /** A seek request waiting for the worker */
+    bool m_seekPending;
+    qint64 m_seekTime;
+
+    /** True while the worker is seeking or decoding at a stale position */
+    bool m_seeking;
+};
+
+/** @} */
+
+#endif
@@ -18,6 +18,7 @@ INCLUDEPATH += ../../src ../../../plugins/interfaces
 
 HEADERS += audio.h \
            audiodecoder.h \
+           audioprefetcher.h \
            audiorenderer.h \
            audioparameters.h \
            audiocapture.h \
@@ -33,6 +34,7 @@ else {
 
 SOURCES += audio.cpp \
            audiodecoder.cpp \
+           audioprefetcher.cpp \
            audiorenderer.cpp \
            audioparameters.cpp \
            audiocapture.cpp \
@@ -24,9 +24,11 @@
 #include <QXmlStreamWriter>
 #include <QDebug>
 
+#include <string.h>
+
 ChannelModifier::ChannelModifier()
 {
-    m_values.fill(0, 256);
+    memset(m_values, 0, sizeof(m_values));
     m_name = QString();
     m_type = UserTemplate;
 }
@@ -54,7 +56,7 @@ ChannelModifier::Type ChannelModifier::type() const
 void ChannelModifier::setModifierMap(QList<QPair<uchar, uchar> > map)
 {
     m_map = map;
-    m_values.fill(0, 256);
+    memset(m_values, 0, sizeof(m_values));
     QPair<uchar, uchar> lastDMXPair;
     for (int i = 0; i < m_map.count(); i++)
     {
@@ -83,8 +85,8 @@ void ChannelModifier::setModifierMap(QList<QPair<uchar, uchar> > map)
 // Enable the following to display the template full range of value
 /*
     qDebug() << "Template:" << m_name;
-    for (int d = 0; d < m_values.count(); d++)
-        qDebug() << "Pos:" << d << "val:" << QString::number((uchar)m_values.at(d));
+    for (int d = 0; d < 256; d++)
+        qDebug() << "Pos:" << d << "val:" << QString::number(m_values[d]);
 */
 }
 
@@ -95,7 +97,7 @@ QList< QPair<uchar, uchar> > ChannelModifier::modifierMap() const
 
 uchar ChannelModifier::getValue(uchar dmxValue)
 {
-    return m_values.at(dmxValue);
+    return m_values[dmxValue];
 }
 
 QFile::FileError ChannelModifier::saveXML(const QString &fileName)
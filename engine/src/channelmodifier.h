@@ -75,7 +75,7 @@ private:
     QString m_name;
     Type m_type;
     QList< QPair<uchar, uchar> > m_map;
-    QByteArray m_values;
+    uchar m_values[256];
 };
 
 /** @} */
@@ -0,0 +1,268 @@
+/*
+  Q Light Controller Plus
+  channelvaluestore.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "channelvaluestore.h"
+
+ChannelValueStore::ChannelValueStore()
+{
+}
+
+ChannelValueStore::ChannelValueStore(const ChannelValueStore& other)
+    : m_entries(other.m_entries)
+{
+}
+
+ChannelValueStore::~ChannelValueStore()
+{
+}
+
+ChannelValueStore &ChannelValueStore::operator=(const ChannelValueStore& other)
+{
+    if (this != &other)
+        m_entries = other.m_entries;
+
+    return *this;
+}
+
+bool ChannelValueStore::operator==(const ChannelValueStore& other) const
+{
+    if (m_entries.count() != other.m_entries.count())
+        return false;
+
+    for (int i = 0; i < m_entries.count(); i++)
+    {
+        if (m_entries.at(i).key != other.m_entries.at(i).key ||
+            m_entries.at(i).value != other.m_entries.at(i).value)
+                return false;
+    }
+
+    return true;
+}
+
+bool ChannelValueStore::operator!=(const ChannelValueStore& other) const
+{
+    return !(*this == other);
+}
+
+/****************************************************************************
+ * Access
+ ****************************************************************************/
+
+int ChannelValueStore::count() const
+{
+    return m_entries.count();
+}
+
+bool ChannelValueStore::isEmpty() const
+{
+    return m_entries.isEmpty();
+}
+
+void ChannelValueStore::reserve(int size)
+{
+    m_entries.reserve(size);
+}
+
+void ChannelValueStore::clear()
+{
+    m_entries.clear();
+}
+
+void ChannelValueStore::insert(quint64 key, uchar value)
+{
+    int idx = lowerBound(key);
+
+    if (idx < m_entries.count() && m_entries.at(idx).key == key)
+    {
+        // avoid detaching shared data when nothing changes
+        if (m_entries.at(idx).value != value)
+            m_entries[idx].value = value;
+        return;
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.value = value;
+
+    // values are usually loaded in ascending order, so appending is the common case
+    if (idx == m_entries.count())
+        m_entries.append(entry);
+    else
+        m_entries.insert(idx, entry);
+}
+
+bool ChannelValueStore::remove(quint64 key)
+{
+    int idx = lowerBound(key);
+
+    if (idx < m_entries.count() && m_entries.at(idx).key == key)
+    {
+        m_entries.remove(idx);
+        return true;
+    }
+
+    return false;
+}
+
+bool ChannelValueStore::contains(quint64 key) const
+{
+    int idx = lowerBound(key);
+
+    return idx < m_entries.count() && m_entries.at(idx).key == key;
+}
+
+uchar ChannelValueStore::value(quint64 key, uchar defaultValue) const
+{
+    int idx = lowerBound(key);
+
+    if (idx < m_entries.count() && m_entries.at(idx).key == key)
+        return m_entries.at(idx).value;
+
+    return defaultValue;
+}
+
+const ChannelValueStore::Entry &ChannelValueStore::at(int index) const
+{
+    return m_entries.at(index);
+}
+
+ChannelValueStore::const_iterator ChannelValueStore::begin() const
+{
+    return m_entries.constBegin();
+}
+
+ChannelValueStore::const_iterator ChannelValueStore::end() const
+{
+    return m_entries.constEnd();
+}
+
+int ChannelValueStore::lowerBound(quint64 key) const
+{
+    int first = 0;
+    int count = m_entries.count();
+
+    while (count > 0)
+    {
+        int step = count / 2;
+        int middle = first + step;
+
+        if (m_entries.at(middle).key < key)
+        {
+            first = middle + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
+/****************************************************************************
+ * Scene values helpers
+ ****************************************************************************/
+
+quint64 ChannelValueStore::sceneKey(quint32 fxi, quint32 channel)
+{
+    return (quint64(fxi) << 32) | quint64(channel);
+}
+
+quint32 ChannelValueStore::sceneKeyFixture(quint64 key)
+{
+    return quint32(key >> 32);
+}
+
+quint32 ChannelValueStore::sceneKeyChannel(quint64 key)
+{
+    return quint32(key & 0xFFFFFFFF);
+}
+
+void ChannelValueStore::insert(const SceneValue& scv)
+{
+    insert(sceneKey(scv.fxi, scv.channel), scv.value);
+}
+
+int ChannelValueStore::removeFixture(quint32 fxi)
+{
+    // values of the same fixture are contiguous
+    int first = lowerBound(sceneKey(fxi, 0));
+    int last = first;
+
+    while (last < m_entries.count() && sceneKeyFixture(m_entries.at(last).key) == fxi)
+        last++;
+
+    if (last > first)
+        m_entries.remove(first, last - first);
+
+    return last - first;
+}
+
+QList<SceneValue> ChannelValueStore::toSceneValues() const
+{
+    QList<SceneValue> list;
+    list.reserve(m_entries.count());
+
+    foreach (const Entry& entry, m_entries)
+        list.append(SceneValue(sceneKeyFixture(entry.key), sceneKeyChannel(entry.key), entry.value));
+
+    return list;
+}
+
+ChannelValueStore ChannelValueStore::fromSceneValues(const QList<SceneValue>& values)
+{
+    ChannelValueStore store;
+    store.reserve(values.count());
+
+    foreach (const SceneValue& scv, values)
+        store.insert(scv);
+
+    return store;
+}
+
+/****************************************************************************
+ * Cue values helpers
+ ****************************************************************************/
+
+QHash<uint, uchar> ChannelValueStore::toHash() const
+{
+    QHash<uint, uchar> hash;
+    hash.reserve(m_entries.count());
+
+    foreach (const Entry& entry, m_entries)
+        hash.insert(uint(entry.key), entry.value);
+
+    return hash;
+}
+
+ChannelValueStore ChannelValueStore::fromHash(const QHash<uint, uchar>& values)
+{
+    ChannelValueStore store;
+    store.reserve(values.count());
+
+    QHashIterator <uint,uchar> it(values);
+    while (it.hasNext() == true)
+    {
+        it.next();
+        store.insert(it.key(), it.value());
+    }
+
+    return store;
+}
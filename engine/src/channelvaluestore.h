@@ -0,0 +1,155 @@
+/*
+  Q Light Controller Plus
+  channelvaluestore.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef CHANNELVALUESTORE_H
+#define CHANNELVALUESTORE_H
+
+#include <QVector>
+#include <QList>
+#include <QHash>
+
+#include "scenevalue.h"
+
+/** @addtogroup engine Engine
+ * @{
+ */
+
+/** A single stored value. Kept POD so that QVector can move it with memmove */
+struct ChannelValueStoreEntry
+{
+    quint64 key;
+    uchar value;
+};
+
+Q_DECLARE_TYPEINFO(ChannelValueStoreEntry, Q_PRIMITIVE_TYPE);
+
+/**
+ * ChannelValueStore is a compact container of channel values, kept as
+ * a flat array sorted by a 64 bit key. It replaces node based containers
+ * (QMap/QHash) where many values are stored and copied around, like
+ * Scene and Cue values.
+ *
+ * The storage is implicitly shared, so copying a store (e.g. duplicating
+ * a Scene, copying a Cue or taking a snapshot under a mutex) costs just a
+ * reference count increment. Data is detached only when a copy is modified.
+ *
+ * Scene values are stored with the key returned by sceneKey(), which keeps
+ * the same ordering of SceneValue::operator<. Cue values simply use the
+ * absolute DMX channel as key.
+ */
+class ChannelValueStore
+{
+public:
+    typedef ChannelValueStoreEntry Entry;
+
+    typedef QVector<Entry>::const_iterator const_iterator;
+
+    ChannelValueStore();
+    ChannelValueStore(const ChannelValueStore& other);
+    ~ChannelValueStore();
+
+    ChannelValueStore& operator=(const ChannelValueStore& other);
+    bool operator==(const ChannelValueStore& other) const;
+    bool operator!=(const ChannelValueStore& other) const;
+
+    /************************************************************************
+     * Access
+     ************************************************************************/
+public:
+    /** Return the number of stored values */
+    int count() const;
+
+    /** Return true if the store has no values */
+    bool isEmpty() const;
+
+    /** Reserve room for $size values to avoid reallocations */
+    void reserve(int size);
+
+    /** Remove all the values */
+    void clear();
+
+    /**
+     * Set the value for the given key. If the key is not
+     * present it is inserted at its sorted position.
+     */
+    void insert(quint64 key, uchar value);
+
+    /**
+     * Remove the value with the given key.
+     *
+     * @return true if the key was found and removed, otherwise false
+     */
+    bool remove(quint64 key);
+
+    /** Return true if the given key is present */
+    bool contains(quint64 key) const;
+
+    /** Return the value of the given key or $defaultValue if not present */
+    uchar value(quint64 key, uchar defaultValue = 0) const;
+
+    /** Return the entry at the given index. No bounds check performed. */
+    const Entry& at(int index) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    /** Return the index of the first entry with key >= $key */
+    int lowerBound(quint64 key) const;
+
+private:
+    QVector<Entry> m_entries;
+
+    /************************************************************************
+     * Scene values helpers
+     ************************************************************************/
+public:
+    /** Pack a fixture ID and channel into a sortable key */
+    static quint64 sceneKey(quint32 fxi, quint32 channel);
+
+    /** Unpack the fixture ID and channel of a key generated with sceneKey() */
+    static quint32 sceneKeyFixture(quint64 key);
+    static quint32 sceneKeyChannel(quint64 key);
+
+    /** Set the value of a SceneValue, keyed by its fixture ID and channel */
+    void insert(const SceneValue& scv);
+
+    /** Remove all the values belonging to the given fixture ID */
+    int removeFixture(quint32 fxi);
+
+    /** Return the stored values as a list of SceneValue, sorted */
+    QList<SceneValue> toSceneValues() const;
+
+    /** Build a store from a list of SceneValue */
+    static ChannelValueStore fromSceneValues(const QList<SceneValue>& values);
+
+    /************************************************************************
+     * Cue values helpers
+     ************************************************************************/
+public:
+    /** Return the stored values as a channel/value hash */
+    QHash<uint, uchar> toHash() const;
+
+    /** Build a store from a channel/value hash */
+    static ChannelValueStore fromHash(const QHash<uint, uchar>& values);
+};
+
+/** @} */
+
+#endif
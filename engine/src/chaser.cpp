@@ -168,7 +168,7 @@ bool Chaser::removeStep(int index)
     if (index >= 0 && index < m_steps.size())
     {
         m_stepListMutex.lock();
-        m_steps.removeAt(index);
+        m_steps.remove(index);
         m_stepListMutex.unlock();
 
         emit changed(this->id());
@@ -205,8 +205,8 @@ bool Chaser::moveStep(int sourceIdx, int destIdx)
         return false;
 
     m_stepListMutex.lock();
-    ChaserStep cs = m_steps[sourceIdx];
-    m_steps.removeAt(sourceIdx);
+    ChaserStep cs = m_steps.at(sourceIdx);
+    m_steps.remove(sourceIdx);
     m_steps.insert(destIdx, cs);
     m_stepListMutex.unlock();
 
@@ -221,19 +221,19 @@ void Chaser::clear()
     emit changed(this->id());
 }
 
-int Chaser::stepsCount()
+int Chaser::stepsCount() const
 {
     return m_steps.count();
 }
 
-ChaserStep Chaser::stepAt(int idx)
+ChaserStep Chaser::stepAt(int idx) const
 {
     if (idx >= 0 && idx < m_steps.count())
         return m_steps.at(idx);
     return ChaserStep();
 }
 
-QList <ChaserStep> Chaser::steps() const
+const QVector <ChaserStep>& Chaser::steps() const
 {
     return m_steps;
 }
@@ -274,7 +274,7 @@ quint32 Chaser::totalDuration()
         totalDuration = duration() * m_steps.count();
     else
     {
-        foreach (ChaserStep step, m_steps)
+        foreach (const ChaserStep &step, m_steps)
             totalDuration += step.duration;
     }
 
@@ -284,7 +284,15 @@ quint32 Chaser::totalDuration()
 void Chaser::slotFunctionRemoved(quint32 fid)
 {
     m_stepListMutex.lock();
-    int count = m_steps.removeAll(ChaserStep(fid));
+    int count = 0;
+    for (int i = m_steps.count() - 1; i >= 0; i--)
+    {
+        if (m_steps.at(i).fid == fid)
+        {
+            m_steps.remove(i);
+            count++;
+        }
+    }
     m_stepListMutex.unlock();
 
     if (count > 0)
@@ -436,13 +444,8 @@ bool Chaser::saveXML(QXmlStreamWriter *doc)
     }
 
     /* Steps */
-    int stepNumber = 0;
-    QListIterator <ChaserStep> it(m_steps);
-    while (it.hasNext() == true)
-    {
-        ChaserStep step(it.next());
-        step.saveXML(doc, stepNumber++, m_isSequence);
-    }
+    for (int i = 0; i < m_steps.count(); i++)
+        m_steps.at(i).saveXML(doc, i, m_isSequence);
 
     /* End the <Function> tag */
     doc->writeEndElement();
@@ -549,11 +552,10 @@ void Chaser::postLoad()
     Doc* doc = this->doc();
     Q_ASSERT(doc != NULL);
 
-    QMutableListIterator <ChaserStep> it(m_steps);
+    QMutableVectorIterator <ChaserStep> it(m_steps);
     while (it.hasNext() == true)
     {
-        ChaserStep step(it.next());
-        Function* function = doc->function(step.fid);
+        Function* function = doc->function(it.next().fid);
 
         if (function == NULL)
             it.remove();
@@ -680,7 +682,7 @@ bool Chaser::contains(quint32 functionId)
     Doc* doc = this->doc();
     Q_ASSERT(doc != NULL);
 
-    foreach(ChaserStep step, m_steps)
+    foreach(const ChaserStep &step, m_steps)
     {
         Function* function = doc->function(step.fid);
         // contains() can be called during init, function may be NULL
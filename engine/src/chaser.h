@@ -21,13 +21,15 @@
 #ifndef CHASER_H
 #define CHASER_H
 
+#include <QVector>
 #include <QMutex>
 #include <QColor>
 #include <QList>
 
+#include "chaserrunner.h"
+#include "chaserstep.h"
 #include "function.h"
 #include "scene.h"
-#include "chaserrunner.h"
 
 class QFile;
 class QString;
@@ -129,21 +131,24 @@ public:
     void clear();
 
     /** Get the Chaser steps number */
-    int stepsCount();
+    int stepsCount() const;
 
     /**
      * Get a chaser step from a given index
      *
      * @return The requested Chaser Step
      */
-    ChaserStep stepAt(int idx);
+    ChaserStep stepAt(int idx) const;
 
     /**
-     * Get the chaser's list of steps
+     * Get a read-only view of the chaser's steps. Steps are stored
+     * contiguously and notes and values are shared, so iterating over
+     * the view doesn't copy anything. The view is valid until the
+     * steps are modified.
      *
-     * @return List of function Chaser Steps
+     * @return The Chaser Steps
      */
-    QList <ChaserStep> steps() const;
+    const QVector <ChaserStep>& steps() const;
 
     /** @reimpl */
     void setTotalDuration(quint32 msec);
@@ -163,7 +168,7 @@ public slots:
     void slotFunctionRemoved(quint32 fid);
 
 private:
-    QList <ChaserStep> m_steps;
+    QVector <ChaserStep> m_steps;
     QMutex m_stepListMutex;
 
     /*********************************************************************
@@ -46,6 +46,7 @@ ChaserRunner::ChaserRunner(const Doc* doc, const Chaser* chaser, quint32 startTi
     , m_roundTime(new QTime)
     , m_order()
     , m_intensity(1.0)
+    , m_preloadFunction(NULL)
 {
     Q_ASSERT(chaser != NULL);
 
@@ -54,7 +55,7 @@ ChaserRunner::ChaserRunner(const Doc* doc, const Chaser* chaser, quint32 startTi
         qDebug() << "[ChaserRunner] startTime:" << startTime;
         int idx = 0;
         quint32 stepsTime = 0;
-        foreach(ChaserStep step, chaser->steps())
+        foreach(const ChaserStep &step, chaser->steps())
         {
             if (startTime < stepsTime + step.duration)
             {
@@ -77,6 +78,7 @@ ChaserRunner::ChaserRunner(const Doc* doc, const Chaser* chaser, quint32 startTi
 ChaserRunner::~ChaserRunner()
 {
     clearRunningList();
+    cancelPreload();
     delete m_roundTime;
 }
 
@@ -470,6 +472,7 @@ void ChaserRunner::startNewStep(int index, MasterTimer* timer, bool manualFade,
     if (index < 0 || index >= m_chaser->steps().count())
         index = 0; // fallback to the first step
 
+    // a copy, since the chaser can be edited meanwhile
     ChaserStep step(m_chaser->steps().at(index));
     Function *func = m_doc->function(step.fid);
     if (func != NULL)
@@ -500,6 +503,12 @@ void ChaserRunner::startNewStep(int index, MasterTimer* timer, bool manualFade,
                 s->setValue(step.values.at(i), true);
         }
 
+        // the step might not be the one that has been preloaded
+        if (m_preloadFunction == func)
+            m_preloadFunction = NULL;
+        else
+            cancelPreload();
+
         // Set intensity before starting the function. Otherwise the intensity
         // might momentarily jump too high.
         newStep->m_function->adjustAttribute(m_intensity, Function::Intensity);
@@ -510,6 +519,33 @@ void ChaserRunner::startNewStep(int index, MasterTimer* timer, bool manualFade,
     }
 }
 
+void ChaserRunner::preloadNextStep(ChaserRunnerStep *step)
+{
+    if (m_preloadFunction != NULL || step->m_duration == Function::infiniteSpeed() ||
+        step->m_elapsed + MasterTimer::mediaPreroll() < step->m_duration)
+            return;
+
+    int nextStep = computeNextStep(m_lastRunStepIdx);
+    if (nextStep < 0 || nextStep >= m_chaser->steps().count())
+        return;
+
+    Function *func = m_doc->function(m_chaser->steps().at(nextStep).fid);
+    if (func == NULL || func == step->m_function)
+        return;
+
+    func->preload(0);
+    m_preloadFunction = func;
+}
+
+void ChaserRunner::cancelPreload()
+{
+    if (m_preloadFunction != NULL)
+    {
+        m_preloadFunction->cancelPreload();
+        m_preloadFunction = NULL;
+    }
+}
+
 int ChaserRunner::getNextStepIndex()
 {
     int currentStepIndex = m_lastRunStepIdx;
@@ -694,6 +730,10 @@ bool ChaserRunner::write(MasterTimer* timer, QList<Universe *> universes)
         }
     }
 
+    // get the media of the next step ready, unless a step change is pending
+    if (m_runnerSteps.count() == 1 && m_next == false && m_previous == false)
+        preloadNextStep(m_runnerSteps.first());
+
     if (m_runnerSteps.isEmpty())
     {
         m_lastRunStepIdx = getNextStepIndex();
@@ -718,4 +758,5 @@ void ChaserRunner::postRun(MasterTimer* timer, QList<Universe*> universes)
 
     qDebug() << Q_FUNC_INFO;
     clearRunningList();
+    cancelPreload();
 }
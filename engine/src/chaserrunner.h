@@ -200,9 +200,21 @@ private:
 
     int getNextStepIndex();
 
+    /**
+     * Preload the Function of the step following $step, once $step
+     * is within MasterTimer::mediaPreroll() of its end.
+     */
+    void preloadNextStep(ChaserRunnerStep *step);
+
+    /** Release the preloaded Function, unless it has been started */
+    void cancelPreload();
+
 private:
     FunctionParent functionParent() const;
 
+    /** The Function preloaded for the next step, or NULL */
+    Function *m_preloadFunction;
+
 public:
     /**
      * Call this from the parent function's write() method to run the steps.
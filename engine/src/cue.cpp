@@ -34,7 +34,7 @@ Cue::Cue(const QString& name)
 
 Cue::Cue(const QHash <uint,uchar> values)
     : m_name(QString())
-    , m_values(values)
+    , m_values(ChannelValueStore::fromHash(values))
     , m_fadeInSpeed(0)
     , m_fadeOutSpeed(0)
     , m_duration(0)
@@ -43,7 +43,7 @@ Cue::Cue(const QHash <uint,uchar> values)
 
 Cue::Cue(const Cue& cue)
     : m_name(cue.name())
-    , m_values(cue.values())
+    , m_values(cue.valueStore())
     , m_fadeInSpeed(cue.fadeInSpeed())
     , m_fadeOutSpeed(cue.fadeOutSpeed())
     , m_duration(cue.duration())
@@ -74,24 +74,25 @@ QString Cue::name() const
 
 void Cue::setValue(uint channel, uchar value)
 {
-    m_values[channel] = value;
+    m_values.insert(channel, value);
 }
 
 void Cue::unsetValue(uint channel)
 {
-    if (m_values.contains(channel) == true)
-        m_values.remove(channel);
+    m_values.remove(channel);
 }
 
 uchar Cue::value(uint channel) const
 {
-    if (m_values.contains(channel) == true)
-        return m_values[channel];
-    else
-        return 0;
+    return m_values.value(channel, 0);
 }
 
 QHash <uint,uchar> Cue::values() const
+{
+    return m_values.toHash();
+}
+
+const ChannelValueStore &Cue::valueStore() const
 {
     return m_values;
 }
@@ -177,13 +178,12 @@ bool Cue::saveXML(QXmlStreamWriter *doc) const
     doc->writeStartElement(KXMLQLCCue);
     doc->writeAttribute(KXMLQLCCueName, name());
 
-    QHashIterator <uint,uchar> it(values());
-    while (it.hasNext() == true)
+    for (int i = 0; i < m_values.count(); i++)
     {
-        it.next();
+        const ChannelValueStore::Entry& entry = m_values.at(i);
         doc->writeStartElement(KXMLQLCCueValue);
-        doc->writeAttribute(KXMLQLCCueValueChannel, QString::number(it.key()));
-        doc->writeCharacters(QString::number(it.value()));
+        doc->writeAttribute(KXMLQLCCueValueChannel, QString::number(entry.key));
+        doc->writeCharacters(QString::number(entry.value));
         doc->writeEndElement();
     }
 
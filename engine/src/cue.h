@@ -24,7 +24,7 @@
 #include <QString>
 #include <QHash>
 
-#include "scenevalue.h"
+#include "channelvaluestore.h"
 
 class QXmlStreamReader;
 class QXmlStreamWriter;
@@ -71,8 +71,14 @@ public:
 
     QHash <uint,uchar> values() const;
 
+    /**
+     * Return the Cue values sorted by channel. The returned store
+     * is implicitly shared, so this doesn't deep copy the values.
+     */
+    const ChannelValueStore& valueStore() const;
+
 private:
-    QHash <uint,uchar> m_values;
+    ChannelValueStore m_values;
 
     /************************************************************************
      * Speed
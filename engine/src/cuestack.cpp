@@ -429,13 +429,12 @@ void CueStack::writeDMX(MasterTimer* timer, QList<Universe*> ua)
     Q_UNUSED(timer);
     if (isFlashing() == true && m_cues.size() > 0)
     {
-        QHashIterator <uint,uchar> it(m_cues.first().values());
-        while (it.hasNext() == true)
+        ChannelValueStore values = m_cues.first().valueStore();
+        for (int i = 0; i < values.count(); i++)
         {
-            it.next();
             FadeChannel fc;
-            fc.setChannel(doc(), it.key());
-            fc.setTarget(it.value());
+            fc.setChannel(doc(), uint(values.at(i).key));
+            fc.setTarget(values.at(i).value);
             int uni = qFloor(fc.channel() / 512);
             if (uni < ua.size())
                 ua[uni]->write(fc.channel() - (uni * 512), fc.target());
@@ -587,12 +586,10 @@ void CueStack::switchCue(int from, int to, const QList<Universe *> ua)
     m_mutex.unlock();
 
     // Fade out the HTP channels of the previous cue
-    QHashIterator <uint,uchar> oldit(oldCue.values());
-    while (oldit.hasNext() == true)
+    const ChannelValueStore& oldValues = oldCue.valueStore();
+    for (int i = 0; i < oldValues.count(); i++)
     {
-        oldit.next();
-
-        FadeChannel fc(doc(), Fixture::invalidId(), oldit.key());
+        FadeChannel fc(doc(), Fixture::invalidId(), uint(oldValues.at(i).key));
 
         if (fc.group(doc()) == QLCChannel::Intensity)
         {
@@ -606,12 +603,11 @@ void CueStack::switchCue(int from, int to, const QList<Universe *> ua)
     }
 
     // Fade in all channels of the new cue
-    QHashIterator <uint,uchar> newit(newCue.values());
-    while (newit.hasNext() == true)
+    const ChannelValueStore& newValues = newCue.valueStore();
+    for (int i = 0; i < newValues.count(); i++)
     {
-        newit.next();
-        FadeChannel fc(doc(), Fixture::invalidId(), newit.key());
-        fc.setTarget(newit.value());
+        FadeChannel fc(doc(), Fixture::invalidId(), uint(newValues.at(i).key));
+        fc.setTarget(newValues.at(i).value);
         fc.setElapsed(0);
         fc.setReady(false);
         fc.setFadeTime(newCue.fadeInSpeed());
@@ -33,6 +33,7 @@
 #include "monitorproperties.h"
 #include "audioplugincache.h"
 #include "rgbscriptscache.h"
+#include "functionloader.h"
 #include "channelsgroup.h"
 #include "collection.h"
 #include "function.h"
@@ -67,12 +68,12 @@ Doc::Doc(QObject* parent, int universes)
     , m_audioPluginCache(new AudioPluginCache(this))
     , m_ioMap(new InputOutputMap(this, universes))
     , m_masterTimer(new MasterTimer(this))
+    , m_stateJournal(new StateJournal(this, this))
     , m_monitorProps(NULL)
     , m_mode(Design)
     , m_kiosk(false)
     , m_loadStatus(Cleared)
     , m_clipboard(new QLCClipboard(this))
-    , m_fixturesListCacheUpToDate(false)
     , m_latestFixtureId(0)
     , m_latestFixtureGroupId(0)
     , m_latestChannelsGroupId(0)
@@ -113,6 +114,9 @@ void Doc::clearContents()
 {
     emit clearing();
 
+    m_stateJournal->stop();
+    m_stateJournal->setWorkspace(QString());
+
     m_clipboard->resetContents();
 
     if (m_monitorProps != NULL)
@@ -159,7 +163,9 @@ void Doc::clearContents()
         delete fxi;
         emit fixtureRemoved(fxID);
     }
-    m_fixturesListCacheUpToDate = false;
+
+    // Release the fixture definitions not used anymore
+    m_fixtureDefCache->releaseUnused();
 
     m_orderedGroups.clear();
 
@@ -247,6 +253,11 @@ MasterTimer* Doc::masterTimer() const
     return m_masterTimer;
 }
 
+StateJournal *Doc::stateJournal() const
+{
+    return m_stateJournal;
+}
+
 QSharedPointer<AudioCapture> Doc::audioInputCapture()
 {
     if (!m_inputCapture)
@@ -399,7 +410,6 @@ bool Doc::addFixture(Fixture* fixture, quint32 id)
 
     fixture->setID(id);
     m_fixtures.insert(id, fixture);
-    m_fixturesListCacheUpToDate = false;
 
     /* Patch fixture change signals thru Doc */
     connect(fixture, SIGNAL(changed(quint32)),
@@ -449,7 +459,6 @@ bool Doc::deleteFixture(quint32 id)
     {
         Fixture* fxi = m_fixtures.take(id);
         Q_ASSERT(fxi != NULL);
-        m_fixturesListCacheUpToDate = false;
 
         /* Keep track of fixture addresses */
         QMutableHashIterator <uint,uint> it(m_addresses);
@@ -486,7 +495,6 @@ bool Doc::replaceFixtures(QList<Fixture*> newFixturesList)
     {
         Fixture* fxi = m_fixtures.take(fxit.next());
         delete fxi;
-        m_fixturesListCacheUpToDate = false;
     }
     m_latestFixtureId = 0;
     m_addresses.clear();
@@ -519,7 +527,6 @@ bool Doc::replaceFixtures(QList<Fixture*> newFixturesList)
 
         newFixture->setExcludeFadeChannels(fixture->excludeFadeChannels());
         m_fixtures.insert(id, newFixture);
-        m_fixturesListCacheUpToDate = false;
 
         /* Patch fixture change signals thru Doc */
         connect(newFixture, SIGNAL(changed(quint32)),
@@ -540,7 +547,7 @@ bool Doc::updateFixtureChannelCapabilities(quint32 id, QList<int> forcedHTP, QLi
 {
     if (m_fixtures.contains(id) == true)
     {
-        Fixture* fixture = m_fixtures[id];
+        Fixture* fixture = m_fixtures.value(id);
         // get exclusive access to the universes list
         QList<Universe *> universes = inputOutputMap()->claimUniverses();
         int uni = fixture->universe();
@@ -594,25 +601,12 @@ bool Doc::updateFixtureChannelCapabilities(quint32 id, QList<int> forcedHTP, QLi
 
 QList<Fixture*> const& Doc::fixtures() const
 {
-    if (!m_fixturesListCacheUpToDate)
-    {
-        // Sort fixtures by id
-        QMap <quint32, Fixture*> fixturesMap;
-        QHashIterator <quint32, Fixture*> hashIt(m_fixtures);
-        while (hashIt.hasNext())
-        {
-            hashIt.next();
-            fixturesMap.insert(hashIt.key(), hashIt.value());
-        }
-        const_cast<QList<Fixture*>&>(m_fixturesListCache) = fixturesMap.values();
-        const_cast<bool&>(m_fixturesListCacheUpToDate) = true;
-    }
-    return m_fixturesListCache;
+    return m_fixtures.values();
 }
 
 Fixture* Doc::fixture(quint32 id) const
 {
-    return m_fixtures.value(id, NULL);
+    return m_fixtures.value(id);
 }
 
 quint32 Doc::fixtureForAddress(quint32 universeAddress) const
@@ -908,7 +902,7 @@ bool Doc::addFunction(Function* func, quint32 id)
                 func, SLOT(slotFixtureRemoved(quint32)));
 
         // Place the function in the map and assign it the new ID
-        m_functions[id] = func;
+        m_functions.insert(id, func);
         func->setID(id);
         emit functionAdded(id);
         setModified();
@@ -917,7 +911,7 @@ bool Doc::addFunction(Function* func, quint32 id)
     }
 }
 
-QList <Function*> Doc::functions() const
+QList <Function*> const& Doc::functions() const
 {
     return m_functions.values();
 }
@@ -925,7 +919,7 @@ QList <Function*> Doc::functions() const
 QList<Function *> Doc::functionsByType(Function::Type type) const
 {
     QList <Function*> list;
-    foreach(Function *f, m_functions)
+    foreach(Function *f, m_functions.values())
     {
         if (f != NULL && f->type() == type)
             list.append(f);
@@ -958,10 +952,7 @@ bool Doc::deleteFunction(quint32 id)
 
 Function* Doc::function(quint32 id) const
 {
-    if (m_functions.contains(id) == true)
-        return m_functions[id];
-    else
-        return NULL;
+    return m_functions.value(id);
 }
 
 quint32 Doc::nextFunctionID()
@@ -1099,9 +1090,22 @@ bool Doc::loadXML(QXmlStreamReader &doc)
             setStartupFunction(sID);
     }
 
+    /* Function contents are loaded concurrently, in batches of consecutive
+     * Function tags, so that the other tags still see them loaded */
+    FunctionLoader functionLoader(this);
+
     while (doc.readNextStartElement())
     {
         //qDebug() << "Doc tag:" << doc.name();
+        if (doc.name() == KXMLQLCFunction)
+        {
+            //qDebug() << doc.attributes().value("Name").toString();
+            functionLoader.append(doc);
+            continue;
+        }
+
+        functionLoader.flush();
+
         if (doc.name() == KXMLFixture)
         {
             Fixture::loader(doc, this);
@@ -1114,11 +1118,6 @@ bool Doc::loadXML(QXmlStreamReader &doc)
         {
             ChannelsGroup::loader(doc, this);
         }
-        else if (doc.name() == KXMLQLCFunction)
-        {
-            //qDebug() << doc.attributes().value("Name").toString();
-            Function::loader(doc, this);
-        }
         else if (doc.name() == KXMLQLCBus)
         {
             /* LEGACY */
@@ -1139,8 +1138,15 @@ bool Doc::loadXML(QXmlStreamReader &doc)
         }
     }
 
+    functionLoader.flush();
+
     postLoad();
 
+    /* Resume the state left by an unexpected shutdown, then record the
+       state of this workspace from now on */
+    m_stateJournal->restore();
+    m_stateJournal->start();
+
     m_loadStatus = Loaded;
     emit loaded();
 
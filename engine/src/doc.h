@@ -33,7 +33,9 @@
 #include "channelsgroup.h"
 #include "fixturegroup.h"
 #include "qlcclipboard.h"
+#include "statejournal.h"
 #include "mastertimer.h"
+#include "idslotmap.h"
 #include "function.h"
 #include "fixture.h"
 
@@ -139,6 +141,9 @@ public:
     /** Get the MasterTimer object that runs the show */
     MasterTimer* masterTimer() const;
 
+    /** Get the journal of the live state of the current workspace */
+    StateJournal* stateJournal() const;
+
     /** Get the audio input capture object */
     QSharedPointer<AudioCapture> audioInputCapture();
 
@@ -153,6 +158,7 @@ private:
     AudioPluginCache *m_audioPluginCache;
     InputOutputMap *m_ioMap;
     MasterTimer *m_masterTimer;
+    StateJournal *m_stateJournal;
     QSharedPointer<AudioCapture> m_inputCapture;
     MonitorProperties *m_monitorProps;
 
@@ -328,12 +334,8 @@ private slots:
     void slotFixtureChanged(quint32 fxi_id);
 
 protected:
-    /** Fixtures hash: < ID, Fixture instance > */
-    QHash <quint32, Fixture*> m_fixtures;
-
-    /** Fixtures list cache */
-    bool m_fixturesListCacheUpToDate;
-    QList<Fixture*> m_fixturesListCache;
+    /** Fixtures by ID */
+    IdSlotMap <Fixture> m_fixtures;
 
     /** Map of the addresses occupied by fixtures */
     QHash <quint32, quint32> m_addresses;
@@ -443,11 +445,11 @@ public:
     bool addFunction(Function* function, quint32 id = Function::invalidId());
 
     /**
-     * Get a list of currently available functions
+     * Get a list of currently available functions, sorted by ID
      *
      * @return List of functions
      */
-    QList <Function*> functions() const;
+    QList <Function*> const& functions() const;
 
     /**
      * Get a list of currently available functions by type
@@ -528,8 +530,8 @@ signals:
     void functionNameChanged(quint32 function);
 
 protected:
-    /** Functions */
-    QMap <quint32,Function*> m_functions;
+    /** Functions by ID */
+    IdSlotMap <Function> m_functions;
 
     /** Latest assigned function ID */
     quint32 m_latestFunctionId;
@@ -0,0 +1,174 @@
+/*
+  Q Light Controller Plus
+  efxpreview.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QMutexLocker>
+#include <QDataStream>
+#include <QDebug>
+
+#include "efxpreview.h"
+#include "efxfixture.h"
+#include "efx.h"
+
+/** Maximum number of cached polygons */
+#define PREVIEW_CACHE_COST  2048
+
+EFXPreview::EFXPreview(QObject *parent)
+    : QThread(parent)
+    , m_exit(false)
+    , m_pending(NULL)
+    , m_resultReady(false)
+    , m_cache(PREVIEW_CACHE_COST)
+{
+    start(QThread::LowPriority);
+}
+
+EFXPreview::~EFXPreview()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_exit = true;
+        m_condition.wakeAll();
+    }
+    wait();
+
+    delete m_pending;
+}
+
+bool EFXPreview::request(const EFX *efx, QPolygonF &polygon, QVector<QPolygonF> &fixtures)
+{
+    Q_ASSERT(efx != NULL);
+
+    QByteArray key = geometryKey(efx);
+
+    QMutexLocker locker(&m_mutex);
+
+    m_requestedKey = key;
+    m_resultReady = false;
+
+    Geometry* cached = m_cache.object(key);
+    if (cached != NULL)
+    {
+        polygon = cached->polygon;
+        fixtures = cached->fixtures;
+
+        // the worker is not needed anymore
+        delete m_pending;
+        m_pending = NULL;
+
+        return true;
+    }
+
+    // already being computed
+    if (m_busyKey == key || (m_pending != NULL && m_pendingKey == key))
+        return false;
+
+    /* The worker computes a copy, so that the EFX can be edited meanwhile.
+     * Copies not taken by the worker yet are deleted here.
+     * Copies are not parented to the Doc and receive no events, so the
+     * worker can delete them directly once computed */
+    EFX* copy = new EFX(efx->doc());
+    copy->copyFrom(efx);
+    for (int i = EFX::Height; i <= EFX::YOffset; i++)
+        copy->adjustAttribute(efx->getAttributeValue(i), i);
+    copy->setParent(NULL);
+
+    // latest request wins
+    delete m_pending;
+    m_pending = copy;
+    m_pendingKey = key;
+    m_condition.wakeAll();
+
+    return false;
+}
+
+bool EFXPreview::takeGeometry(QPolygonF &polygon, QVector<QPolygonF> &fixtures)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_resultReady == false)
+        return false;
+
+    polygon = m_result.polygon;
+    fixtures = m_result.fixtures;
+    m_resultReady = false;
+
+    return true;
+}
+
+QByteArray EFXPreview::geometryKey(const EFX *efx)
+{
+    QByteArray key;
+    QDataStream stream(&key, QIODevice::WriteOnly);
+
+    stream << int(efx->algorithm()) << int(efx->direction())
+           << efx->width() << efx->height() << efx->rotation()
+           << efx->xOffset() << efx->yOffset() << efx->startOffset()
+           << efx->xFrequency() << efx->yFrequency()
+           << efx->xPhase() << efx->yPhase();
+
+    for (int i = EFX::Height; i <= EFX::YOffset; i++)
+        stream << efx->getAttributeValue(i);
+
+    foreach (EFXFixture* ef, efx->fixtures())
+        stream << int(ef->direction()) << ef->startOffset();
+
+    return key;
+}
+
+/****************************************************************************
+ * Worker
+ ****************************************************************************/
+
+void EFXPreview::run()
+{
+    QMutexLocker locker(&m_mutex);
+
+    while (m_exit == false)
+    {
+        if (m_pending == NULL)
+        {
+            m_condition.wait(&m_mutex);
+            continue;
+        }
+
+        EFX* efx = m_pending;
+        QByteArray key = m_pendingKey;
+        m_pending = NULL;
+        m_busyKey = key;
+        locker.unlock();
+
+        Geometry* geometry = new Geometry;
+        efx->preview(geometry->polygon);
+        efx->previewFixtures(geometry->fixtures);
+
+        delete efx;
+
+        locker.relock();
+        m_busyKey.clear();
+
+        if (key == m_requestedKey)
+        {
+            m_result = *geometry;
+            m_resultReady = true;
+            emit geometryReady();
+        }
+
+        m_cache.insert(key, geometry, geometry->fixtures.count() + 1);
+    }
+}
@@ -0,0 +1,116 @@
+/*
+  Q Light Controller Plus
+  efxpreview.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef EFXPREVIEW_H
+#define EFXPREVIEW_H
+
+#include <QWaitCondition>
+#include <QByteArray>
+#include <QPolygonF>
+#include <QThread>
+#include <QVector>
+#include <QMutex>
+#include <QCache>
+
+class EFX;
+
+/** @addtogroup engine_functions Functions
+ * @{
+ */
+
+/**
+ * EFXPreview computes the preview paths of an EFX (see EFX::preview() and
+ * EFX::previewFixtures()) on a worker thread.
+ *
+ * Computed paths are cached by the EFX parameters they depend on, so going
+ * back to a previous setting doesn't compute them again. When parameters
+ * change faster than the paths can be computed (e.g. while dragging a
+ * knob), only the latest request is computed.
+ */
+class EFXPreview : public QThread
+{
+    Q_OBJECT
+
+public:
+    EFXPreview(QObject* parent = 0);
+    ~EFXPreview();
+
+    /**
+     * Request the preview paths of the given EFX, replacing any pending
+     * request. If the paths are cached, they are returned immediately,
+     * otherwise they are computed in background and geometryReady() is
+     * emitted when they can be taken with takeGeometry().
+     *
+     * @param efx The EFX to preview
+     * @param polygon The EFX path, filled if cached
+     * @param fixtures The path of each fixture, filled if cached
+     * @return true if the paths were cached, otherwise false
+     */
+    bool request(const EFX* efx, QPolygonF& polygon, QVector<QPolygonF>& fixtures);
+
+    /**
+     * Take the paths of the latest request, once computed.
+     *
+     * @return true if the paths were available, otherwise false
+     */
+    bool takeGeometry(QPolygonF& polygon, QVector<QPolygonF>& fixtures);
+
+    /** Return the key identifying the preview paths of $efx */
+    static QByteArray geometryKey(const EFX* efx);
+
+signals:
+    /** Emitted from the worker thread when the requested paths are ready */
+    void geometryReady();
+
+protected:
+    /** @reimp */
+    void run();
+
+private:
+    struct Geometry
+    {
+        QPolygonF polygon;
+        QVector<QPolygonF> fixtures;
+    };
+
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    bool m_exit;
+
+    /** An unparented copy of the EFX to compute, taken by request() */
+    EFX* m_pending;
+    QByteArray m_pendingKey;
+
+    /** The key of the paths being computed */
+    QByteArray m_busyKey;
+
+    /** The key of the latest request */
+    QByteArray m_requestedKey;
+
+    /** The computed paths of the latest request, waiting to be taken */
+    Geometry m_result;
+    bool m_resultReady;
+
+    /** Computed paths. The cost of an entry is its number of polygons */
+    QCache<QByteArray, Geometry> m_cache;
+};
+
+/** @} */
+
+#endif
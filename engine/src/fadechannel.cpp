@@ -37,6 +37,10 @@ FadeChannel::FadeChannel()
     , m_current(0)
     , m_ready(false)
     , m_flashing(false)
+    , m_lsbPairChannel(QLCChannel::invalid())
+    , m_msbPairChannel(QLCChannel::invalid())
+    , m_16bit(false)
+    , m_coupled(false)
     , m_fadeTime(0)
     , m_elapsed(0)
 {
@@ -53,6 +57,10 @@ FadeChannel::FadeChannel(const FadeChannel& ch)
     , m_current(ch.m_current)
     , m_ready(ch.m_ready)
     , m_flashing(ch.m_flashing)
+    , m_lsbPairChannel(ch.m_lsbPairChannel)
+    , m_msbPairChannel(ch.m_msbPairChannel)
+    , m_16bit(ch.m_16bit)
+    , m_coupled(ch.m_coupled)
     , m_fadeTime(ch.m_fadeTime)
     , m_elapsed(ch.m_elapsed)
 {
@@ -68,6 +76,10 @@ FadeChannel::FadeChannel(const Doc *doc, quint32 fxi, quint32 channel)
     , m_current(0)
     , m_ready(false)
     , m_flashing(false)
+    , m_lsbPairChannel(QLCChannel::invalid())
+    , m_msbPairChannel(QLCChannel::invalid())
+    , m_16bit(false)
+    , m_coupled(false)
     , m_fadeTime(0)
     , m_elapsed(0)
 {
@@ -82,6 +94,7 @@ FadeChannel::FadeChannel(const Doc *doc, quint32 fxi, quint32 channel)
         m_universe = fixture->universe();
         m_address = fixture->address();
     }
+    cachePairChannels(fixture);
     // cache the channel group just once,
     // since we (hopefully) won't change the
     // channel properties during the FadeChannel lifetime
@@ -111,6 +124,7 @@ void FadeChannel::setFixture(const Doc *doc, quint32 id)
         m_universe = fixture->universe();
         m_address = fixture->address();
     }
+    cachePairChannels(fixture);
 }
 
 quint32 FadeChannel::fixture() const
@@ -132,6 +146,7 @@ void FadeChannel::setChannel(const Doc *doc, quint32 num)
     // cached group and retrieve the correct one
     m_group = QLCChannel::NoGroup;
     m_group = group(doc);
+    cachePairChannels(doc->fixture(m_fixture));
 }
 
 quint32 FadeChannel::channel() const
@@ -203,37 +218,140 @@ QLCChannel::Group FadeChannel::group(const Doc* doc) const
 
 void FadeChannel::setStart(uchar value)
 {
-    m_start = value;
+    if (m_16bit)
+        m_start = (value << 8) | (m_start & 0xFF);
+    else
+        m_start = value;
 }
 
 uchar FadeChannel::start() const
 {
-    return m_start;
+    return m_16bit ? uchar(m_start >> 8) : uchar(m_start);
 }
 
 void FadeChannel::setTarget(uchar value)
 {
-    m_target = value;
+    if (m_16bit)
+        m_target = (value << 8) | (m_target & 0xFF);
+    else
+        m_target = value;
 }
 
 uchar FadeChannel::target() const
 {
-    return m_target;
+    return m_16bit ? uchar(m_target >> 8) : uchar(m_target);
 }
 
 void FadeChannel::setCurrent(uchar value)
 {
-    m_current = value;
+    if (m_16bit)
+        m_current = (value << 8) | (m_current & 0xFF);
+    else
+        m_current = value;
 }
 
 uchar FadeChannel::current() const
 {
-    return m_current;
+    return m_16bit ? uchar(m_current >> 8) : uchar(m_current);
 }
 
 uchar FadeChannel::current(qreal intensity) const
 {
-    return uchar(floor((qreal(m_current) * intensity) + 0.5));
+    return uchar(floor((qreal(current()) * intensity) + 0.5));
+}
+
+/****************************************************************************
+ * 16 bit channels
+ ****************************************************************************/
+
+quint32 FadeChannel::lsbPairChannel() const
+{
+    return m_lsbPairChannel;
+}
+
+quint32 FadeChannel::msbPairChannel() const
+{
+    return m_msbPairChannel;
+}
+
+void FadeChannel::setLsbValues(uchar start, uchar target, uchar current)
+{
+    if (m_16bit == false)
+    {
+        m_start <<= 8;
+        m_target <<= 8;
+        m_current <<= 8;
+        m_16bit = true;
+    }
+
+    m_start = (m_start & 0xFF00) | start;
+    m_target = (m_target & 0xFF00) | target;
+    m_current = (m_current & 0xFF00) | current;
+}
+
+bool FadeChannel::is16Bit() const
+{
+    return m_16bit;
+}
+
+void FadeChannel::clearLsbValues()
+{
+    if (m_16bit == false)
+        return;
+
+    m_start >>= 8;
+    m_target >>= 8;
+    m_current >>= 8;
+    m_16bit = false;
+}
+
+void FadeChannel::setCoupled(bool coupled)
+{
+    m_coupled = coupled;
+}
+
+bool FadeChannel::isCoupled() const
+{
+    return m_coupled;
+}
+
+uchar FadeChannel::startLsb() const
+{
+    return m_16bit ? uchar(m_start & 0xFF) : 0;
+}
+
+uchar FadeChannel::targetLsb() const
+{
+    return m_16bit ? uchar(m_target & 0xFF) : 0;
+}
+
+uchar FadeChannel::currentLsb() const
+{
+    return m_16bit ? uchar(m_current & 0xFF) : 0;
+}
+
+quint32 FadeChannel::lsbAddressInUniverse() const
+{
+    if (m_address == QLCChannel::invalid())
+        return m_lsbPairChannel % UNIVERSE_SIZE;
+
+    return (m_address + m_lsbPairChannel) % UNIVERSE_SIZE;
+}
+
+void FadeChannel::cachePairChannels(const Fixture *fixture)
+{
+    if (fixture == NULL || m_fixture == Fixture::invalidId())
+    {
+        m_lsbPairChannel = QLCChannel::invalid();
+        m_msbPairChannel = QLCChannel::invalid();
+        return;
+    }
+
+    m_lsbPairChannel = fixture->channelLsbPair(m_channel);
+    if (m_lsbPairChannel == QLCChannel::invalid())
+        m_msbPairChannel = fixture->channelMsbPair(m_channel);
+    else
+        m_msbPairChannel = QLCChannel::invalid();
 }
 
 void FadeChannel::setReady(bool rdy)
@@ -310,9 +428,11 @@ uchar FadeChannel::calculateCurrent(uint fadeTime, uint elapsedTime)
     }
     else
     {
-        m_current  = m_target - m_start;
-        m_current  = m_current * (qreal(elapsedTime) / qreal(fadeTime));
-        m_current += m_start;
+        // Fixed point interpolation. For 16 bit channels the whole
+        // MSB/LSB value is interpolated at once, so the fine channel
+        // doesn't wrap around while the coarse one steps
+        qint64 delta = qint64(m_target - m_start) * qint64(elapsedTime);
+        m_current = m_start + int(delta / qint64(fadeTime));
     }
 
     return current();
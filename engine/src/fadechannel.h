@@ -35,9 +35,17 @@
  * $target, with X steps between, determined by $fadeTime. The actual fading process
  * is controlled by GenericFader, but the $current value is calculated each time
  * by FadeChannel.
+ *
+ * A FadeChannel can also represent a 16 bit parameter (e.g. pan/tilt with their
+ * fine channels). In this case GenericFader couples the LSB channel values into
+ * the MSB FadeChannel, the 16 bit value is interpolated once with integer math
+ * and it is split into MSB/LSB only when written to a universe.
  */
 class FadeChannel
 {
+    /** GenericFader looks up 16 bit pairs by fixture and channel only */
+    friend class GenericFader;
+
     /************************************************************************
      * Initialization
      ************************************************************************/
@@ -106,6 +114,63 @@ public:
     /** Get the current value, modified by $intensity. */
     uchar current(qreal intensity) const;
 
+    /************************************************************************
+     * 16 bit channels
+     ************************************************************************/
+public:
+    /**
+     * Get the LSB channel that can be coupled with this channel, if this
+     * is the MSB of a 16 bit parameter. Otherwise QLCChannel::invalid().
+     */
+    quint32 lsbPairChannel() const;
+
+    /**
+     * Get the MSB channel this channel can be coupled with, if this
+     * is the LSB of a 16 bit parameter. Otherwise QLCChannel::invalid().
+     */
+    quint32 msbPairChannel() const;
+
+    /**
+     * Couple the LSB values to this channel, turning it into a 16 bit
+     * channel. Starting from this call, start(), target() and current()
+     * refer to the MSB part only.
+     */
+    void setLsbValues(uchar start, uchar target, uchar current);
+
+    /** Returns true if this channel is fading a coupled 16 bit value */
+    bool is16Bit() const;
+
+    /**
+     * Decouple the LSB values from this channel, turning it back into
+     * an 8 bit channel holding the MSB part.
+     */
+    void clearLsbValues();
+
+    /**
+     * Mark this LSB channel as coupled to its MSB channel, that fades and
+     * writes its value. A coupled channel is not written on its own.
+     */
+    void setCoupled(bool coupled);
+
+    /** Returns true if this LSB channel is coupled to its MSB channel */
+    bool isCoupled() const;
+
+    /** Get the LSB part of the start value. 0 for 8 bit channels */
+    uchar startLsb() const;
+
+    /** Get the LSB part of the target value. 0 for 8 bit channels */
+    uchar targetLsb() const;
+
+    /** Get the LSB part of the current value. 0 for 8 bit channels */
+    uchar currentLsb() const;
+
+    /** Get the absolute address in its universe of the coupled LSB channel */
+    quint32 lsbAddressInUniverse() const;
+
+private:
+    /** Cache the MSB/LSB companion channels of m_channel */
+    void cachePairChannels(const Fixture* fixture);
+
     /** Mark this channel as ready (useful for writing LTP values only once). */
     void setReady(bool rdy);
 
@@ -161,12 +226,18 @@ private:
     quint32 m_address;
     QLCChannel::Group m_group;
 
+    /** When m_16bit is true, these hold 16 bit values (MSB << 8 | LSB) */
     int m_start;
     int m_target;
     int m_current;
     bool m_ready;
     bool m_flashing;
 
+    quint32 m_lsbPairChannel;
+    quint32 m_msbPairChannel;
+    bool m_16bit;
+    bool m_coupled;
+
     uint m_fadeTime;
     uint m_elapsed;
 };
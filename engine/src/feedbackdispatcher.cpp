@@ -0,0 +1,198 @@
+/*
+  Q Light Controller Plus
+  feedbackdispatcher.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QMutexLocker>
+#include <QSettings>
+#include <QDebug>
+
+#include "feedbackdispatcher.h"
+#include "qlcioplugin.h"
+#include "qlctrace.h"
+
+#define FEEDBACK_INTERVAL "inputmap/feedbackinterval"
+
+uint FeedbackDispatcher::s_interval = 20;
+
+FeedbackDispatcher::FeedbackDispatcher(QObject *parent)
+    : QThread(parent)
+    , m_exit(false)
+{
+    QSettings settings;
+    QVariant var = settings.value(FEEDBACK_INTERVAL);
+    if (var.isValid() == true)
+        s_interval = var.toUInt();
+
+    m_clock.start();
+    start(QThread::LowPriority);
+}
+
+FeedbackDispatcher::~FeedbackDispatcher()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_exit = true;
+        m_condition.wakeAll();
+    }
+    wait();
+}
+
+uint FeedbackDispatcher::interval()
+{
+    return s_interval;
+}
+
+quint64 FeedbackDispatcher::channelKey(quint32 universe, quint32 channel)
+{
+    return (quint64(universe) << 32) | quint64(channel);
+}
+
+void FeedbackDispatcher::post(QLCIOPlugin *plugin, quint32 line, quint32 universe,
+                              quint32 channel, uchar value, const QString &key)
+{
+    Q_ASSERT(plugin != NULL);
+
+    quint64 chKey = channelKey(universe, channel);
+
+    QMutexLocker locker(&m_mutex);
+
+    QHash<quint64, Feedback>::iterator it = m_pending.find(chKey);
+    if (it == m_pending.end())
+    {
+        // the device already shows this value
+        QHash<quint64, uchar>::const_iterator sent = m_sent.constFind(chKey);
+        if (sent != m_sent.constEnd() && sent.value() == value)
+            return;
+
+        it = m_pending.insert(chKey, Feedback());
+    }
+
+    Feedback& fb = it.value();
+    fb.plugin = plugin;
+    fb.line = line;
+    fb.universe = universe;
+    fb.channel = channel;
+    fb.value = value;
+    fb.key = key;
+
+    m_condition.wakeAll();
+}
+
+void FeedbackDispatcher::reset(quint32 universe, QLCIOPlugin *plugin, quint32 line)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QHash<quint64, uchar>::iterator it = m_sent.begin();
+    while (it != m_sent.end())
+    {
+        if (quint32(it.key() >> 32) == universe)
+            it = m_sent.erase(it);
+        else
+            ++it;
+    }
+
+    // values queued for the previous patch must not reach another device
+    QHash<quint64, Feedback>::iterator pit = m_pending.begin();
+    while (pit != m_pending.end())
+    {
+        const Feedback& fb = pit.value();
+        if (fb.universe == universe && (fb.plugin != plugin || fb.line != line))
+            pit = m_pending.erase(pit);
+        else
+            ++pit;
+    }
+}
+
+qint64 FeedbackDispatcher::takeBatch(QList<Feedback> &batch)
+{
+    qint64 now = m_clock.elapsed();
+    qint64 wait = -1;
+    QList<Device> served;
+
+    QHash<quint64, Feedback>::iterator it = m_pending.begin();
+    while (it != m_pending.end())
+    {
+        const Feedback& fb = it.value();
+        Device device(fb.plugin, fb.line);
+        qint64 next = m_nextBatch.value(device, 0);
+
+        if (next > now)
+        {
+            if (wait < 0 || next - now < wait)
+                wait = next - now;
+            ++it;
+            continue;
+        }
+
+        // a value might have gone back to the one sent meanwhile
+        QHash<quint64, uchar>::iterator sent = m_sent.find(it.key());
+        if (sent == m_sent.end() || sent.value() != fb.value)
+        {
+            m_sent[it.key()] = fb.value;
+            batch.append(fb);
+            if (served.contains(device) == false)
+                served.append(device);
+        }
+
+        it = m_pending.erase(it);
+    }
+
+    foreach (Device device, served)
+        m_nextBatch[device] = now + s_interval;
+
+    return wait;
+}
+
+/****************************************************************************
+ * Worker
+ ****************************************************************************/
+
+void FeedbackDispatcher::run()
+{
+    QList<Feedback> batch;
+    QMutexLocker locker(&m_mutex);
+
+    while (m_exit == false)
+    {
+        if (m_pending.isEmpty())
+        {
+            m_condition.wait(&m_mutex);
+            continue;
+        }
+
+        qint64 wait = takeBatch(batch);
+
+        if (batch.isEmpty())
+        {
+            // all the pending values belong to devices that were sent a batch just now
+            m_condition.wait(&m_mutex, ulong(qMax(wait, qint64(1))));
+            continue;
+        }
+
+        locker.unlock();
+
+        {
+            QLC_TRACE_SCOPE_ARG("FeedbackDispatcher::batch", batch.count());
+            foreach (const Feedback& fb, batch)
+                fb.plugin->sendFeedBack(fb.universe, fb.line, fb.channel, fb.value, fb.key);
+        }
+        batch.clear();
+
+        locker.relock();
+    }
+}
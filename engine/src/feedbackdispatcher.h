@@ -0,0 +1,126 @@
+/*
+  Q Light Controller Plus
+  feedbackdispatcher.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef FEEDBACKDISPATCHER_H
+#define FEEDBACKDISPATCHER_H
+
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QString>
+#include <QThread>
+#include <QMutex>
+#include <QHash>
+#include <QPair>
+#include <QList>
+
+class QLCIOPlugin;
+
+/** @addtogroup engine Engine
+ * @{
+ */
+
+/**
+ * FeedbackDispatcher sends the feedback values of the control surfaces
+ * (motorized faders, LEDs...) to the plugins on a worker thread.
+ *
+ * Only the latest value of each universe channel is kept until it is sent,
+ * and values equal to the last one sent are discarded. The values of the
+ * same device (plugin line) are sent in batches, at most once every
+ * interval(), so a fast cue playback doesn't flood slow devices.
+ */
+class FeedbackDispatcher : public QThread
+{
+    Q_OBJECT
+
+public:
+    FeedbackDispatcher(QObject* parent = 0);
+    ~FeedbackDispatcher();
+
+    /**
+     * Queue a feedback value, replacing the one of the same universe
+     * channel not sent yet.
+     *
+     * @param plugin The plugin of the feedback patch
+     * @param line The line of the feedback patch
+     * @param universe The universe the channel belongs to
+     * @param channel The feedback channel
+     * @param value The feedback value
+     * @param key The name of the channel (see QLCIOPlugin::sendFeedBack)
+     */
+    void post(QLCIOPlugin* plugin, quint32 line, quint32 universe,
+              quint32 channel, uchar value, const QString& key);
+
+    /**
+     * Forget the last values sent to $universe, so that they will be sent
+     * again, and drop its pending values not addressed to $plugin/$line.
+     *
+     * @param universe The universe whose feedback patch has changed
+     * @param plugin The plugin of the feedback patch (NULL if none)
+     * @param line The line of the feedback patch
+     */
+    void reset(quint32 universe, QLCIOPlugin* plugin, quint32 line);
+
+    /** Return the minimum interval in milliseconds between two batches sent to a device */
+    static uint interval();
+
+protected:
+    /** @reimp */
+    void run();
+
+private:
+    struct Feedback
+    {
+        QLCIOPlugin* plugin;
+        quint32 line;
+        quint32 universe;
+        quint32 channel;
+        uchar value;
+        QString key;
+    };
+
+    typedef QPair<QLCIOPlugin*, quint32> Device;
+
+    static quint64 channelKey(quint32 universe, quint32 channel);
+
+    /** Take the pending values of the devices that can be sent to now.
+     *  Return the milliseconds to wait for the next ones, or -1 */
+    qint64 takeBatch(QList<Feedback>& batch);
+
+private:
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    bool m_exit;
+
+    QElapsedTimer m_clock;
+
+    /** The values waiting to be sent, by universe channel */
+    QHash<quint64, Feedback> m_pending;
+
+    /** The last values sent, by universe channel */
+    QHash<quint64, uchar> m_sent;
+
+    /** The time when each device can be sent the next batch */
+    QHash<Device, qint64> m_nextBatch;
+
+    static uint s_interval;
+};
+
+/** @} */
+
+#endif
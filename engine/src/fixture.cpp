@@ -51,6 +51,8 @@ Fixture::Fixture(QObject* parent) : QObject(parent)
 
 Fixture::~Fixture()
 {
+    if (m_fixtureDef != NULL)
+        m_fixtureDef->deref();
 }
 
 bool Fixture::operator<(const Fixture& fxi)
@@ -340,6 +342,53 @@ quint32 Fixture::tiltLsbChannel(int head) const
     }
 }
 
+quint32 Fixture::channelLsbPair(quint32 channel) const
+{
+    if (channel >= quint32(m_lsbPairs.size()))
+        return QLCChannel::invalid();
+
+    return m_lsbPairs.at(channel);
+}
+
+quint32 Fixture::channelMsbPair(quint32 channel) const
+{
+    if (channel >= quint32(m_msbPairs.size()))
+        return QLCChannel::invalid();
+
+    return m_msbPairs.at(channel);
+}
+
+void Fixture::cachePairChannels()
+{
+    m_lsbPairs.clear();
+    m_msbPairs.clear();
+
+    if (m_fixtureMode == NULL)
+        return;
+
+    int count = m_fixtureMode->channels().size();
+    m_lsbPairs.fill(QLCChannel::invalid(), count);
+    m_msbPairs.fill(QLCChannel::invalid(), count);
+
+    QVector <QLCFixtureHead> const& headList = m_fixtureMode->heads();
+    for (int i = 0; i < headList.size(); i++)
+    {
+        const QLCFixtureHead& head = headList.at(i);
+        quint32 pairs[2][2] = { { head.panMsbChannel(), head.panLsbChannel() },
+                                { head.tiltMsbChannel(), head.tiltLsbChannel() } };
+
+        for (int p = 0; p < 2; p++)
+        {
+            quint32 msb = pairs[p][0], lsb = pairs[p][1];
+            if (msb >= quint32(count) || lsb >= quint32(count))
+                continue;
+
+            m_lsbPairs[msb] = lsb;
+            m_msbPairs[lsb] = msb;
+        }
+    }
+}
+
 quint32 Fixture::masterIntensityChannel(int head) const
 {
     if (head == -1)
@@ -539,6 +588,12 @@ uchar Fixture::channelValueAt(int idx)
 void Fixture::setFixtureDefinition(QLCFixtureDef* fixtureDef,
                                    QLCFixtureMode* fixtureMode)
 {
+    // the definition in use can't be unloaded from the cache
+    if (fixtureDef != NULL && fixtureMode != NULL)
+        fixtureDef->ref();
+    if (m_fixtureDef != NULL)
+        m_fixtureDef->deref();
+
     if (fixtureDef != NULL && fixtureMode != NULL)
     {
         if (m_fixtureDef != NULL && m_fixtureDef != fixtureDef &&
@@ -574,6 +629,8 @@ void Fixture::setFixtureDefinition(QLCFixtureDef* fixtureDef,
         m_fixtureMode = NULL;
     }
 
+    cachePairChannels();
+
     emit changed(m_id);
 }
 
@@ -26,6 +26,7 @@
 #include <QList>
 #include <QIcon>
 #include <QHash>
+#include <QVector>
 
 #include "qlcchannel.h"
 
@@ -266,6 +267,24 @@ public:
     /** @see QLCFixtureHead */
     quint32 tiltLsbChannel(int head = 0) const;
 
+    /**
+     * Return the LSB channel coupled with the given 16 bit pan/tilt MSB
+     * channel of any head.
+     *
+     * @param channel The MSB channel index
+     * @return The LSB channel index or QLCChannel::invalid() if not applicable
+     */
+    quint32 channelLsbPair(quint32 channel) const;
+
+    /**
+     * Return the MSB channel coupled with the given 16 bit pan/tilt LSB
+     * channel of any head.
+     *
+     * @param channel The LSB channel index
+     * @return The MSB channel index or QLCChannel::invalid() if not applicable
+     */
+    quint32 channelMsbPair(quint32 channel) const;
+
     /** @see QLCFixtureHead */
     quint32 masterIntensityChannel(int head = 0) const;
 
@@ -411,6 +430,14 @@ protected:
     /** The mode within the fixture definition that this instance uses */
     QLCFixtureMode* m_fixtureMode;
 
+private:
+    /** Build the 16 bit pan/tilt pair tables of the current mode */
+    void cachePairChannels();
+
+    /** The LSB and MSB channel paired with each channel, or QLCChannel::invalid() */
+    QVector <quint32> m_lsbPairs;
+    QVector <quint32> m_msbPairs;
+
     /*********************************************************************
      * Generic Dimmer
      *********************************************************************/
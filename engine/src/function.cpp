@@ -753,11 +753,20 @@ bool Function::loadXML(QXmlStreamReader &root)
 }
 
 bool Function::loader(QXmlStreamReader &root, Doc* doc)
+{
+    Function* function = create(root, doc);
+    if (function == NULL)
+        return false;
+
+    return addLoaded(function, function->loadXML(root), doc);
+}
+
+Function* Function::create(QXmlStreamReader &root, Doc* doc)
 {
     if (root.name() != KXMLQLCFunction)
     {
         qWarning("Function node not found!");
-        return false;
+        return NULL;
     }
 
     QXmlStreamAttributes attrs = root.attributes();
@@ -778,7 +787,7 @@ bool Function::loader(QXmlStreamReader &root, Doc* doc)
     if (id == Function::invalidId())
     {
         qWarning() << Q_FUNC_INFO << "Function ID" << id << "is not allowed.";
-        return false;
+        return NULL;
     }
 
     /* Create a new function according to the type */
@@ -804,28 +813,37 @@ bool Function::loader(QXmlStreamReader &root, Doc* doc)
         function = new class Video(doc);
 #endif
     else
-        return false;
+        return NULL;
 
+    function->setID(id);
     function->setName(name);
     function->setPath(path);
     function->setBlendMode(blendMode);
-    if (function->loadXML(root) == true)
+
+    return function;
+}
+
+bool Function::addLoaded(Function* function, bool loaded, Doc* doc)
+{
+    Q_ASSERT(function != NULL);
+
+    if (loaded == true)
     {
-        if (doc->addFunction(function, id) == true)
+        if (doc->addFunction(function, function->id()) == true)
         {
             /* Success */
             return true;
         }
         else
         {
-            qWarning() << "Function" << name << "cannot be created.";
+            qWarning() << "Function" << function->name() << "cannot be created.";
             delete function;
             return false;
         }
     }
     else
     {
-        qWarning() << "Function" << name << "cannot be loaded.";
+        qWarning() << "Function" << function->name() << "cannot be loaded.";
         delete function;
         return false;
     }
@@ -900,6 +918,15 @@ void Function::postRun(MasterTimer* timer, QList<Universe *> universes)
     emit stopped(m_id);
 }
 
+void Function::preload(quint32 startTime)
+{
+    Q_UNUSED(startTime);
+}
+
+void Function::cancelPreload()
+{
+}
+
 bool Function::isRunning() const
 {
     return m_running;
@@ -1028,6 +1055,12 @@ bool Function::startedAsChild() const
     return false;
 }
 
+QList<FunctionParent> Function::sources() const
+{
+    QMutexLocker sourcesLocker(const_cast<QMutex*>(&m_sourcesMutex));
+    return m_sources;
+}
+
 bool Function::stopAndWait()
 {
     bool result = true;
@@ -495,6 +495,28 @@ public:
      */
     static bool loader(QXmlStreamReader &root, Doc* doc);
 
+    /**
+     * Create an empty function of the type, ID, name, path and blend mode
+     * given by the attributes of a function XML tag. The tag contents are
+     * not read.
+     *
+     * @param root An XML root element of a function
+     * @param doc The QLC document object, that owns all functions
+     * @return A new function or NULL if the attributes are not valid
+     */
+    static Function* create(QXmlStreamReader &root, Doc* doc);
+
+    /**
+     * Add a function created with create() to the given doc object, if its
+     * contents have been loaded successfully. Otherwise, delete it.
+     *
+     * @param function A function created with create()
+     * @param loaded The result of function->loadXML()
+     * @param doc The QLC document object, that owns all functions
+     * @return true if the function has been added, otherwise false
+     */
+    static bool addLoaded(Function* function, bool loaded, Doc* doc);
+
     /**
      * Called for each Function-based object after everything has been loaded.
      * Do any post-load cleanup, function mappings etc. if needed. Default
@@ -576,6 +598,22 @@ public:
      */
     virtual void postRun(MasterTimer* timer, QList<Universe*> universes);
 
+    /**
+     * Prepare the function to be started soon at $startTime milliseconds,
+     * so that preRun() has nothing slow left to do. Runners call this a
+     * little before starting a function (see MasterTimer::mediaPreroll()),
+     * for example to open and buffer the media of Audio functions.
+     * The default implementation does nothing.
+     */
+    virtual void preload(quint32 startTime);
+
+    /**
+     * Release what preload() has prepared, when the function is not going
+     * to be started after all. Running functions are not affected.
+     * The default implementation does nothing.
+     */
+    virtual void cancelPreload();
+
 signals:
     /**
      * Emitted when a function is started (i.e. added to MasterTimer's
@@ -670,6 +708,9 @@ public:
      */
     bool stopAndWait();
 
+    /** Return the parents the function has been started by */
+    QList<FunctionParent> sources() const;
+
     /**
      * Check, whether the function is currently running (preRun() has been run)
      * or not (postRun() has been completed). This should be used only from MasterTimer.
@@ -0,0 +1,190 @@
+/*
+  Q Light Controller Plus
+  functionloader.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QRunnable>
+#include <QThread>
+#include <QDebug>
+
+#include "functionloader.h"
+#include "function.h"
+#include "qlctrace.h"
+#include "doc.h"
+
+/** Minimum number of concurrent functions worth using the thread pool */
+#define CONCURRENT_LOAD_MIN_FUNCTIONS   8
+
+class FunctionLoader::LoadTask : public QRunnable
+{
+public:
+    LoadTask(FunctionLoader* loader, QSemaphore& done)
+        : m_loader(loader)
+        , m_done(done)
+    {
+        setAutoDelete(false);
+    }
+
+    void run()
+    {
+        m_loader->loadConcurrent();
+        m_done.release();
+    }
+
+private:
+    FunctionLoader* m_loader;
+    QSemaphore& m_done;
+};
+
+FunctionLoader::FunctionLoader(Doc* doc)
+    : m_doc(doc)
+    , m_next(0)
+{
+    Q_ASSERT(doc != NULL);
+}
+
+FunctionLoader::~FunctionLoader()
+{
+    flush();
+}
+
+void FunctionLoader::append(QXmlStreamReader &root)
+{
+    Function* function = Function::create(root, m_doc);
+    if (function == NULL)
+    {
+        root.skipCurrentElement();
+        return;
+    }
+
+    Entry entry;
+    entry.function = function;
+    entry.loaded = false;
+    entry.concurrent = (function->type() == Function::Scene ||
+                        function->type() == Function::Chaser ||
+                        function->type() == Function::Collection ||
+                        function->type() == Function::EFX);
+
+    /* Copy the whole tag, so that it can be read again by another thread.
+     * The reader is left at the end of the tag, as if it was loaded */
+    QXmlStreamWriter writer(&entry.xml);
+    writer.writeCurrentToken(root);
+    int depth = 1;
+    while (depth > 0 && root.atEnd() == false)
+    {
+        root.readNext();
+        if (root.isStartElement())
+            depth++;
+        else if (root.isEndElement())
+            depth--;
+        writer.writeCurrentToken(root);
+    }
+
+    m_entries.append(entry);
+}
+
+int FunctionLoader::count() const
+{
+    return m_entries.count();
+}
+
+void FunctionLoader::load(Entry &entry)
+{
+    QXmlStreamReader reader(entry.xml);
+    if (reader.readNextStartElement() == true)
+        entry.loaded = entry.function->loadXML(reader);
+
+    if (reader.hasError())
+    {
+        qWarning() << Q_FUNC_INFO << "Function" << entry.function->name()
+                   << "XML error:" << reader.errorString();
+    }
+
+    // not needed anymore
+    entry.xml.clear();
+}
+
+void FunctionLoader::loadConcurrent()
+{
+    int index;
+    while ((index = m_next.fetchAndAddOrdered(1)) < m_entries.count())
+    {
+        Entry& entry = m_entries[index];
+        if (entry.concurrent == true)
+            load(entry);
+    }
+}
+
+void FunctionLoader::flush()
+{
+    if (m_entries.isEmpty())
+        return;
+
+    QLC_TRACE_SCOPE_ARG("FunctionLoader::flush", m_entries.count());
+
+    int concurrent = 0;
+    for (int i = 0; i < m_entries.count(); i++)
+    {
+        if (m_entries.at(i).concurrent == true)
+            concurrent++;
+    }
+
+    int taskCount = qMin(QThread::idealThreadCount() - 1, QThreadPool::globalInstance()->maxThreadCount());
+    if (concurrent < CONCURRENT_LOAD_MIN_FUNCTIONS)
+        taskCount = 0;
+    taskCount = qBound(0, taskCount, concurrent - 1);
+
+    // detach the entries before other threads access them
+    m_entries.detach();
+    m_next.fetchAndStoreOrdered(0);
+
+    QSemaphore done;
+    QList <LoadTask*> tasks;
+    for (int i = 0; i < taskCount; i++)
+    {
+        LoadTask* task = new LoadTask(this, done);
+        QThreadPool::globalInstance()->start(task);
+        tasks.append(task);
+    }
+
+    /* The other types are loaded here meanwhile, then this thread
+     * helps with the concurrent ones left */
+    for (int i = 0; i < m_entries.count(); i++)
+    {
+        Entry& entry = m_entries[i];
+        if (entry.concurrent == false)
+            load(entry);
+    }
+    loadConcurrent();
+
+    done.acquire(tasks.count());
+    qDeleteAll(tasks);
+
+    /* Link the functions in document order, which is their ID order
+     * in the workspaces saved by Doc */
+    for (int i = 0; i < m_entries.count(); i++)
+    {
+        Entry& entry = m_entries[i];
+        Function::addLoaded(entry.function, entry.loaded, m_doc);
+    }
+
+    m_entries.clear();
+}
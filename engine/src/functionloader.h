@@ -0,0 +1,89 @@
+/*
+  Q Light Controller Plus
+  functionloader.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef FUNCTIONLOADER_H
+#define FUNCTIONLOADER_H
+
+#include <QByteArray>
+#include <QAtomicInt>
+#include <QVector>
+
+class QXmlStreamReader;
+class Function;
+class Doc;
+
+/** @addtogroup engine_functions Functions
+ * @{
+ */
+
+/**
+ * FunctionLoader loads the Function tags of a workspace on the thread pool.
+ *
+ * The tags are copied by append() while Doc reads the workspace, then
+ * flush() loads their contents concurrently into functions that are not
+ * part of Doc yet, and finally adds them to Doc in document order from
+ * the calling thread.
+ *
+ * Only the function types whose loadXML() doesn't create QObjects or use
+ * Doc services (Scene, Chaser, Collection, EFX) are loaded concurrently.
+ * The other types are loaded by the calling thread meanwhile.
+ */
+class FunctionLoader
+{
+public:
+    FunctionLoader(Doc* doc);
+    ~FunctionLoader();
+
+    /** Take the Function tag at the current position of $root */
+    void append(QXmlStreamReader& root);
+
+    /** Load the functions taken so far and add them to Doc */
+    void flush();
+
+    /** Return the number of functions waiting to be loaded */
+    int count() const;
+
+private:
+    struct Entry
+    {
+        Function* function;
+        QByteArray xml;
+        bool concurrent;
+        bool loaded;
+    };
+
+    class LoadTask;
+
+    /** Load the contents of $entry from its XML copy */
+    static void load(Entry& entry);
+
+    /** Load the concurrent entries not taken yet by another thread */
+    void loadConcurrent();
+
+private:
+    Doc* m_doc;
+    QVector<Entry> m_entries;
+
+    /** The next concurrent entry to load */
+    QAtomicInt m_next;
+};
+
+/** @} */
+
+#endif
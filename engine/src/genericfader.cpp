@@ -22,6 +22,7 @@
 
 #include "genericfader.h"
 #include "fadechannel.h"
+#include "qlctrace.h"
 #include "doc.h"
 
 GenericFader::GenericFader(Doc* doc)
@@ -43,22 +44,108 @@ void GenericFader::add(const FadeChannel& ch)
     {
         // perform a HTP check
         if (channelIterator.value().current() <= ch.current())
-            channelIterator.value() = ch;
+            replace(channelIterator.value(), ch);
     }
     else
     {
-        m_channels.insert(ch, ch);
+        channelIterator = m_channels.insert(ch, ch);
     }
+
+    couple(channelIterator.value());
 }
 
 void GenericFader::forceAdd(const FadeChannel &ch)
 {
-    m_channels.insert(ch, ch);
+    QHash<FadeChannel,FadeChannel>::iterator channelIterator = m_channels.find(ch);
+    if (channelIterator != m_channels.end())
+        replace(channelIterator.value(), ch);
+    else
+        channelIterator = m_channels.insert(ch, ch);
+
+    couple(channelIterator.value());
+}
+
+FadeChannel *GenericFader::pairChannel(const FadeChannel &ch, quint32 channel)
+{
+    if (channel == QLCChannel::invalid())
+        return NULL;
+
+    FadeChannel key;
+    key.m_fixture = ch.fixture();
+    key.m_channel = channel;
+
+    QHash<FadeChannel,FadeChannel>::iterator it = m_channels.find(key);
+    if (it == m_channels.end())
+        return NULL;
+
+    return &it.value();
+}
+
+void GenericFader::couple(FadeChannel &ch)
+{
+    if (ch.msbPairChannel() != QLCChannel::invalid())
+    {
+        // $ch is a LSB: its values are faded by the MSB channel, if present
+        FadeChannel* msb = pairChannel(ch, ch.msbPairChannel());
+        if (msb != NULL)
+        {
+            msb->setLsbValues(ch.start(), ch.target(), ch.current());
+            ch.setCoupled(true);
+        }
+    }
+    else if (ch.lsbPairChannel() != QLCChannel::invalid() && ch.is16Bit() == false)
+    {
+        // $ch is a MSB: take over the LSB channel added before
+        FadeChannel* lsb = pairChannel(ch, ch.lsbPairChannel());
+        if (lsb != NULL)
+        {
+            ch.setLsbValues(lsb->start(), lsb->target(), lsb->current());
+            lsb->setCoupled(true);
+        }
+    }
+}
+
+void GenericFader::decouple(const FadeChannel &ch)
+{
+    if (ch.is16Bit() == true)
+    {
+        // the LSB channel goes on fading on its own
+        FadeChannel* lsb = pairChannel(ch, ch.lsbPairChannel());
+        if (lsb != NULL)
+            lsb->setCoupled(false);
+    }
+    else if (ch.isCoupled() == true)
+    {
+        FadeChannel* msb = pairChannel(ch, ch.msbPairChannel());
+        if (msb != NULL)
+            msb->clearLsbValues();
+    }
+}
+
+void GenericFader::replace(FadeChannel &existing, const FadeChannel &ch)
+{
+    if (existing.is16Bit() == true && ch.is16Bit() == false)
+    {
+        // the LSB part might have been coupled already,
+        // so don't lose it
+        FadeChannel fc(ch);
+        fc.setLsbValues(existing.startLsb(), existing.targetLsb(), existing.currentLsb());
+        existing = fc;
+    }
+    else
+    {
+        existing = ch;
+    }
 }
 
 void GenericFader::remove(const FadeChannel& ch)
 {
-    m_channels.remove(ch);
+    QHash<FadeChannel,FadeChannel>::iterator channelIterator = m_channels.find(ch);
+    if (channelIterator == m_channels.end())
+        return;
+
+    decouple(channelIterator.value());
+    m_channels.erase(channelIterator);
 }
 
 void GenericFader::removeAll()
@@ -73,10 +160,17 @@ const QHash <FadeChannel,FadeChannel>& GenericFader::channels() const
 
 void GenericFader::write(QList<Universe*> ua, bool paused)
 {
+    QLC_TRACE_SCOPE_ARG("GenericFader::write", m_channels.count());
+
     QMutableHashIterator <FadeChannel,FadeChannel> it(m_channels);
     while (it.hasNext() == true)
     {
         FadeChannel& fc(it.next().value());
+
+        // coupled LSB channels are written by their MSB channel
+        if (fc.isCoupled())
+            continue;
+
         QLCChannel::Group grp = fc.group(m_doc);
         quint32 addr = fc.addressInUniverse();
         quint32 universe = fc.universe();
@@ -97,6 +191,18 @@ void GenericFader::write(QList<Universe*> ua, bool paused)
         {
             //qDebug() << "[GenericFader] >>> uni:" << universe << ", address:" << addr << ", value:" << value;
             ua[universe]->writeBlended(addr, value, m_blendMode);
+
+            // 16 bit channels are split into MSB/LSB only here
+            if (fc.is16Bit())
+                ua[universe]->writeBlended(fc.lsbAddressInUniverse(), fc.currentLsb(), m_blendMode);
+        }
+
+        // keep the coupled LSB channel in sync for channels() users
+        if (fc.is16Bit())
+        {
+            FadeChannel* lsb = pairChannel(fc, fc.lsbPairChannel());
+            if (lsb != NULL)
+                lsb->setCurrent(fc.currentLsb());
         }
 
         if (grp == QLCChannel::Intensity && m_blendMode == Universe::NormalBlend)
@@ -104,7 +210,10 @@ void GenericFader::write(QList<Universe*> ua, bool paused)
             // Remove all HTP channels that reach their target _zero_ value.
             // They have no effect either way so removing them saves CPU a bit.
             if (fc.current() == 0 && fc.target() == 0)
+            {
+                decouple(fc);
                 it.remove();
+            }
         }
 /*
         else
@@ -115,7 +224,10 @@ void GenericFader::write(QList<Universe*> ua, bool paused)
         }
 */
         if (fc.isFlashing())
+        {
+            decouple(fc);
             it.remove();
+        }
     }
 }
 
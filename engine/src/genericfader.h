@@ -48,6 +48,9 @@ public:
      * in the value jumping ina weird way but LTP channels are rarely faded anyway.
      * With HTP channels the lower value has no meaning in the first place.
      *
+     * The LSB channel of a 16 bit parameter is coupled to its MSB channel
+     * if present, so that the two are faded together as a single value.
+     *
      * @param ch The channel to fade
      */
     void add(const FadeChannel& ch);
@@ -96,6 +99,23 @@ public:
      */
     void setBlendMode(Universe::BlendMode mode);
 
+private:
+    /** Return the channel of the same fixture as $ch with index $channel, if faded */
+    FadeChannel* pairChannel(const FadeChannel& ch, quint32 channel);
+
+    /**
+     * Couple the 16 bit parameter $ch belongs to, if both its MSB and LSB
+     * channels are faded. The LSB channel stays in channels(), marked as
+     * coupled, and its values are faded and written by the MSB channel.
+     */
+    void couple(FadeChannel& ch);
+
+    /** Undo couple() when $ch is about to be removed */
+    void decouple(const FadeChannel& ch);
+
+    /** Replace $existing with $ch, retaining the coupled LSB values if any */
+    static void replace(FadeChannel& existing, const FadeChannel& ch);
+
 private:
     QHash <FadeChannel,FadeChannel> m_channels;
     qreal m_intensity;
@@ -0,0 +1,171 @@
+/*
+  Q Light Controller Plus
+  idslotmap.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef IDSLOTMAP_H
+#define IDSLOTMAP_H
+
+#include <QVector>
+#include <QHash>
+#include <QList>
+
+/** @addtogroup engine Engine
+ * @{
+ */
+
+/** IDs below this value are stored in a vector, the others in a hash */
+#define IDSLOTMAP_DENSE_SIZE    65536
+
+/**
+ * IdSlotMap is a registry of objects by ID, used by Doc for the functions
+ * and the fixtures of a workspace.
+ *
+ * Since IDs are assigned incrementally, an object is looked up by indexing
+ * a vector with its ID, instead of hashing it. Very high IDs, that might
+ * come from hand-written workspaces, are kept in a hash so that they don't
+ * grow the vector.
+ *
+ * The objects are also kept in a list sorted by ID, that can be iterated
+ * without allocating anything.
+ *
+ * The map doesn't own the objects.
+ */
+template <typename T> class IdSlotMap
+{
+public:
+    /** Return the object with the given $id, or NULL if not found */
+    T* value(quint32 id) const
+    {
+        if (id < quint32(m_slots.size()))
+            return m_slots.at(int(id));
+        if (id < IDSLOTMAP_DENSE_SIZE)
+            return NULL;
+        return m_sparse.value(id, NULL);
+    }
+
+    bool contains(quint32 id) const
+    {
+        return value(id) != NULL;
+    }
+
+    /**
+     * Add $item with the given $id
+     *
+     * @return false if $id is already taken
+     */
+    bool insert(quint32 id, T* item)
+    {
+        Q_ASSERT(item != NULL);
+
+        if (contains(id) == true)
+            return false;
+
+        if (id < IDSLOTMAP_DENSE_SIZE)
+        {
+            if (id >= quint32(m_slots.size()))
+            {
+                int size = qMax(m_slots.size() * 2, int(id) + 1);
+                m_slots.insert(m_slots.end(), qMin(size, IDSLOTMAP_DENSE_SIZE) - m_slots.size(), NULL);
+            }
+            m_slots[int(id)] = item;
+        }
+        else
+        {
+            m_sparse.insert(id, item);
+        }
+
+        int index = lowerBound(id);
+        m_keys.insert(index, id);
+        m_values.insert(index, item);
+
+        return true;
+    }
+
+    /** Remove the object with the given $id and return it, or NULL if not found */
+    T* take(quint32 id)
+    {
+        T* item = value(id);
+        if (item == NULL)
+            return NULL;
+
+        if (id < IDSLOTMAP_DENSE_SIZE)
+            m_slots[int(id)] = NULL;
+        else
+            m_sparse.remove(id);
+
+        int index = lowerBound(id);
+        m_keys.removeAt(index);
+        m_values.removeAt(index);
+
+        return item;
+    }
+
+    void clear()
+    {
+        m_slots.clear();
+        m_sparse.clear();
+        m_keys.clear();
+        m_values.clear();
+    }
+
+    int count() const { return m_values.count(); }
+    int size() const { return m_values.count(); }
+    bool isEmpty() const { return m_values.isEmpty(); }
+
+    /** Return the IDs in ascending order */
+    const QList<quint32>& keys() const { return m_keys; }
+
+    /** Return the objects sorted by ID */
+    const QList<T*>& values() const { return m_values; }
+
+private:
+    /** Return the position of $id in the sorted lists */
+    int lowerBound(quint32 id) const
+    {
+        // IDs are mostly added in ascending order
+        if (m_keys.isEmpty() || m_keys.last() < id)
+            return m_keys.count();
+
+        int first = 0;
+        int last = m_keys.count();
+        while (first < last)
+        {
+            int middle = (first + last) / 2;
+            if (m_keys.at(middle) < id)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+        return first;
+    }
+
+private:
+    /** Objects indexed by ID, for IDs below IDSLOTMAP_DENSE_SIZE */
+    QVector<T*> m_slots;
+
+    /** Objects with higher IDs */
+    QHash<quint32, T*> m_sparse;
+
+    /** IDs and objects sorted by ID */
+    QList<quint32> m_keys;
+    QList<T*> m_values;
+};
+
+/** @} */
+
+#endif
@@ -28,6 +28,7 @@
 #include <QSettings>
 #include <QDebug>
 
+#include "feedbackdispatcher.h"
 #include "inputoutputmap.h"
 #include "qlcinputchannel.h"
 #include "qlcinputsource.h"
@@ -37,6 +38,7 @@
 #include "qlcconfig.h"
 #include "universe.h"
 #include "qlcfile.h"
+#include "qlctrace.h"
 #include "doc.h"
 
 InputOutputMap::InputOutputMap(Doc *doc, quint32 universes)
@@ -45,6 +47,7 @@ InputOutputMap::InputOutputMap(Doc *doc, quint32 universes)
   , m_universeChanged(false)
 {
     m_grandMaster = new GrandMaster(this);
+    m_feedback = new FeedbackDispatcher(this);
     for (quint32 i = 0; i < universes; i++)
         addUniverse();
 
@@ -54,6 +57,7 @@ InputOutputMap::InputOutputMap(Doc *doc, quint32 universes)
 
 InputOutputMap::~InputOutputMap()
 {
+    delete m_feedback;
     removeAllUniverses();
     delete m_grandMaster;
 }
@@ -90,6 +94,7 @@ void InputOutputMap::setBlackout(bool blackout)
     for (quint32 i = 0; i < universesCount(); i++)
     {
         Universe *universe = m_universeArray.at(i);
+        universe->setBlackout(blackout);
         if (universe->outputPatch() != NULL)
         {
             if (blackout == true)
@@ -139,6 +144,8 @@ bool InputOutputMap::addUniverse(quint32 id)
         }
         else if (id > universesCount())
         {
+            // gap universes share their buffers until written,
+            // and are skipped by the per-tick operations while idle
             qDebug() << Q_FUNC_INFO
                 << "Gap between universe" << (universesCount() - 1)
                 << "and universe" << id
@@ -228,6 +235,20 @@ bool InputOutputMap::getUniversePassthrough(int index)
     return m_universeArray.at(index)->passthrough();
 }
 
+void InputOutputMap::setUniversePassthroughBypass(int index, bool enable)
+{
+    if (index < 0 || index >= m_universeArray.count())
+        return;
+    m_universeArray.at(index)->setPassthroughBypass(enable);
+}
+
+bool InputOutputMap::getUniversePassthroughBypass(int index)
+{
+    if (index < 0 || index >= m_universeArray.count())
+        return false;
+    return m_universeArray.at(index)->passthroughBypass();
+}
+
 void InputOutputMap::setUniverseMonitor(int index, bool enable)
 {
     if (index < 0 || index >= m_universeArray.count())
@@ -274,12 +295,19 @@ void InputOutputMap::releaseUniverses(bool changed)
 
 void InputOutputMap::dumpUniverses()
 {
+    QLC_TRACE_SCOPE("InputOutputMap::dumpUniverses");
+
     QMutexLocker locker(&m_universeMutex);
     if (m_blackout == false)
     {
         for (int i = 0; i < m_universeArray.count(); i++)
         {
             Universe *universe = m_universeArray.at(i);
+
+            // nothing to send or to notify for unused universes
+            if (universe->isIdle())
+                continue;
+
             const QByteArray postGM = universe->postGMValues()->mid(0, universe->usedChannels());
 
             // notify the universe listeners that some channels have changed
@@ -379,6 +407,8 @@ uchar InputOutputMap::grandMasterValue()
 
 void InputOutputMap::flushInputs()
 {
+    QLC_TRACE_SCOPE("InputOutputMap::flushInputs");
+
     QMutexLocker locker(&m_universeMutex);
 
     for (int i = 0; i < m_universeArray.count(); i++)
@@ -463,8 +493,19 @@ bool InputOutputMap::setOutputPatch(quint32 universe, const QString &pluginName,
         return m_universeArray.at(universe)->setOutputPatch(
                     doc()->ioPluginCache()->plugin(pluginName), output);
     else
-        return m_universeArray.at(universe)->setFeedbackPatch(
-                    doc()->ioPluginCache()->plugin(pluginName), output);
+    {
+        Universe* uni = m_universeArray.at(universe);
+        bool result = uni->setFeedbackPatch(doc()->ioPluginCache()->plugin(pluginName), output);
+
+        // a new device doesn't show any of the values sent so far
+        OutputPatch* fbPatch = uni->feedbackPatch();
+        if (fbPatch != NULL)
+            m_feedback->reset(universe, fbPatch->plugin(), fbPatch->output());
+        else
+            m_feedback->reset(universe, NULL, QLCIOPlugin::invalidLine());
+
+        return result;
+    }
 
     return false;
 }
@@ -669,7 +710,7 @@ bool InputOutputMap::sendFeedBack(quint32 universe, quint32 channel, uchar value
 
     if (patch != NULL && patch->isPatched())
     {
-        patch->plugin()->sendFeedBack(universe, patch->output(), channel, value, key);
+        m_feedback->post(patch->plugin(), patch->output(), universe, channel, value, key);
         return true;
     }
     else
@@ -697,6 +738,11 @@ void InputOutputMap::slotPluginConfigurationChanged(QLCIOPlugin* plugin)
         {
             /*success = */ ip->reconnect();
         }
+
+        // the device may have been reconnected, or its line may be gone
+        OutputPatch* fp = m_universeArray.at(i)->feedbackPatch();
+        if (fp != NULL && fp->plugin() == plugin)
+            m_feedback->reset(i, plugin, fp->output());
     }
     locker.unlock();
 
@@ -915,6 +961,10 @@ void InputOutputMap::loadDefaults()
         if (passthrough == true)
             m_universeArray.at(i)->setPassthrough(passthrough);
 
+        key = QString("/inputmap/universe%1/passthroughbypass/").arg(i);
+        if (settings.value(key).toBool() == true)
+            m_universeArray.at(i)->setPassthroughBypass(true);
+
         /* Do the mapping */
         if (plugin != KInputNone && input != KInputNone)
             setInputPatch(i, plugin, input.toUInt(), profileName);
@@ -989,6 +1039,12 @@ void InputOutputMap::saveDefaults()
             settings.setValue(key, passthrough);
         else
             settings.remove(key);
+
+        key = QString("/inputmap/universe%1/passthroughbypass/").arg(i);
+        if (m_universeArray.at(i)->passthroughBypass() == true)
+            settings.setValue(key, true);
+        else
+            settings.remove(key);
     }
 
     /* ************************ OUTPUT *********************************** */
@@ -30,6 +30,7 @@
 
 class QXmlStreamReader;
 class QXmlStreamWriter;
+class FeedbackDispatcher;
 class QLCInputSource;
 class QLCIOPlugin;
 class OutputPatch;
@@ -184,6 +185,21 @@ public:
      */
     bool getUniversePassthrough(int index);
 
+    /**
+     * Enable/disable the passthrough bypass of the universe with the given
+     * index (see Universe::setPassthroughBypass)
+     * @param index The universe index
+     * @param enable true = forward input frames right away, false = on every tick
+     */
+    void setUniversePassthroughBypass(int index, bool enable);
+
+    /**
+     * Retrieve the passthrough bypass mode of the universe at the given index
+     * @param index The universe index
+     * @return true = bypass enabled, false = bypass disabled
+     */
+    bool getUniversePassthroughBypass(int index);
+
     /**
      * Enable/disable the monitor mode for the universe with the given index
      * @param index The universe index
@@ -472,9 +488,14 @@ public:
     /**
      * Send feedback value to the input profile e.g. to move a motorized
      * sliders & knobs, set indicator leds etc.
+     * Values are sent asynchronously and rate limited by a FeedbackDispatcher
      */
     bool sendFeedBack(quint32 universe, quint32 channel, uchar value, const QString& key = 0);
 
+private:
+    /** The worker sending the feedback values to the plugins */
+    FeedbackDispatcher* m_feedback;
+
 private slots:
    /** Slot that catches plugin configuration change notifications from UIPluginCache */
     void slotPluginConfigurationChanged(QLCIOPlugin* plugin);
@@ -28,6 +28,8 @@
 #include "qlcinputchannel.h"
 #include "qlcioplugin.h"
 #include "inputpatch.h"
+#include "qlctrace.h"
+#include "valuemailbox.h"
 
 #define GRACE_MS 1
 
@@ -79,6 +81,8 @@ bool InputPatch::set(QLCIOPlugin* plugin, quint32 input, QLCInputProfile* profil
     {
         disconnect(m_plugin, SIGNAL(valueChanged(quint32,quint32,quint32,uchar,QString)),
                    this, SLOT(slotValueChanged(quint32,quint32,quint32,uchar,QString)));
+        disconnect(m_plugin, SIGNAL(inputFrameReceived(quint32,quint32,QByteArray)),
+                   this, SLOT(slotFrameReceived(quint32,quint32,QByteArray)));
         m_plugin->closeInput(m_pluginLine, m_universe);
     }
 
@@ -100,6 +104,10 @@ bool InputPatch::set(QLCIOPlugin* plugin, quint32 input, QLCInputProfile* profil
     {
         connect(m_plugin, SIGNAL(valueChanged(quint32,quint32,quint32,uchar,QString)),
                 this, SLOT(slotValueChanged(quint32,quint32,quint32,uchar,QString)));
+        // frames are handled right away in the plugin thread, see Universe::setPassthroughBypass
+        connect(m_plugin, SIGNAL(inputFrameReceived(quint32,quint32,QByteArray)),
+                this, SLOT(slotFrameReceived(quint32,quint32,QByteArray)),
+                Qt::DirectConnection);
         result = m_plugin->openInput(m_pluginLine, m_universe);
 
         if (m_profile != NULL)
@@ -203,6 +211,8 @@ QMap<QString, QVariant> InputPatch::getPluginParameters()
 void InputPatch::slotValueChanged(quint32 universe, quint32 input, quint32 channel,
                                   uchar value, const QString& key)
 {
+    QLC_TRACE_SCOPE_ARG("InputPatch::slotValueChanged", m_universe);
+
     // In case we have several lines connected to the same plugin, emit only
     // such values that belong to this particular patch.
     if (input == m_pluginLine)
@@ -232,6 +242,14 @@ void InputPatch::slotValueChanged(quint32 universe, quint32 input, quint32 chann
     }
 }
 
+void InputPatch::slotFrameReceived(quint32 universe, quint32 input, const QByteArray &data)
+{
+    if (input != m_pluginLine || (universe != UINT_MAX && universe != m_universe))
+        return;
+
+    emit inputFrameReceived(m_universe, data, ValueMailbox::clock());
+}
+
 void InputPatch::setProfilePageControls()
 {
     if (m_profile != NULL)
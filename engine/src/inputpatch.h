@@ -127,6 +127,10 @@ signals:
     void inputValueChanged(quint32 inputUniverse, quint32 channel,
                            uchar value, const QString& key = 0);
 
+    /** Emitted from the input plugin thread when a whole
+     *  DMX frame has been received at $timestamp (see ValueMailbox::clock) */
+    void inputFrameReceived(quint32 inputUniverse, const QByteArray& data, quint32 timestamp);
+
     void inputNameChanged();
     void pluginNameChanged();
     void profileNameChanged();
@@ -134,6 +138,7 @@ signals:
 private slots:
     void slotValueChanged(quint32 universe, quint32 input,
                           quint32 channel, uchar value, const QString& key = 0);
+    void slotFrameReceived(quint32 universe, quint32 input, const QByteArray& data);
 
 private:
     /** The reference of the plugin associated by this Input patch */
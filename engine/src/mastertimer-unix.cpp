@@ -30,6 +30,7 @@
 
 #include "mastertimer-unix.h"
 #include "mastertimer.h"
+#include "qlctrace.h"
 
 /****************************************************************************
  * MasterTimerPrivate
@@ -90,6 +91,10 @@ void MasterTimerPrivate::run()
         m_run = true;
     }
 
+#ifdef QLC_TRACING
+    QLCTrace::setThreadName("MasterTimer");
+#endif
+
     while (m_run == true)
     {
         /* Increment the finish time for this loop */
@@ -34,15 +34,18 @@
 #include "mastertimer.h"
 #include "dmxsource.h"
 #include "qlcmacros.h"
+#include "qlctrace.h"
 #include "function.h"
 #include "universe.h"
 #include "doc.h"
 
 #define MASTERTIMER_FREQUENCY "mastertimer/frequency"
+#define MASTERTIMER_MEDIA_PREROLL "mastertimer/mediapreroll"
 
 /** The timer tick frequency in Hertz */
 uint MasterTimer::s_frequency = 50;
 uint MasterTimer::s_tick = 20;
+uint MasterTimer::s_mediaPreroll = 500;
 
 //#define DEBUG_MASTERTIMER
 
@@ -70,6 +73,10 @@ MasterTimer::MasterTimer(Doc* doc)
     if (var.isValid() == true)
         s_frequency = var.toUInt();
 
+    var = settings.value(MASTERTIMER_MEDIA_PREROLL);
+    if (var.isValid() == true)
+        s_mediaPreroll = var.toUInt();
+
     s_tick = uint(double(1000) / double(s_frequency));
 }
 
@@ -97,6 +104,8 @@ void MasterTimer::stop()
 
 void MasterTimer::timerTick()
 {
+    QLC_TRACE_SCOPE("MasterTimer::timerTick");
+
     Doc* doc = qobject_cast<Doc*> (parent());
     Q_ASSERT(doc != NULL);
 
@@ -107,10 +116,16 @@ void MasterTimer::timerTick()
     doc->inputOutputMap()->flushInputs();
 
     QList<Universe *> universes = doc->inputOutputMap()->claimUniverses();
-    for (int i = 0 ; i < universes.count(); i++)
     {
-        universes[i]->zeroIntensityChannels();
-        universes[i]->zeroRelativeValues();
+        QLC_TRACE_SCOPE("MasterTimer::resetUniverses");
+        for (int i = 0 ; i < universes.count(); i++)
+        {
+            if (universes[i]->isIdle())
+                continue;
+
+            universes[i]->zeroIntensityChannels();
+            universes[i]->zeroRelativeValues();
+        }
     }
 
     timerTickFunctions(universes);
@@ -131,6 +146,11 @@ uint MasterTimer::tick()
     return s_tick;
 }
 
+uint MasterTimer::mediaPreroll()
+{
+    return s_mediaPreroll;
+}
+
 /*****************************************************************************
  * Functions
  *****************************************************************************/
@@ -220,8 +240,16 @@ int MasterTimer::runningFunctions() const
     return m_functionList.size();
 }
 
+QList<Function*> MasterTimer::runningFunctionList()
+{
+    QMutexLocker locker(&m_functionListMutex);
+    return m_functionList;
+}
+
 void MasterTimer::timerTickFunctions(QList<Universe *> universes)
 {
+    QLC_TRACE_SCOPE("MasterTimer::timerTickFunctions");
+
     // List of m_functionList indices that should be removed at the end of this
     // function. The functions at the indices have been stopped.
     QList<int> removeList;
@@ -245,7 +273,10 @@ void MasterTimer::timerTickFunctions(QList<Universe *> universes)
                 if (function->stopped() == false && m_stopAllFunctions == false)
                 {
                     if (firstIteration)
+                    {
+                        QLC_TRACE_SCOPE_ARG("Function::write", function->id());
                         function->write(this, universes);
+                    }
                 }
                 else
                 {
@@ -253,6 +284,7 @@ void MasterTimer::timerTickFunctions(QList<Universe *> universes)
                     if (m_stopAllFunctions)
                         function->stop(FunctionParent::master());
                     /* Function should be stopped instead */
+                    QLC_TRACE_SCOPE_ARG("Function::postRun", function->id());
                     function->postRun(this, universes);
                     //qDebug() << "[MasterTimer] Add function (ID: " << function->id() << ") to remove list ";
                     removeList << i; // Don't remove the item from the list just yet.
@@ -286,8 +318,10 @@ void MasterTimer::timerTickFunctions(QList<Universe *> universes)
 
         foreach (Function* f, startQueue)
         {
+            QLC_TRACE_SCOPE_ARG("Function::start", f->id());
             if (m_functionList.contains(f))
             {
+                QLC_TRACE_SCOPE_ARG("Function::postRun", f->id());
                 f->postRun(this, universes);
             }
             else
@@ -295,8 +329,14 @@ void MasterTimer::timerTickFunctions(QList<Universe *> universes)
                 m_functionList.append(f);
                 functionListHasChanged = true;
             }
-            f->preRun(this);
-            f->write(this, universes);
+            {
+                QLC_TRACE_SCOPE_ARG("Function::preRun", f->id());
+                f->preRun(this);
+            }
+            {
+                QLC_TRACE_SCOPE_ARG("Function::write", f->id());
+                f->write(this, universes);
+            }
             emit functionStarted(f->id());
         }
 
@@ -344,6 +384,8 @@ void MasterTimer::unregisterDMXSource(DMXSource* source)
 
 void MasterTimer::timerTickDMXSources(QList<Universe *> universes)
 {
+    QLC_TRACE_SCOPE("MasterTimer::timerTickDMXSources");
+
     /* Lock before accessing the DMX sources list. */
     QMutexLocker lock(&m_dmxSourceListMutex);
 
@@ -402,6 +444,8 @@ QMutex* MasterTimer::faderMutex() const
 
 void MasterTimer::timerTickFader(QList<Universe *> universes)
 {
+    QLC_TRACE_SCOPE("MasterTimer::timerTickFader");
+
     QMutexLocker faderLocker(&m_faderMutex);
 
 #ifdef DEBUG_MASTERTIMER
@@ -72,6 +72,10 @@ public:
     /** Get the length of one timer tick in milliseconds */
     static uint tick();
 
+    /** Get how many milliseconds in advance runners preload the
+     *  Functions they are about to start (see Function::preload()) */
+    static uint mediaPreroll();
+
 private:
     /** Execute one timer tick (called by MasterTimerPrivate) */
     void timerTick();
@@ -83,6 +87,9 @@ private:
     /** Duration in milliseconds of a single tick */
     static uint s_tick;
 
+    /** Preload time in milliseconds */
+    static uint s_mediaPreroll;
+
     /*********************************************************************
      * Functions
      *********************************************************************/
@@ -100,6 +107,10 @@ public:
     /** Get the number of currently running functions */
     int runningFunctions() const;
 
+    /** Get the list of currently running functions. The list changes
+     *  only while the universes are claimed by the timer thread */
+    QList<Function*> runningFunctionList();
+
 signals:
     /** Tells that the list of running functions has changed */
     void functionListChanged();
@@ -24,11 +24,23 @@
 #   include <unistd.h>
 #endif
 
+#include <QMutexLocker>
+#include <QMutex>
+#include <QHash>
+
 #include "qlcioplugin.h"
 #include "outputpatch.h"
+#include "qlctrace.h"
 
 #define GRACE_MS 1
 
+namespace
+{
+    /** Plugins don't expect writeUniverse() to be called concurrently */
+    QMutex s_writeMutexesLock;
+    QHash<QLCIOPlugin*, QMutex*> s_writeMutexes;
+}
+
 /*****************************************************************************
  * Initialization
  *****************************************************************************/
@@ -38,6 +50,7 @@ OutputPatch::OutputPatch(QObject* parent)
     , m_plugin(NULL)
     , m_pluginLine(QLCIOPlugin::invalidLine())
     , m_universe(UINT_MAX)
+    , m_writeMutex(NULL)
 {
 }
 
@@ -46,6 +59,7 @@ OutputPatch::OutputPatch(quint32 universe, QObject* parent)
     , m_plugin(NULL)
     , m_pluginLine(QLCIOPlugin::invalidLine())
     , m_universe(universe)
+    , m_writeMutex(NULL)
 {
 }
 
@@ -66,6 +80,7 @@ bool OutputPatch::set(QLCIOPlugin* plugin, quint32 output)
 
     m_plugin = plugin;
     m_pluginLine = output;
+    m_writeMutex = plugin != NULL ? pluginWriteMutex(plugin) : NULL;
 
     if (m_plugin != NULL)
     {
@@ -95,6 +110,18 @@ bool OutputPatch::reconnect()
     return false;
 }
 
+QMutex *OutputPatch::pluginWriteMutex(QLCIOPlugin *plugin)
+{
+    QMutexLocker locker(&s_writeMutexesLock);
+
+    // plugins live as long as the application, and so do their mutexes
+    QMutex*& mutex = s_writeMutexes[plugin];
+    if (mutex == NULL)
+        mutex = new QMutex();
+
+    return mutex;
+}
+
 QString OutputPatch::pluginName() const
 {
     if (m_plugin != NULL)
@@ -156,5 +183,9 @@ void OutputPatch::dump(quint32 universe, const QByteArray& data)
 {
     /* Don't do anything if there is no plugin and/or output line. */
     if (m_plugin != NULL && m_pluginLine != QLCIOPlugin::invalidLine())
+    {
+        QLC_TRACE_SCOPE_ARG("QLCIOPlugin::writeUniverse", universe);
+        QMutexLocker locker(m_writeMutex);
         m_plugin->writeUniverse(universe, m_pluginLine, data);
+    }
 }
@@ -24,6 +24,7 @@
 #include <QMap>
 
 class QLCIOPlugin;
+class QMutex;
 
 /** @addtogroup engine Engine
  * @{
@@ -99,13 +100,20 @@ private:
     quint32 m_pluginLine;
     /** The universe that this Output patch is attached to */
     quint32 m_universe;
+    /** Serializes the writes to the plugin, shared by all its patches */
+    QMutex* m_writeMutex;
+
+    /** Return the mutex serializing the writes to $plugin */
+    static QMutex* pluginWriteMutex(QLCIOPlugin* plugin);
 
     /********************************************************************
      * Value dump
      ********************************************************************/
 public:
     /** Write the contents of a 512 channel value buffer to the plugin.
-      * Called periodically by OutputMap. No need to call manually. */
+      * Called periodically by OutputMap. No need to call manually.
+      * Universes in passthrough bypass mode call this from their input
+      * thread too, so the writes to the same plugin are serialized. */
     void dump(quint32 universe, const QByteArray &data);
 };
 
@@ -25,6 +25,7 @@
 #include <QFile>
 
 #include "qlccapability.h"
+#include "qlcstringpool.h"
 #include "qlcmacros.h"
 #include "qlcconfig.h"
 #include "qlcfile.h"
@@ -40,8 +41,8 @@ QLCCapability::QLCCapability(uchar min, uchar max, const QString& name,
 {
     m_min = min;
     m_max = max;
-    m_name = name;
-    m_resourceName = resource;
+    m_name = QLCStringPool::intern(name);
+    m_resourceName = QLCStringPool::intern(resource);
     m_resourceColor1 = color1;
     m_resourceColor2 = color2;
 }
@@ -116,7 +117,7 @@ QString QLCCapability::name() const
 
 void QLCCapability::setName(const QString& name)
 {
-    m_name = name;
+    m_name = QLCStringPool::intern(name);
 }
 
 QString QLCCapability::resourceName()
@@ -126,7 +127,7 @@ QString QLCCapability::resourceName()
 
 void QLCCapability::setResourceName(const QString& name)
 {
-    m_resourceName = name;
+    m_resourceName = QLCStringPool::intern(name);
     // invalidate any previous color set
     m_resourceColor1 = QColor();
     m_resourceColor2 = QColor();
@@ -22,10 +22,12 @@
 #include <QStringList>
 #include <QPainter>
 #include <iostream>
+#include <cstring>
 #include <QString>
 #include <QDebug>
 #include <QFile>
 
+#include "qlcstringpool.h"
 #include "qlcchannel.h"
 #include "qlccapability.h"
 
@@ -55,6 +57,7 @@
 #define KXMLQLCChannelColourLime       QString("Lime")
 
 QLCChannel::QLCChannel()
+    : m_capabilityTable(NULL)
 {
     m_group = Intensity;
     m_controlByte = MSB;
@@ -62,6 +65,7 @@ QLCChannel::QLCChannel()
 }
 
 QLCChannel::QLCChannel(const QLCChannel* channel)
+    : m_capabilityTable(NULL)
 {
     m_group = Intensity;
     m_controlByte = MSB;
@@ -73,6 +77,8 @@ QLCChannel::QLCChannel(const QLCChannel* channel)
 
 QLCChannel::~QLCChannel()
 {
+    invalidateCapabilityTable();
+
     while (m_capabilities.isEmpty() == false)
         delete m_capabilities.takeFirst();
 }
@@ -95,6 +101,8 @@ QLCChannel& QLCChannel::operator=(const QLCChannel& channel)
         /* Copy new capabilities from the other channel */
         while (it.hasNext() == true)
             m_capabilities.append(it.next()->createCopy());
+
+        invalidateCapabilityTable();
     }
 
     return *this;
@@ -324,7 +332,7 @@ QString QLCChannel::name() const
 
 void QLCChannel::setName(const QString &name)
 {
-    m_name = name;
+    m_name = QLCStringPool::intern(name);
 }
 
 void QLCChannel::setControlByte(ControlByte byte)
@@ -435,15 +443,39 @@ const QList <QLCCapability*> QLCChannel::capabilities() const
 
 QLCCapability* QLCChannel::searchCapability(uchar value) const
 {
-    QListIterator <QLCCapability*> it(m_capabilities);
-    while (it.hasNext() == true)
+    return capabilityTable()->capability[value];
+}
+
+const QLCChannel::CapabilityTable* QLCChannel::capabilityTable() const
+{
+    CapabilityTable* table = m_capabilityTable.fetchAndAddAcquire(0);
+    if (table != NULL)
+        return table;
+
+    table = new CapabilityTable;
+    memset(table->capability, 0, sizeof(table->capability));
+
+    /* Capabilities don't overlap, but the first one wins as in a scan */
+    for (int i = m_capabilities.count() - 1; i >= 0; i--)
     {
-        QLCCapability* capability = it.next();
-        if (capability->min() <= value && capability->max() >= value)
-            return capability;
+        QLCCapability* capability = m_capabilities.at(i);
+        for (int value = capability->min(); value <= capability->max(); value++)
+            table->capability[value] = capability;
     }
 
-    return NULL;
+    // another thread might have built it meanwhile
+    if (m_capabilityTable.testAndSetOrdered(NULL, table) == false)
+    {
+        delete table;
+        table = m_capabilityTable.fetchAndAddAcquire(0);
+    }
+
+    return table;
+}
+
+void QLCChannel::invalidateCapabilityTable()
+{
+    delete m_capabilityTable.fetchAndStoreOrdered(NULL);
 }
 
 QLCCapability* QLCChannel::searchCapability(const QString& name,
@@ -475,6 +507,7 @@ bool QLCChannel::addCapability(QLCCapability* cap)
     }
 
     m_capabilities.append(cap);
+    invalidateCapabilityTable();
     return true;
 }
 
@@ -501,6 +534,7 @@ bool QLCChannel::setCapabilityRange(QLCCapability* cap, uchar min, uchar max)
         }
     }
 
+    invalidateCapabilityTable();
     return true;
 }
 
@@ -515,6 +549,7 @@ bool QLCChannel::removeCapability(QLCCapability* cap)
         {
             it.remove();
             delete cap;
+            invalidateCapabilityTable();
             return true;
         }
     }
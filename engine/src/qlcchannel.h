@@ -21,6 +21,7 @@
 #ifndef QLCCHANNEL_H
 #define QLCCHANNEL_H
 
+#include <QAtomicPointer>
 #include <climits>
 #include <QString>
 #include <QList>
@@ -211,7 +212,16 @@ public:
     /** Get a list of channel's capabilities */
     const QList <QLCCapability*> capabilities() const;
 
-    /** Search for a particular capability by its channel value */
+    /**
+     * Search for a particular capability by its channel value. The first
+     * search builds a table of the capability of each value, so the next
+     * ones don't scan the capability list. The table belongs to the channel,
+     * hence it is shared by all the fixtures using the same definition.
+     *
+     * Concurrent searches are safe, but the capabilities must not be
+     * changed while the channel is in use by other threads: editing frees
+     * the table and the removed capabilities.
+     */
     QLCCapability* searchCapability(uchar value) const;
 
     /**
@@ -244,6 +254,21 @@ protected:
     /** List of channel's capabilities */
     QList <QLCCapability*> m_capabilities;
 
+private:
+    /** The capability of each channel value, or NULL */
+    struct CapabilityTable
+    {
+        QLCCapability* capability[256];
+    };
+
+    /** Return the capability table, building it if needed. Thread safe */
+    const CapabilityTable* capabilityTable() const;
+
+    /** Free the capability table after the capabilities have changed. Not thread safe */
+    void invalidateCapabilityTable();
+
+    mutable QAtomicPointer<CapabilityTable> m_capabilityTable;
+
     /*********************************************************************
      * File operations
      *********************************************************************/
@@ -48,7 +48,7 @@ void QLCClipboard::copyContent(quint32 sourceID, QList<SceneValue> values)
 {
     Q_UNUSED(sourceID)
 
-    m_copySceneValues = values;
+    m_copySceneValues = ChannelValueStore::fromSceneValues(values);
 }
 
 void QLCClipboard::copyContent(quint32 sourceID, Function *function)
@@ -102,7 +102,7 @@ QList<ChaserStep> QLCClipboard::getChaserSteps()
 
 QList<SceneValue> QLCClipboard::getSceneValues()
 {
-    return m_copySceneValues;
+    return m_copySceneValues.toSceneValues();
 }
 
 Function *QLCClipboard::getFunction()
@@ -22,6 +22,7 @@
 
 #include <QList>
 
+#include "channelvaluestore.h"
 #include "chaserstep.h"
 #include "scenevalue.h"
 
@@ -65,7 +66,8 @@ public:
 
 private:
     QList <ChaserStep> m_copySteps;
-    QList <SceneValue> m_copySceneValues;
+    /** Scene values, sorted by fixture and channel */
+    ChannelValueStore m_copySceneValues;
     Function *m_copyFunction;
 };
 
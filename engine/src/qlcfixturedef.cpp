@@ -28,6 +28,7 @@
 #include "qlcfixturemode.h"
 #include "qlcfixturedef.h"
 #include "qlccapability.h"
+#include "qlcstringpool.h"
 #include "qlcchannel.h"
 #include "qlcfile.h"
 #include "fixture.h"
@@ -35,6 +36,7 @@
 QLCFixtureDef::QLCFixtureDef()
 {
     m_isLoaded = false;
+    m_refCount = 0;
     m_defFileAbsolutePath = QString();
     m_type = QString("Dimmer");
 }
@@ -42,6 +44,7 @@ QLCFixtureDef::QLCFixtureDef()
 QLCFixtureDef::QLCFixtureDef(const QLCFixtureDef* fixtureDef)
 {
     m_isLoaded = false;
+    m_refCount = 0;
     m_defFileAbsolutePath = QString();
     m_type = QString("Dimmer");
 
@@ -112,7 +115,7 @@ QString QLCFixtureDef::name() const
 
 void QLCFixtureDef::setManufacturer(const QString& mfg)
 {
-    m_manufacturer = mfg;
+    m_manufacturer = QLCStringPool::intern(mfg);
 }
 
 QString QLCFixtureDef::manufacturer() const
@@ -132,7 +135,7 @@ QString QLCFixtureDef::model() const
 
 void QLCFixtureDef::setType(const QString& type)
 {
-    m_type = type;
+    m_type = QLCStringPool::intern(type);
 }
 
 QString QLCFixtureDef::type()
@@ -143,7 +146,7 @@ QString QLCFixtureDef::type()
 
 void QLCFixtureDef::setAuthor(const QString& author)
 {
-    m_author = author;
+    m_author = QLCStringPool::intern(author);
 }
 
 QString QLCFixtureDef::author()
@@ -172,10 +175,52 @@ void QLCFixtureDef::checkLoaded()
     qDebug() << "Loading fixture definition now... " << m_defFileAbsolutePath;
     bool error = loadXML(m_defFileAbsolutePath);
     if (error == false)
-    {
         m_isLoaded = true;
-        m_defFileAbsolutePath = QString();
-    }
+}
+
+bool QLCFixtureDef::isLoaded() const
+{
+    return m_isLoaded;
+}
+
+bool QLCFixtureDef::unload()
+{
+    if (m_isLoaded == false || m_refCount > 0 || m_defFileAbsolutePath.isEmpty())
+        return false;
+
+    qDebug() << "Unloading fixture definition" << name();
+
+    while (m_modes.isEmpty() == false)
+        delete m_modes.takeFirst();
+
+    while (m_channels.isEmpty() == false)
+        delete m_channels.takeFirst();
+
+    m_type = QString("Dimmer");
+    m_author = QString();
+    m_isLoaded = false;
+
+    return true;
+}
+
+/****************************************************************************
+ * References
+ ****************************************************************************/
+
+void QLCFixtureDef::ref()
+{
+    m_refCount++;
+}
+
+void QLCFixtureDef::deref()
+{
+    Q_ASSERT(m_refCount > 0);
+    m_refCount--;
+}
+
+int QLCFixtureDef::refCount() const
+{
+    return m_refCount;
 }
 
 /****************************************************************************
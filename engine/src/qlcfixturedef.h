@@ -124,6 +124,18 @@ public:
     /** Check if the full definition has been loaded */
     void checkLoaded();
 
+    /** Return true if the channels and modes are loaded */
+    bool isLoaded() const;
+
+    /**
+     * Release the channels and modes of a definition loaded on demand from
+     * its source file, so that they are loaded again by checkLoaded() when
+     * needed. Definitions still referenced are not released.
+     *
+     * @return true if the definition has been released, otherwise false
+     */
+    bool unload();
+
 protected:
     bool m_isLoaded;
     QString m_defFileAbsolutePath;
@@ -132,6 +144,22 @@ protected:
     QString m_type;
     QString m_author;
 
+    /*********************************************************************
+     * References
+     *********************************************************************/
+public:
+    /** Tell that a fixture (or a browser) uses the definition */
+    void ref();
+
+    /** Tell that a fixture (or a browser) doesn't use the definition anymore */
+    void deref();
+
+    /** Return the number of users of the definition */
+    int refCount() const;
+
+private:
+    int m_refCount;
+
     /*********************************************************************
      * Channels
      *********************************************************************/
@@ -32,6 +32,7 @@
 #include "qlcfixturedefcache.h"
 #include "avolitesd4parser.h"
 #include "qlcfixturedef.h"
+#include "qlcstringpool.h"
 #include "qlcconfig.h"
 #include "qlcfile.h"
 
@@ -292,6 +293,26 @@ void QLCFixtureDefCache::clear()
         delete m_defs.takeFirst();
 }
 
+int QLCFixtureDefCache::releaseUnused()
+{
+    int count = 0;
+
+    foreach (QLCFixtureDef* def, m_defs)
+    {
+        if (def->unload() == true)
+            count++;
+    }
+
+    if (count > 0)
+    {
+        int strings = QLCStringPool::prune();
+        qDebug() << Q_FUNC_INFO << "Released" << count << "fixture definitions,"
+                 << strings << "strings left";
+    }
+
+    return count;
+}
+
 QDir QLCFixtureDefCache::systemDefinitionDirectory()
 {   
     return QLCFile::systemDirectory(QString(FIXTUREDIR), QString(KExtFixture));
@@ -311,6 +332,8 @@ void QLCFixtureDefCache::loadQXF(const QString& path)
     QLCFixtureDef* fxi = new QLCFixtureDef();
     Q_ASSERT(fxi != NULL);
 
+    // the source file allows to release the contents when unused
+    fxi->setDefinitionSourceFile(path);
     QFile::FileError error = fxi->loadXML(path);
     if (error == QFile::NoError)
     {
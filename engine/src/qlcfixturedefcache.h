@@ -129,6 +129,15 @@ public:
      */
     void clear();
 
+    /**
+     * Release the contents of the definitions loaded on demand that are not
+     * used by any fixture anymore (see QLCFixtureDef::unload()), for example
+     * after browsing the library. They are loaded again when requested.
+     *
+     * @return The number of released definitions
+     */
+    int releaseUnused();
+
     /**
      * Get the default system fixture definition directory that contains
      * installed fixture definitions. The location varies greatly between
@@ -27,6 +27,7 @@
 #include "qlcfixturemode.h"
 #include "qlcfixturehead.h"
 #include "qlcfixturedef.h"
+#include "qlcstringpool.h"
 #include "qlcchannel.h"
 #include "qlcphysical.h"
 
@@ -93,7 +94,7 @@ QLCFixtureMode& QLCFixtureMode::operator=(const QLCFixtureMode& mode)
 
 void QLCFixtureMode::setName(const QString &name)
 {
-    m_name = name;
+    m_name = QLCStringPool::intern(name);
 }
 
 QString QLCFixtureMode::name() const
@@ -0,0 +1,63 @@
+/*
+  Q Light Controller Plus
+  qlcstringpool.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QMutexLocker>
+
+#include "qlcstringpool.h"
+
+QMutex QLCStringPool::s_mutex;
+QSet<QString> QLCStringPool::s_strings;
+
+QString QLCStringPool::intern(const QString &str)
+{
+    if (str.isEmpty())
+        return str;
+
+    QMutexLocker locker(&s_mutex);
+
+    QSet<QString>::const_iterator it = s_strings.constFind(str);
+    if (it != s_strings.constEnd())
+        return *it;
+
+    s_strings.insert(str);
+    return str;
+}
+
+int QLCStringPool::prune()
+{
+    QMutexLocker locker(&s_mutex);
+
+    // a string referenced only by the pool is not used anymore
+    QSet<QString>::iterator it = s_strings.begin();
+    while (it != s_strings.end())
+    {
+        if (it->isDetached())
+            it = s_strings.erase(it);
+        else
+            ++it;
+    }
+
+    return s_strings.count();
+}
+
+int QLCStringPool::count()
+{
+    QMutexLocker locker(&s_mutex);
+    return s_strings.count();
+}
@@ -0,0 +1,59 @@
+/*
+  Q Light Controller Plus
+  qlcstringpool.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef QLCSTRINGPOOL_H
+#define QLCSTRINGPOOL_H
+
+#include <QString>
+#include <QMutex>
+#include <QSet>
+
+/** @addtogroup engine Engine
+ * @{
+ */
+
+/**
+ * QLCStringPool makes equal strings share the same data. Fixture definitions
+ * repeat the same manufacturers, channel names and capability names many
+ * times, so they intern them when they are loaded.
+ */
+class QLCStringPool
+{
+public:
+    /** Return a string equal to $str, sharing the data of the equal ones */
+    static QString intern(const QString& str);
+
+    /**
+     * Forget the strings that are not used anymore outside the pool.
+     *
+     * @return The number of strings left in the pool
+     */
+    static int prune();
+
+    /** Return the number of strings in the pool */
+    static int count();
+
+private:
+    static QMutex s_mutex;
+    static QSet<QString> s_strings;
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,256 @@
+/*
+  Q Light Controller Plus
+  qlctrace.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QThreadStorage>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+#include <QDebug>
+#include <QMutex>
+#include <QFile>
+#include <QList>
+
+#include "qlctrace.h"
+
+/** Number of events retained by each thread. Must be a power of 2 */
+#define TRACE_BUFFER_SIZE   (1 << 17)
+#define TRACE_BUFFER_MASK   (TRACE_BUFFER_SIZE - 1)
+
+QAtomicInt QLCTrace::s_recording(0);
+
+namespace
+{
+    struct TraceEvent
+    {
+        const char* name;
+        qint64 start;
+        qint64 duration;
+        qint64 arg;
+    };
+
+    /**
+     * A single producer ring buffer. Only the owner thread writes events,
+     * while the exporter reads them and discards the ones that might have
+     * been overwritten during the copy.
+     */
+    class TraceBuffer
+    {
+    public:
+        TraceBuffer(int id)
+            : m_id(id)
+            , m_head(0)
+        {
+            m_events.resize(TRACE_BUFFER_SIZE);
+        }
+
+        void append(const char* name, qint64 start, qint64 duration, qint64 arg)
+        {
+            quint32 index = quint32(head());
+            TraceEvent& ev = m_events[index & TRACE_BUFFER_MASK];
+            ev.name = name;
+            ev.start = start;
+            ev.duration = duration;
+            ev.arg = arg;
+            m_head.fetchAndStoreRelease(int(index + 1));
+        }
+
+        int head() const
+        {
+            return const_cast<QAtomicInt&>(m_head).fetchAndAddAcquire(0);
+        }
+
+        QList<TraceEvent> snapshot() const
+        {
+            QList<TraceEvent> list;
+            quint32 end = quint32(head());
+            quint32 begin = end - qMin(end, quint32(TRACE_BUFFER_SIZE));
+
+            for (quint32 i = begin; i != end; i++)
+                list.append(m_events.at(i & TRACE_BUFFER_MASK));
+
+            // events written in the meantime might have replaced the oldest ones
+            quint32 written = quint32(head()) - begin;
+            if (written > quint32(TRACE_BUFFER_SIZE))
+                list = list.mid(int(qMin(written - quint32(TRACE_BUFFER_SIZE), end - begin)));
+
+            return list;
+        }
+
+        /** Must not be called while recording */
+        void clear()
+        {
+            m_head.fetchAndStoreRelease(0);
+        }
+
+    public:
+        int m_id;
+        QString m_name;
+
+    private:
+        QVector<TraceEvent> m_events;
+        QAtomicInt m_head;
+    };
+
+    /** Buffers are owned by the registry, so they outlive their threads */
+    struct TraceBufferRef
+    {
+        TraceBufferRef() : buffer(NULL) { }
+        TraceBuffer* buffer;
+    };
+
+    QMutex s_registryMutex;
+    QList<TraceBuffer*> s_registry;
+    QThreadStorage<TraceBufferRef> s_threadBuffer;
+    QElapsedTimer s_epoch;
+
+    TraceBuffer* threadBuffer()
+    {
+        TraceBufferRef& ref = s_threadBuffer.localData();
+        if (ref.buffer == NULL)
+        {
+            QMutexLocker locker(&s_registryMutex);
+            ref.buffer = new TraceBuffer(s_registry.count() + 1);
+            QThread* thread = QThread::currentThread();
+            if (thread != NULL && thread->objectName().isEmpty() == false)
+                ref.buffer->m_name = thread->objectName();
+            else
+                ref.buffer->m_name = QString("Thread %1").arg(ref.buffer->m_id);
+            s_registry.append(ref.buffer);
+        }
+        return ref.buffer;
+    }
+
+    QString escapeJson(const QString& str)
+    {
+        QString escaped(str);
+        escaped.replace("\\", "\\\\");
+        escaped.replace("\"", "\\\"");
+        return escaped;
+    }
+}
+
+/****************************************************************************
+ * Recording
+ ****************************************************************************/
+
+void QLCTrace::start()
+{
+    {
+        QMutexLocker locker(&s_registryMutex);
+        // keep the same epoch across sessions, so that timestamps are comparable
+        if (s_epoch.isValid() == false)
+            s_epoch.start();
+    }
+
+    s_recording.fetchAndStoreOrdered(1);
+    qDebug() << "[QLCTrace] recording started";
+}
+
+void QLCTrace::stop()
+{
+    s_recording.fetchAndStoreOrdered(0);
+    qDebug() << "[QLCTrace] recording stopped";
+}
+
+void QLCTrace::clear()
+{
+    QMutexLocker locker(&s_registryMutex);
+    foreach (TraceBuffer* buffer, s_registry)
+        buffer->clear();
+}
+
+void QLCTrace::setThreadName(const QString &name)
+{
+    TraceBuffer* buffer = threadBuffer();
+    QMutexLocker locker(&s_registryMutex);
+    buffer->m_name = name;
+}
+
+qint64 QLCTrace::now()
+{
+    return s_epoch.nsecsElapsed();
+}
+
+void QLCTrace::record(const char *name, qint64 start, qint64 duration, qint64 arg)
+{
+    threadBuffer()->append(name, start, duration, arg);
+}
+
+void QLCTrace::recordElapsed(const char *name, qint64 elapsed, qint64 arg)
+{
+    if (isRecording() == false)
+        return;
+
+    qint64 end = now();
+    record(name, end - elapsed, elapsed, arg);
+}
+
+/****************************************************************************
+ * Export
+ ****************************************************************************/
+
+bool QLCTrace::exportChromeTrace(const QString &fileName)
+{
+    QFile file(fileName);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text) == false)
+    {
+        qWarning() << Q_FUNC_INFO << "Unable to open" << fileName << "for writing";
+        return false;
+    }
+
+    QTextStream stream(&file);
+    bool first = true;
+    int count = 0;
+
+    stream << "{\"traceEvents\":[\n";
+
+    QMutexLocker locker(&s_registryMutex);
+    foreach (TraceBuffer* buffer, s_registry)
+    {
+        if (first == false)
+            stream << ",\n";
+        first = false;
+
+        // thread name metadata
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->m_id
+               << ",\"args\":{\"name\":\"" << escapeJson(buffer->m_name) << "\"}}";
+
+        foreach (const TraceEvent& ev, buffer->snapshot())
+        {
+            // timestamps are in microseconds
+            stream << ",\n{\"name\":\"" << ev.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->m_id
+                   << ",\"ts\":" << QString::number(double(ev.start) / 1000.0, 'f', 3)
+                   << ",\"dur\":" << QString::number(double(ev.duration) / 1000.0, 'f', 3);
+            if (ev.arg >= 0)
+                stream << ",\"args\":{\"id\":" << ev.arg << "}";
+            stream << "}";
+            count++;
+        }
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    stream.flush();
+    file.close();
+
+    qDebug() << "[QLCTrace] exported" << count << "events to" << fileName;
+
+    return true;
+}
@@ -0,0 +1,144 @@
+/*
+  Q Light Controller Plus
+  qlctrace.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef QLCTRACE_H
+#define QLCTRACE_H
+
+#include <QAtomicInt>
+#include <QString>
+
+/** @addtogroup engine Engine
+ * @{
+ */
+
+/**
+ * QLCTrace records the duration of the engine hot paths (MasterTimer tick
+ * phases, Functions, faders, output dispatch...) to find out what stalled
+ * during a live show.
+ *
+ * Trace points are declared with the QLC_TRACE_SCOPE macros and are compiled
+ * in only when QLC_TRACING is defined, that is when building with
+ * "qmake CONFIG+=qlctrace" (see variables.pri). When compiled in but not
+ * recording, a trace point costs a single atomic read.
+ *
+ * Each thread records its events into its own ring buffer, so recording never
+ * takes a lock. When a buffer is full, the oldest events are overwritten, so
+ * the last seconds before an export are always available.
+ *
+ * Recorded events can be exported in the Chrome trace JSON format, which can
+ * be opened with chrome://tracing or https://ui.perfetto.dev
+ */
+class QLCTrace
+{
+public:
+    /** Start recording trace events */
+    static void start();
+
+    /** Stop recording trace events. Recorded events are retained. */
+    static void stop();
+
+    /** Returns true if trace events are being recorded */
+    static inline bool isRecording()
+    {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+        return s_recording.load() != 0;
+#else
+        return s_recording != 0;
+#endif
+    }
+
+    /** Discard all the recorded events */
+    static void clear();
+
+    /** Set the name of the calling thread, as it will appear in the trace */
+    static void setThreadName(const QString& name);
+
+    /**
+     * Write all the recorded events to $fileName in Chrome trace JSON format.
+     * This can be safely called while recording.
+     *
+     * @return true on success, otherwise false
+     */
+    static bool exportChromeTrace(const QString& fileName);
+
+    /**
+     * Record an event ending now and lasting $elapsed nanoseconds.
+     * This is used for intervals spanning across threads, like the
+     * latency between a control movement and the DMX output.
+     */
+    static void recordElapsed(const char* name, qint64 elapsed, qint64 arg = -1);
+
+    /**
+     * Helper class recording the time elapsed between its
+     * construction and its destruction as a trace event
+     */
+    class Scope
+    {
+    public:
+        /**
+         * @param name A static string naming the event
+         * @param arg An optional numeric argument (e.g. a Function ID)
+         */
+        inline Scope(const char* name, qint64 arg = -1)
+            : m_name(name)
+            , m_arg(arg)
+            , m_start(isRecording() ? now() : -1)
+        {
+        }
+
+        inline ~Scope()
+        {
+            if (m_start >= 0)
+                record(m_name, m_start, now() - m_start, m_arg);
+        }
+
+    private:
+        Q_DISABLE_COPY(Scope)
+
+        const char* m_name;
+        qint64 m_arg;
+        qint64 m_start;
+    };
+
+private:
+    /** Return the nanoseconds elapsed since the trace epoch */
+    static qint64 now();
+
+    /** Append an event to the calling thread's buffer */
+    static void record(const char* name, qint64 start, qint64 duration, qint64 arg);
+
+private:
+    static QAtomicInt s_recording;
+};
+
+#ifdef QLC_TRACING
+#  define QLC_TRACE_CAT_IMPL(a, b) a##b
+#  define QLC_TRACE_CAT(a, b) QLC_TRACE_CAT_IMPL(a, b)
+#  define QLC_TRACE_SCOPE(name) \
+       QLCTrace::Scope QLC_TRACE_CAT(qlcTraceScope, __LINE__)(name)
+#  define QLC_TRACE_SCOPE_ARG(name, arg) \
+       QLCTrace::Scope QLC_TRACE_CAT(qlcTraceScope, __LINE__)(name, qint64(arg))
+#else
+#  define QLC_TRACE_SCOPE(name)
+#  define QLC_TRACE_SCOPE_ARG(name, arg)
+#endif
+
+/** @} */
+
+#endif
@@ -34,9 +34,13 @@
 #define KXMLQLCRGBImageOffsetX        "X"
 #define KXMLQLCRGBImageOffsetY        "Y"
 
+/** Maximum number of pixels kept in the frame cache (4 bytes each) */
+#define FRAME_CACHE_MAX_PIXELS  (4 * 1024 * 1024)
+
 RGBImage::RGBImage(Doc * doc)
     : RGBAlgorithm(doc)
     , m_filename("")
+    , m_framesPixels(0)
     , m_animationStyle(Static)
     , m_xOffset(0)
     , m_yOffset(0)
@@ -46,6 +50,7 @@ RGBImage::RGBImage(Doc * doc)
 RGBImage::RGBImage(const RGBImage& i)
     : RGBAlgorithm( i.doc())
     , m_filename(i.filename())
+    , m_framesPixels(0)
     , m_animationStyle(i.animationStyle())
     , m_xOffset(i.xOffset())
     , m_yOffset(i.yOffset())
@@ -98,7 +103,8 @@ void RGBImage::setImageData(int width, int height, const QByteArray &pixelData)
             i+=3;
         }
     }
-    m_image = newImg;
+    m_image = newImg.convertToFormat(QImage::Format_ARGB32);
+    invalidateFrames();
 }
 
 void RGBImage::reloadImage()
@@ -110,12 +116,75 @@ void RGBImage::reloadImage()
     }
 
     QMutexLocker locker(&m_mutex);
+    invalidateFrames();
 
     if (!m_image.load(m_filename))
     {
         qDebug() << "[RGBImage] Failed to load" << m_filename;
         return;
     }
+
+    // convert just once, so that frames are sampled without any conversion
+    if (m_image.format() != QImage::Format_ARGB32)
+        m_image = m_image.convertToFormat(QImage::Format_ARGB32);
+}
+
+/****************************************************************************
+ * Frame cache
+ ****************************************************************************/
+
+void RGBImage::invalidateFrames()
+{
+    m_frames.clear();
+    m_framesPixels = 0;
+}
+
+RGBMap RGBImage::renderFrame(const QSize& size, int step) const
+{
+    int xOffs = xOffset();
+    int yOffs = yOffset();
+
+    switch(animationStyle())
+    {
+    default:
+    case Static:
+        break;
+    case Horizontal:
+        xOffs += step;
+        break;
+    case Vertical:
+        yOffs += step;
+        break;
+    case Animation:
+        xOffs += step * size.width();
+        break;
+    }
+
+    RGBMap map(size.height());
+    for (int y = 0; y < size.height(); y++)
+    {
+        map[y].resize(size.width());
+        int y1 = (y + yOffs) % m_image.height();
+        if (y1 < 0)
+        {
+            // out of the image
+            map[y].fill(0);
+            continue;
+        }
+
+        const QRgb* line = reinterpret_cast<const QRgb*>(m_image.constScanLine(y1));
+        uint* row = map[y].data();
+        for (int x = 0; x < size.width(); x++)
+        {
+            int x1 = (x + xOffs) % m_image.width();
+            if (x1 < 0 || qAlpha(line[x1]) == 0)
+                row[x] = 0;
+            else
+                row[x] = line[x1];
+        }
+    }
+
+    return map;
 }
 
 /****************************************************************************
@@ -124,6 +193,9 @@ void RGBImage::reloadImage()
 
 void RGBImage::setAnimationStyle(RGBImage::AnimationStyle ani)
 {
+    QMutexLocker locker(&m_mutex);
+    invalidateFrames();
+
     if (ani >= Static && ani <= Animation)
         m_animationStyle = ani;
     else
@@ -175,7 +247,9 @@ QStringList RGBImage::animationStyles()
 
 void RGBImage::setXOffset(int offset)
 {
+    QMutexLocker locker(&m_mutex);
     m_xOffset = offset;
+    invalidateFrames();
 }
 
 int RGBImage::xOffset() const
@@ -185,7 +259,9 @@ int RGBImage::xOffset() const
 
 void RGBImage::setYOffset(int offset)
 {
+    QMutexLocker locker(&m_mutex);
     m_yOffset = offset;
+    invalidateFrames();
 }
 
 int RGBImage::yOffset() const
@@ -225,38 +301,24 @@ RGBMap RGBImage::rgbMap(const QSize& size, uint rgb, int step)
     if (m_image.width() == 0 || m_image.height() == 0)
         return RGBMap();
 
-    int xOffs = xOffset();
-    int yOffs = yOffset();
-
-    switch(animationStyle()) 
+    if (size != m_framesSize)
     {
-    default:
-    case Static:
-        break;
-    case Horizontal:
-        xOffs += step;
-        break;
-    case Vertical:
-        yOffs += step;
-        break;
-    case Animation:
-        xOffs += step * size.width();
-        break;
+        invalidateFrames();
+        m_framesSize = size;
     }
 
-    RGBMap map(size.height());
-    for (int y = 0; y < size.height(); y++)
-    {
-        map[y].resize(size.width());
-        for (int x = 0; x < size.width(); x++)
-        {
-            int x1 = (x + xOffs) % m_image.width();
-            int y1 = (y + yOffs) % m_image.height();
+    if (step >= 0 && step < m_frames.size() && m_frames.at(step).isEmpty() == false)
+        return m_frames.at(step);
 
-            map[y][x] = m_image.pixel(x1,y1);
-            if (qAlpha(map[y][x]) == 0)
-                map[y][x] = 0;
-        }
+    RGBMap map = renderFrame(size, step);
+
+    int pixels = size.width() * size.height();
+    if (step >= 0 && m_framesPixels + pixels <= FRAME_CACHE_MAX_PIXELS)
+    {
+        if (step >= m_frames.size())
+            m_frames.resize(step + 1);
+        m_frames[step] = map;
+        m_framesPixels += pixels;
     }
 
     return map;
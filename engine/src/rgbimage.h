@@ -24,7 +24,9 @@
 
 #include <QMutexLocker>
 #include <QString>
+#include <QVector>
 #include <QImage>
+#include <QSize>
 
 #include "rgbalgorithm.h"
 
@@ -63,9 +65,30 @@ private:
 
 private:
     QString m_filename;
+    /** The decoded image, always in QImage::Format_ARGB32 */
     QImage m_image;
     QMutex m_mutex;
 
+    /************************************************************************
+     * Frame cache
+     ************************************************************************/
+private:
+    /** Drop the cached frames. Must be called with m_mutex locked */
+    void invalidateFrames();
+
+    /** Sample the image for the given step. Must be called with m_mutex locked */
+    RGBMap renderFrame(const QSize& size, int step) const;
+
+private:
+    /** The maps of the steps rendered so far, sampled for m_framesSize.
+     *  Frames are rendered on first use, so long animations don't cost
+     *  anything upfront, and are kept until the image, the matrix size,
+     *  the animation style or the offsets change */
+    QVector<RGBMap> m_frames;
+    QSize m_framesSize;
+    /** The number of cached pixels, to cap the cache memory */
+    int m_framesPixels;
+
     /************************************************************************
      * Animation
      ************************************************************************/
@@ -21,6 +21,10 @@
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include <QCoreApplication>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QRunnable>
+#include <QThread>
 #include <QDebug>
 #include <QTime>
 #include <cmath>
@@ -45,6 +49,9 @@
 #define KXMLQLCRGBMatrixPropertyName "Name"
 #define KXMLQLCRGBMatrixPropertyValue "Value"
 
+/** Minimum number of pixels of a map tile. Smaller maps are not split */
+#define MAP_TILE_MIN_PIXELS 1024
+
 /****************************************************************************
  * Initialization
  ****************************************************************************/
@@ -334,6 +341,12 @@ QString RGBMatrix::property(QString propName)
     return m_properties[propName];
 }
 
+QHash<QString, QString> RGBMatrix::properties()
+{
+    QMutexLocker algoLocker(&m_algorithmMutex);
+    return m_properties;
+}
+
 /****************************************************************************
  * Load & Save
  ****************************************************************************/
@@ -567,6 +580,9 @@ void RGBMatrix::write(MasterTimer* timer, QList<Universe *> universes)
                 qDebug() << "RGBMatrix stepColor:" << QString::number(m_stepColor.rgb(), 16);
                 RGBMap map = m_algorithm->rgbMap(m_group->size(), m_stepColor.rgb(), m_step);
                 updateMapChannels(map, m_group);
+
+                QMutexLocker mapLocker(&m_runningMapMutex);
+                m_runningMap = map;
             }
         }
     }
@@ -633,9 +649,24 @@ void RGBMatrix::postRun(MasterTimer* timer, QList<Universe *> universes)
             m_algorithm->postRun();
     }
 
+    {
+        QMutexLocker mapLocker(&m_runningMapMutex);
+        m_runningMap.clear();
+    }
+
     Function::postRun(timer, universes);
 }
 
+bool RGBMatrix::runningMap(RGBMap &map)
+{
+    QMutexLocker mapLocker(&m_runningMapMutex);
+    if (m_runningMap.isEmpty())
+        return false;
+
+    map = m_runningMap;
+    return true;
+}
+
 void RGBMatrix::roundCheck(const QSize& size)
 {
     QMutexLocker algorithmLocker(&m_algorithmMutex);
@@ -727,19 +758,203 @@ void RGBMatrix::roundCheck(const QSize& size)
     roundElapsed(duration());
 }
 
-void RGBMatrix::updateMapChannels(const RGBMap& map, const FixtureGroup* grp)
+struct RGBMatrix::MapTile
 {
-    quint32 mdAssigned = QLCChannel::invalid();
-    quint32 mdFxi = Fixture::invalidId();
+    /** A pixel mapped to a fixture head */
+    struct Pixel
+    {
+        quint32 fxi;
+        /** Index past the last entry of the pixel in channels */
+        int channelsEnd;
+        /** The head master dimmer, if controlled by the matrix */
+        quint32 dimmer;
+        bool black;
+    };
+
+    int firstRow;
+    int rowCount;
+    /** If not NULL, channels are added here instead of being staged */
+    GenericFader* fader;
+    QVector <FadeChannel> channels;
+    QVector <Pixel> pixels;
+
+    void add(const FadeChannel& fc)
+    {
+        if (fader != NULL)
+            fader->add(fc);
+        else
+            channels.append(fc);
+    }
+};
 
+class RGBMatrix::MapTileTask : public QRunnable
+{
+public:
+    MapTileTask(const RGBMatrix* matrix, const RGBMap& map, const FixtureGroup* grp,
+                uint fadeTime, MapTile& tile, QSemaphore& done)
+        : m_matrix(matrix)
+        , m_map(map)
+        , m_group(grp)
+        , m_fadeTime(fadeTime)
+        , m_tile(tile)
+        , m_done(done)
+    {
+        setAutoDelete(false);
+    }
+
+    void run()
+    {
+        m_matrix->mapTileChannels(m_map, m_group, m_fadeTime, m_tile);
+        m_done.release();
+    }
+
+private:
+    const RGBMatrix* m_matrix;
+    const RGBMap& m_map;
+    const FixtureGroup* m_group;
+    uint m_fadeTime;
+    MapTile& m_tile;
+    QSemaphore& m_done;
+};
+
+namespace
+{
+    class MapTilePool : public QThreadPool
+    {
+    public:
+        MapTilePool()
+        {
+            // the calling thread computes a tile too
+            setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+        }
+    };
+}
+
+Q_GLOBAL_STATIC(MapTilePool, s_mapTilePool)
+
+QThreadPool* RGBMatrix::mapTilePool()
+{
+    return s_mapTilePool();
+}
+
+int RGBMatrix::mapTileCount(const RGBMap& map)
+{
+    int rows = map.size();
+    int pixels = rows > 0 ? rows * map[0].size() : 0;
+    int tileCount = qMin(mapTilePool()->maxThreadCount() + 1, pixels / MAP_TILE_MIN_PIXELS);
+
+    return qBound(1, tileCount, qMax(1, rows));
+}
+
+void RGBMatrix::updateMapChannels(const RGBMap& map, const FixtureGroup* grp)
+{
     uint fadeTime = 0;
     if (overrideFadeInSpeed() == defaultSpeed())
         fadeTime = fadeInSpeed();
     else
         fadeTime = overrideFadeInSpeed();
 
-    // Create/modify fade channels for ALL pixels in the color map.
-    for (int y = 0; y < map.size(); y++)
+    int rows = map.size();
+
+    /* Large maps are split in tiles of rows computed in parallel: the
+     * calling thread computes the first tile, the tile pool the others */
+    int tileCount = mapTileCount(map);
+
+    QVector <MapTile> tiles(tileCount);
+    for (int i = 0, row = 0; i < tileCount; i++)
+    {
+        tiles[i].firstRow = row;
+        tiles[i].rowCount = (rows - row) / (tileCount - i);
+        tiles[i].fader = NULL;
+        row += tiles[i].rowCount;
+    }
+
+    if (tileCount == 1)
+    {
+        // nothing to join: write straight to the fader
+        tiles[0].fader = m_fader;
+        mapTileChannels(map, grp, fadeTime, tiles[0]);
+        return;
+    }
+
+    QSemaphore done;
+    QList <MapTileTask*> tasks;
+    for (int i = 1; i < tileCount; i++)
+    {
+        MapTileTask* task = new MapTileTask(this, map, grp, fadeTime, tiles[i], done);
+        // don't wait for a busy pool (e.g. another matrix is computing)
+        if (mapTilePool()->tryStart(task) == false)
+            task->run();
+        tasks.append(task);
+    }
+
+    mapTileChannels(map, grp, fadeTime, tiles[0]);
+
+    done.acquire(tasks.count());
+    qDeleteAll(tasks);
+
+    /* Join the tiles in row order, so the result is the same of a serial
+     * scan of the map. Master dimmers depend on the previous pixels of the
+     * same fixture, so they are resolved here. */
+    quint32 mdAssigned = QLCChannel::invalid();
+    quint32 mdFxi = Fixture::invalidId();
+
+    foreach (const MapTile& tile, tiles)
+    {
+        int ch = 0;
+        foreach (const MapTile::Pixel& pixel, tile.pixels)
+        {
+            for (; ch < pixel.channelsEnd; ch++)
+                m_fader->add(tile.channels.at(ch));
+
+            addPixelDimmer(m_fader, pixel.fxi, pixel.dimmer, pixel.black,
+                           fadeTime, mdAssigned, mdFxi);
+        }
+    }
+}
+
+void RGBMatrix::addPixelDimmer(GenericFader* fader, quint32 fxi, quint32 dimmer, bool black,
+                               uint fadeTime, quint32& mdAssigned, quint32& mdFxi) const
+{
+    if (fxi != mdFxi)
+    {
+        mdAssigned = QLCChannel::invalid();
+        mdFxi = fxi;
+    }
+
+    if (dimmer == QLCChannel::invalid())
+        return;
+
+    // Simple intensity (dimmer) channel
+    FadeChannel fc(doc(), fxi, dimmer);
+    if (black && mdAssigned != dimmer)
+        fc.setTarget(0);
+    else
+    {
+        fc.setTarget(255);
+        if (mdAssigned == QLCChannel::invalid())
+            mdAssigned = dimmer;
+    }
+    insertStartValues(fc, fadeTime);
+    fader->add(fc);
+}
+
+void RGBMatrix::mapTileChannels(const RGBMap& map, const FixtureGroup* grp,
+                                uint fadeTime, MapTile& tile) const
+{
+    // master dimmers of a tile written straight to the fader
+    quint32 mdAssigned = QLCChannel::invalid();
+    quint32 mdFxi = Fixture::invalidId();
+
+    if (tile.fader == NULL && tile.rowCount > 0)
+    {
+        int pixels = tile.rowCount * map[tile.firstRow].size();
+        tile.channels.reserve(pixels * 3);
+        tile.pixels.reserve(pixels);
+    }
+
+    // Create/modify fade channels for ALL pixels in the tile rows.
+    for (int y = tile.firstRow; y < tile.firstRow + tile.rowCount; y++)
     {
         for (int x = 0; x < map[y].size(); x++)
         {
@@ -749,12 +964,6 @@ void RGBMatrix::updateMapChannels(const RGBMap& map, const FixtureGroup* grp)
             if (fxi == NULL)
                 continue;
 
-            if (grpHead.fxi != mdFxi)
-            {
-                mdAssigned = QLCChannel::invalid();
-                mdFxi = grpHead.fxi;
-            }
-
             QLCFixtureHead head = fxi->head(grpHead.head);
 
             QVector <quint32> rgb = head.rgbChannels();
@@ -766,21 +975,21 @@ void RGBMatrix::updateMapChannels(const RGBMap& map, const FixtureGroup* grp)
                     FadeChannel fc(doc(), grpHead.fxi, rgb.at(0));
                     fc.setTarget(qRed(map[y][x]));
                     insertStartValues(fc, fadeTime);
-                    m_fader->add(fc);
+                    tile.add(fc);
                 }
 
                 {
                     FadeChannel fc(doc(), grpHead.fxi, rgb.at(1));
                     fc.setTarget(qGreen(map[y][x]));
                     insertStartValues(fc, fadeTime);
-                    m_fader->add(fc);
+                    tile.add(fc);
                 }
 
                 {
                     FadeChannel fc(doc(), grpHead.fxi, rgb.at(2));
                     fc.setTarget(qBlue(map[y][x]));
                     insertStartValues(fc, fadeTime);
-                    m_fader->add(fc);
+                    tile.add(fc);
                 }
             }
             else if (cmy.size() == 3)
@@ -792,42 +1001,42 @@ void RGBMatrix::updateMapChannels(const RGBMap& map, const FixtureGroup* grp)
                     FadeChannel fc(doc(), grpHead.fxi, cmy.at(0));
                     fc.setTarget(col.cyan());
                     insertStartValues(fc, fadeTime);
-                    m_fader->add(fc);
+                    tile.add(fc);
                 }
 
                 {
                     FadeChannel fc(doc(), grpHead.fxi, cmy.at(1));
                     fc.setTarget(col.magenta());
                     insertStartValues(fc, fadeTime);
-                    m_fader->add(fc);
+                    tile.add(fc);
                 }
 
                 {
                     FadeChannel fc(doc(), grpHead.fxi, cmy.at(2));
                     fc.setTarget(col.yellow());
                     insertStartValues(fc, fadeTime);
-                    m_fader->add(fc);
+                    tile.add(fc);
                 }
             }
 
+            MapTile::Pixel pixel;
+            pixel.fxi = grpHead.fxi;
+            pixel.channelsEnd = tile.channels.count();
+            pixel.dimmer = QLCChannel::invalid();
+            pixel.black = false;
+
             if (m_dimmerControl &&
                 head.masterIntensityChannel() != QLCChannel::invalid())
             {
-                //qDebug() << "RGBMatrix: found dimmer at" << head.masterIntensityChannel();
-                // Simple intensity (dimmer) channel
-                QColor col(map[y][x]);
-                FadeChannel fc(doc(), grpHead.fxi, head.masterIntensityChannel());
-                if (col.value() == 0 && mdAssigned != head.masterIntensityChannel())
-                    fc.setTarget(0);
-                else
-                {
-                    fc.setTarget(255);
-                    if (mdAssigned == QLCChannel::invalid())
-                        mdAssigned = head.masterIntensityChannel();
-                }
-                insertStartValues(fc, fadeTime);
-                m_fader->add(fc);
+                pixel.dimmer = head.masterIntensityChannel();
+                pixel.black = (QColor(map[y][x]).value() == 0);
             }
+
+            if (tile.fader != NULL)
+                addPixelDimmer(tile.fader, pixel.fxi, pixel.dimmer, pixel.black,
+                               fadeTime, mdAssigned, mdFxi);
+            else
+                tile.pixels.append(pixel);
         }
     }
 }
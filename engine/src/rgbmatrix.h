@@ -40,6 +40,7 @@
 class FixtureGroup;
 class GenericFader;
 class FadeChannel;
+class QThreadPool;
 class QTime;
 class QDir;
 
@@ -152,6 +153,9 @@ public:
     /** Retrieve the value of the property with the given name */
     QString property(QString propName);
 
+    /** Return a copy of all the properties */
+    QHash<QString, QString> properties();
+
 private:
     /** A map of the custom properties for this matrix */
     QHash<QString, QString>m_properties;
@@ -182,6 +186,14 @@ public:
     /** @reimpl */
     void postRun(MasterTimer* timer, QList<Universe*> universes);
 
+    /**
+     * Get the map of the step being output, to preview it without
+     * running the algorithm again.
+     *
+     * @return true if the matrix is running and a map is available
+     */
+    bool runningMap(RGBMap& map);
+
 private:
     /** Check what should be done when elapsed() >= duration() */
     void roundCheck(const QSize& size);
@@ -189,6 +201,37 @@ private:
     /** Update new FadeChannels to m_fader when $map has changed since last time */
     void updateMapChannels(const RGBMap& map, const FixtureGroup* grp);
 
+    /** The FadeChannels computed for a range of rows of a map */
+    struct MapTile;
+
+    /** Runs mapTileChannels() on a worker thread */
+    class MapTileTask;
+
+    /**
+     * The threads computing map tiles. This is not the global thread pool,
+     * so that tiles never wait behind unrelated tasks (e.g. FunctionLoader)
+     * while the MasterTimer is writing.
+     */
+    static QThreadPool* mapTilePool();
+
+    /** Return the number of tiles $map is split in by updateMapChannels() */
+    static int mapTileCount(const RGBMap& map);
+
+    /**
+     * Compute the FadeChannels of the rows of $map covered by $tile.
+     * This doesn't change m_fader, so tiles can be computed in parallel.
+     */
+    void mapTileChannels(const RGBMap& map, const FixtureGroup* grp,
+                         uint fadeTime, MapTile& tile) const;
+
+    /**
+     * Add to $fader the master $dimmer of a pixel of fixture $fxi, if valid.
+     * Only the first lit pixel of a fixture turns its dimmer on, so
+     * $mdAssigned and $mdFxi carry the state from one pixel to the next.
+     */
+    void addPixelDimmer(GenericFader* fader, quint32 fxi, quint32 dimmer, bool black,
+                        uint fadeTime, quint32& mdAssigned, quint32& mdFxi) const;
+
     /** Grab starting values for a fade channel from $fader if available */
     void insertStartValues(FadeChannel& fc, uint fadeTime) const;
 
@@ -202,6 +245,10 @@ private:
     int m_crDelta, m_cgDelta, m_cbDelta;
     int m_stepCount;
 
+    /** The map of the current step, for the previews */
+    RGBMap m_runningMap;
+    QMutex m_runningMapMutex;
+
     /*********************************************************************
      * Attributes
      *********************************************************************/
@@ -0,0 +1,242 @@
+/*
+  Q Light Controller Plus
+  rgbmatrixpreview.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QMutexLocker>
+#include <QDebug>
+
+#include "rgbmatrixpreview.h"
+#include "fixturegroup.h"
+#include "rgbmatrix.h"
+#include "doc.h"
+
+/** Number of frames rendered ahead */
+#define PREVIEW_QUEUE_SIZE  4
+
+RGBMatrixPreview::RGBMatrixPreview(QObject *parent)
+    : QThread(parent)
+    , m_matrix(NULL)
+    , m_generation(0)
+    , m_exit(false)
+    , m_rendering(false)
+    , m_busy(false)
+    , m_synchronous(false)
+    , m_algorithm(NULL)
+    , m_runOrder(Function::Loop)
+    , m_stepsCount(0)
+    , m_direction(Function::Forward)
+    , m_step(0)
+{
+    start(QThread::LowPriority);
+}
+
+RGBMatrixPreview::~RGBMatrixPreview()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_exit = true;
+        m_renderCondition.wakeAll();
+    }
+    wait();
+
+    delete m_algorithm;
+}
+
+RGBMap RGBMatrixPreview::restart(RGBMatrix *matrix)
+{
+    stop();
+
+    QMutexLocker locker(&m_mutex);
+
+    // the worker is idle now, so the snapshot can be replaced
+    delete m_algorithm;
+    m_algorithm = NULL;
+    m_matrix = matrix;
+
+    if (matrix == NULL)
+        return RGBMap();
+
+    FixtureGroup* grp = matrix->doc()->fixtureGroup(matrix->fixtureGroup());
+    if (grp == NULL)
+        return RGBMap();
+
+    {
+        QMutexLocker algorithmLocker(&matrix->algorithmMutex());
+        if (matrix->algorithm() == NULL)
+            return RGBMap();
+        m_algorithm = matrix->algorithm()->clone();
+    }
+
+    m_algorithm->setColors(matrix->startColor(), matrix->endColor());
+    if (m_algorithm->type() == RGBAlgorithm::Script)
+    {
+        RGBScript *script = static_cast<RGBScript*> (m_algorithm);
+        QHashIterator<QString, QString> it(matrix->properties());
+        while (it.hasNext())
+        {
+            it.next();
+            script->setProperty(it.key(), it.value());
+        }
+    }
+
+    m_size = grp->size();
+    m_startColor = matrix->startColor();
+    m_endColor = matrix->endColor();
+    m_runOrder = matrix->runOrder();
+    m_stepsCount = m_algorithm->rgbMapStepCount(m_size);
+    m_direction = matrix->direction();
+
+    if (m_direction == Function::Forward)
+    {
+        m_step = 0;
+        m_stepColor = m_startColor;
+    }
+    else
+    {
+        m_step = m_stepsCount - 1;
+        m_stepColor = m_endColor.isValid() ? m_endColor : m_startColor;
+    }
+
+    RGBMap map = m_algorithm->rgbMap(m_size, m_stepColor.rgb(), m_step);
+
+    // audio data is live, so there's no point in rendering it ahead
+    m_synchronous = (m_algorithm->type() == RGBAlgorithm::Audio);
+    if (m_synchronous == false)
+    {
+        m_rendering = true;
+        m_renderCondition.wakeAll();
+    }
+
+    return map;
+}
+
+void RGBMatrixPreview::stop()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_rendering = false;
+    m_generation++;
+    m_frames.clear();
+
+    while (m_busy == true)
+        m_idleCondition.wait(&m_mutex);
+}
+
+bool RGBMatrixPreview::takeFrame(RGBMap &map)
+{
+    // reuse the frames computed by the engine, if any
+    if (m_matrix != NULL && m_matrix->isRunning() && m_matrix->runningMap(map))
+        return true;
+
+    QMutexLocker locker(&m_mutex);
+
+    if (m_synchronous == true)
+    {
+        if (m_algorithm == NULL)
+            return false;
+
+        map = renderNextStep();
+        return true;
+    }
+
+    if (m_frames.isEmpty())
+        return false;
+
+    map = m_frames.dequeue();
+    m_renderCondition.wakeAll();
+
+    return true;
+}
+
+/****************************************************************************
+ * Rendering
+ ****************************************************************************/
+
+void RGBMatrixPreview::run()
+{
+    QMutexLocker locker(&m_mutex);
+
+    while (m_exit == false)
+    {
+        if (m_rendering == false || m_frames.count() >= PREVIEW_QUEUE_SIZE)
+        {
+            m_renderCondition.wait(&m_mutex);
+            continue;
+        }
+
+        quint32 generation = m_generation;
+        m_busy = true;
+        locker.unlock();
+
+        RGBMap map = renderNextStep();
+
+        locker.relock();
+        m_busy = false;
+        if (generation == m_generation)
+            m_frames.enqueue(map);
+        m_idleCondition.wakeAll();
+    }
+}
+
+RGBMap RGBMatrixPreview::renderNextStep()
+{
+    if (m_runOrder == Function::PingPong)
+    {
+        if (m_direction == Function::Forward && (m_step + 1) == m_stepsCount)
+            m_direction = Function::Backward;
+        else if (m_direction == Function::Backward && (m_step - 1) < 0)
+            m_direction = Function::Forward;
+    }
+
+    if (m_direction == Function::Forward)
+    {
+        m_step++;
+        if (m_step >= m_stepsCount)
+        {
+            m_step = 0;
+            m_stepColor = m_startColor;
+        }
+        else
+            updateStepColor();
+    }
+    else
+    {
+        m_step--;
+        if (m_step < 0)
+        {
+            m_step = m_stepsCount - 1;
+            m_stepColor = m_endColor.isValid() ? m_endColor : m_startColor;
+        }
+        else
+            updateStepColor();
+    }
+
+    return m_algorithm->rgbMap(m_size, m_stepColor.rgb(), m_step);
+}
+
+void RGBMatrixPreview::updateStepColor()
+{
+    // same as RGBMatrix::updateStepColor
+    int stepCount = m_stepsCount - 1;
+    if (m_endColor.isValid() == false || stepCount <= 0)
+        return;
+
+    m_stepColor.setRed(m_startColor.red() + ((m_endColor.red() - m_startColor.red()) * m_step / stepCount));
+    m_stepColor.setGreen(m_startColor.green() + ((m_endColor.green() - m_startColor.green()) * m_step / stepCount));
+    m_stepColor.setBlue(m_startColor.blue() + ((m_endColor.blue() - m_startColor.blue()) * m_step / stepCount));
+}
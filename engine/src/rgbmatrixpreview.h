@@ -0,0 +1,133 @@
+/*
+  Q Light Controller Plus
+  rgbmatrixpreview.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef RGBMATRIXPREVIEW_H
+#define RGBMATRIXPREVIEW_H
+
+#include <QWaitCondition>
+#include <QThread>
+#include <QMutex>
+#include <QQueue>
+#include <QColor>
+#include <QSize>
+
+#include "rgbalgorithm.h"
+#include "function.h"
+
+class RGBMatrix;
+
+/** @addtogroup engine_functions Functions
+ * @{
+ */
+
+/**
+ * RGBMatrixPreview renders the steps of an RGBMatrix for the editors preview.
+ *
+ * Frames are rendered ahead on a worker thread into a small queue, so
+ * the editors only have to draw them. This way the UI thread never waits
+ * for the RGB scripts engine, which is shared with the MasterTimer.
+ *
+ * The worker uses its own copy of the matrix algorithm and settings, taken
+ * with restart(), and never touches the matrix itself.
+ * While the matrix is running, the frames are the ones computed by the
+ * engine, so the script is not run twice.
+ */
+class RGBMatrixPreview : public QThread
+{
+    Q_OBJECT
+
+public:
+    RGBMatrixPreview(QObject* parent = 0);
+    ~RGBMatrixPreview();
+
+    /**
+     * Take a snapshot of the settings of $matrix and start rendering its
+     * steps, from the first one of the matrix direction. This must be called
+     * every time the matrix settings change.
+     *
+     * @param matrix The matrix to preview
+     * @return The map of the first step
+     */
+    RGBMap restart(RGBMatrix* matrix);
+
+    /** Stop rendering and discard the queued frames */
+    void stop();
+
+    /**
+     * Take the next step frame.
+     *
+     * @param map The next frame
+     * @return true if a frame was available, otherwise false
+     */
+    bool takeFrame(RGBMap& map);
+
+protected:
+    /** @reimp */
+    void run();
+
+private:
+    /** Advance to the next step and render its map */
+    RGBMap renderNextStep();
+
+    /** Update m_stepColor for the current step */
+    void updateStepColor();
+
+private:
+    /** The previewed matrix. Accessed only by the caller thread */
+    RGBMatrix* m_matrix;
+
+    QMutex m_mutex;
+    /** Wakes up the worker when there's something to render */
+    QWaitCondition m_renderCondition;
+    /** Wakes up restart() when the worker has finished rendering a frame */
+    QWaitCondition m_idleCondition;
+
+    /** The rendered frames, waiting to be taken */
+    QQueue<RGBMap> m_frames;
+    /** Incremented by restart() to discard frames rendered with old settings */
+    quint32 m_generation;
+
+    bool m_exit;
+    /** True when the worker can render frames */
+    bool m_rendering;
+    /** True while the worker is rendering a frame */
+    bool m_busy;
+    /** True when frames must be rendered on the caller thread (audio) */
+    bool m_synchronous;
+
+    /*********************************************************************
+     * Snapshot of the matrix settings. Changed only by restart() while the
+     * worker is idle
+     *********************************************************************/
+    RGBAlgorithm* m_algorithm;
+    QSize m_size;
+    QColor m_startColor;
+    QColor m_endColor;
+    Function::RunOrder m_runOrder;
+    int m_stepsCount;
+
+    /** Current rendering state */
+    Function::Direction m_direction;
+    int m_step;
+    QColor m_stepColor;
+};
+
+/** @} */
+
+#endif
@@ -39,6 +39,11 @@ RGBText::RGBText(Doc * doc)
     , m_animationStyle(Horizontal)
     , m_xOffset(0)
     , m_yOffset(0)
+    , m_glyphsWidth(0)
+    , m_glyphsHeight(0)
+    , m_glyphsValid(false)
+    , m_stepCount(-1)
+    , m_paletteRgb(0)
 {
 }
 
@@ -49,6 +54,11 @@ RGBText::RGBText(const RGBText& t)
     , m_animationStyle(t.animationStyle())
     , m_xOffset(t.xOffset())
     , m_yOffset(t.yOffset())
+    , m_glyphsWidth(0)
+    , m_glyphsHeight(0)
+    , m_glyphsValid(false)
+    , m_stepCount(-1)
+    , m_paletteRgb(0)
 {
 }
 
@@ -69,6 +79,7 @@ RGBAlgorithm* RGBText::clone() const
 void RGBText::setText(const QString& str)
 {
     m_text = str;
+    invalidateGlyphs();
 }
 
 QString RGBText::text() const
@@ -79,6 +90,7 @@ QString RGBText::text() const
 void RGBText::setFont(const QFont& font)
 {
     m_font = font;
+    invalidateGlyphs();
 }
 
 QFont RGBText::font() const
@@ -96,6 +108,7 @@ void RGBText::setAnimationStyle(RGBText::AnimationStyle ani)
         m_animationStyle = ani;
     else
         m_animationStyle = StaticLetters;
+    invalidateGlyphs();
 }
 
 RGBText::AnimationStyle RGBText::animationStyle() const
@@ -139,6 +152,7 @@ QStringList RGBText::animationStyles()
 void RGBText::setXOffset(int offset)
 {
     m_xOffset = offset;
+    invalidateGlyphs();
 }
 
 int RGBText::xOffset() const
@@ -149,6 +163,7 @@ int RGBText::xOffset() const
 void RGBText::setYOffset(int offset)
 {
     m_yOffset = offset;
+    invalidateGlyphs();
 }
 
 int RGBText::yOffset() const
@@ -165,22 +180,134 @@ int RGBText::scrollingTextStepCount() const
         return fm.width(m_text);
 }
 
-RGBMap RGBText::renderScrollingText(const QSize& size, uint rgb, int step) const
+RGBMap RGBText::renderScrollingText(const QSize& size, int step) const
 {
-    QImage image;
+    RGBMap map(size.height());
+    for (int y = 0; y < size.height(); y++)
+        map[y].resize(size.width());
+
+    if (step < 0)
+        return map;
+
+    // Treat the RGBMap as a "window" on top of the fully-drawn text and copy
+    // the pixels according to $step. Pixels past the end of the text stay 0.
+    int rows, cols, first, left;
     if (animationStyle() == Horizontal)
-        image = QImage(scrollingTextStepCount(), size.height(), QImage::Format_RGB32);
+    {
+        rows = qMin(size.height(), m_glyphsHeight);
+        cols = qMin(size.width(), m_glyphsWidth - step);
+        first = 0;
+        left = step;
+    }
+    else
+    {
+        rows = qMin(size.height(), m_glyphsHeight - step);
+        cols = qMin(size.width(), m_glyphsWidth);
+        first = step;
+        left = 0;
+    }
+
+    const uchar* glyphs = m_glyphs.constData();
+    const uint* palette = m_palette.constData();
+
+    for (int y = 0; y < rows; y++)
+    {
+        const uchar* src = glyphs + ((first + y) * m_glyphsWidth) + left;
+        uint* dst = map[y].data();
+        for (int x = 0; x < cols; x++)
+            dst[x] = palette[src[x]];
+    }
+
+    return map;
+}
+
+RGBMap RGBText::renderStaticLetters(const QSize& size, int step) const
+{
+    RGBMap map(size.height());
+    for (int y = 0; y < size.height(); y++)
+        map[y].fill(m_palette.at(0), size.width());
+
+    if (step < 0 || step >= m_text.length())
+        return map;
+
+    // Each letter has its own cell in the strip
+    const uchar* glyphs = m_glyphs.constData() + (step * size.width());
+    const uint* palette = m_palette.constData();
+
+    for (int y = 0; y < size.height(); y++)
+    {
+        const uchar* src = glyphs + (y * m_glyphsWidth);
+        uint* dst = map[y].data();
+        for (int x = 0; x < size.width(); x++)
+            dst[x] = palette[src[x]];
+    }
+
+    return map;
+}
+
+/****************************************************************************
+ * Glyph strip
+ ****************************************************************************/
+
+void RGBText::invalidateGlyphs()
+{
+    m_glyphsValid = false;
+    m_stepCount = -1;
+}
+
+void RGBText::updateGlyphs(const QSize& size)
+{
+    if (m_glyphsValid == true && size == m_glyphsSize)
+        return;
+
+    m_glyphsSize = size;
+    m_glyphsValid = true;
+
+    if (animationStyle() == StaticLetters)
+    {
+        m_glyphsWidth = size.width() * m_text.length();
+        m_glyphsHeight = size.height();
+    }
+    else if (animationStyle() == Horizontal)
+    {
+        m_glyphsWidth = scrollingTextStepCount();
+        m_glyphsHeight = size.height();
+    }
     else
-        image = QImage(size.width(), scrollingTextStepCount(), QImage::Format_RGB32);
+    {
+        m_glyphsWidth = size.width();
+        m_glyphsHeight = scrollingTextStepCount();
+    }
+
+    if (m_glyphsWidth <= 0 || m_glyphsHeight <= 0)
+    {
+        m_glyphsWidth = 0;
+        m_glyphsHeight = 0;
+        m_glyphs.clear();
+        return;
+    }
+
+    // Draw white text once. It is then colored with the palette of each step.
+    QImage image(m_glyphsWidth, m_glyphsHeight, QImage::Format_RGB32);
     image.fill(QRgb(0));
 
     QPainter p(&image);
     p.setRenderHint(QPainter::TextAntialiasing, false);
     p.setRenderHint(QPainter::Antialiasing, false);
     p.setFont(m_font);
-    p.setPen(QColor(rgb));
+    p.setPen(QColor(Qt::white));
 
-    if (animationStyle() == Vertical)
+    if (animationStyle() == StaticLetters)
+    {
+        // Draw one letter per cell, clipped like it was drawn alone
+        for (int i = 0; i < m_text.length(); i++)
+        {
+            QRect cell(i * size.width(), 0, size.width(), size.height());
+            p.setClipRect(cell);
+            p.drawText(cell.translated(xOffset(), yOffset()), Qt::AlignCenter, m_text.mid(i, 1));
+        }
+    }
+    else if (animationStyle() == Vertical)
     {
         QFontMetrics fm(m_font);
         QRect rect(0, 0, image.width(), image.height());
@@ -195,61 +322,36 @@ RGBMap RGBText::renderScrollingText(const QSize& size, uint rgb, int step) const
     }
     else
     {
-        // Draw the whole text each time
+        // Draw the whole text at once
         QRect rect(xOffset(), yOffset(), image.width(), image.height());
         p.drawText(rect, Qt::AlignLeft | Qt::AlignVCenter, m_text);
     }
     p.end();
 
-    // Treat the RGBMap as a "window" on top of the fully-drawn text and pick the
-    // correct pixels according to $step.
-    RGBMap map(size.height());
-    for (int y = 0; y < size.height(); y++)
+    m_glyphs.resize(m_glyphsWidth * m_glyphsHeight);
+    uchar* glyphs = m_glyphs.data();
+
+    for (int y = 0; y < m_glyphsHeight; y++)
     {
-        map[y].resize(size.width());
-        for (int x = 0; x < size.width(); x++)
-        {
-            if (animationStyle() == Horizontal)
-            {
-                if (step + x < image.width())
-                    map[y][x] = image.pixel(step + x, y);
-            }
-            else
-            {
-                if (step + y < image.height())
-                    map[y][x] = image.pixel(x, step + y);
-            }
-        }
+        const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        for (int x = 0; x < m_glyphsWidth; x++)
+            glyphs[(y * m_glyphsWidth) + x] = qRed(line[x]);
     }
-
-    return map;
 }
 
-RGBMap RGBText::renderStaticLetters(const QSize& size, uint rgb, int step) const
+void RGBText::updatePalette(uint rgb)
 {
-    QImage image(size, QImage::Format_RGB32);
-    image.fill(QRgb(0));
+    if (m_palette.isEmpty() == false && rgb == m_paletteRgb)
+        return;
 
-    QPainter p(&image);
-    p.setRenderHint(QPainter::TextAntialiasing, false);
-    p.setRenderHint(QPainter::Antialiasing, false);
-    p.setFont(m_font);
-
-    p.setPen(QColor(rgb));
-    // Draw one letter at a time
-    QRect rect(xOffset(), yOffset(), size.width(), size.height());
-    p.drawText(rect, Qt::AlignCenter, m_text.mid(step, 1));
-    p.end();
-
-    RGBMap map(size.height());
-    for (int y = 0; y < size.height(); y++)
+    m_palette.resize(256);
+    for (int i = 0; i < 256; i++)
     {
-        map[y].resize(size.width());
-        for (int x = 0; x < size.width(); x++)
-            map[y][x] = image.pixel(x, y);
+        m_palette[i] = qRgb((qRed(rgb) * i) / 255,
+                            (qGreen(rgb) * i) / 255,
+                            (qBlue(rgb) * i) / 255);
     }
-
-    return map;
+    m_paletteRgb = rgb;
 }
 
 /****************************************************************************
@@ -259,18 +361,26 @@ RGBMap RGBText::renderStaticLetters(const QSize& size, uint rgb, int step) const
 int RGBText::rgbMapStepCount(const QSize& size)
 {
     Q_UNUSED(size);
-    if (animationStyle() == StaticLetters)
-        return m_text.length();
-    else
-        return scrollingTextStepCount();
+    if (m_stepCount < 0)
+    {
+        if (animationStyle() == StaticLetters)
+            m_stepCount = m_text.length();
+        else
+            m_stepCount = scrollingTextStepCount();
+    }
+
+    return m_stepCount;
 }
 
 RGBMap RGBText::rgbMap(const QSize& size, uint rgb, int step)
 {
+    updateGlyphs(size);
+    updatePalette(rgb);
+
     if (animationStyle() == StaticLetters)
-        return renderStaticLetters(size, rgb, step);
+        return renderStaticLetters(size, step);
     else
-        return renderScrollingText(size, rgb, step);
+        return renderScrollingText(size, step);
 }
 
 QString RGBText::name() const
@@ -21,6 +21,7 @@
 #ifndef RGBTEXT_H
 #define RGBTEXT_H
 
+#include <QVector>
 #include <QString>
 #include <QFont>
 
@@ -83,14 +84,47 @@ public:
 
 private:
     int scrollingTextStepCount() const;
-    RGBMap renderScrollingText(const QSize& size, uint rgb, int step) const;
-    RGBMap renderStaticLetters(const QSize& size, uint rgb, int step) const;
+    RGBMap renderScrollingText(const QSize& size, int step) const;
+    RGBMap renderStaticLetters(const QSize& size, int step) const;
 
 private:
     AnimationStyle m_animationStyle;
     int m_xOffset;
     int m_yOffset;
 
+    /************************************************************************
+     * Glyph strip
+     ************************************************************************/
+private:
+    /** Discard the rendered glyphs and the cached step count */
+    void invalidateGlyphs();
+
+    /**
+     * Render the whole text for the matrix $size, unless it has been rendered
+     * already. Horizontal text is rendered on a single row, vertical text on a
+     * single column, and static letters side by side, one matrix-sized cell each.
+     */
+    void updateGlyphs(const QSize& size);
+
+    /** Build the palette mapping glyph intensities to shades of $rgb */
+    void updatePalette(uint rgb);
+
+private:
+    /** The intensity of each pixel of the rendered text, row by row */
+    QVector<uchar> m_glyphs;
+    int m_glyphsWidth;
+    int m_glyphsHeight;
+
+    /** The matrix size the glyphs have been rendered for */
+    QSize m_glyphsSize;
+    bool m_glyphsValid;
+
+    /** Number of steps for the current text, font and style. -1 if unknown. */
+    int m_stepCount;
+
+    QVector<uint> m_palette;
+    uint m_paletteRgb;
+
     /************************************************************************
      * RGBAlgorithm
      ************************************************************************/
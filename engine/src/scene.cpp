@@ -93,8 +93,7 @@ bool Scene::copyFrom(const Function* function)
     if (scene == NULL)
         return false;
 
-    m_values.clear();
-    m_values = scene->m_values;
+    m_values = scene->valueStore();
     m_channelGroups.clear();
     m_channelGroups = scene->m_channelGroups;
     m_channelGroupsLevels.clear();
@@ -123,14 +122,7 @@ void Scene::setValue(const SceneValue& scv, bool blind, bool checkHTP)
 
     m_valueListMutex.lock();
 
-    QMap<SceneValue, uchar>::iterator it = m_values.find(scv);
-    if (it == m_values.end())
-        m_values.insert(scv, scv.value);
-    else
-    {
-        const_cast<uchar&>(it.key().value) = scv.value;
-        it.value() = scv.value;
-    }
+    m_values.insert(scv);
 
     // if the scene is running, we must
     // update/add the changed channel
@@ -163,7 +155,7 @@ void Scene::unsetValue(quint32 fxi, quint32 ch)
         qWarning() << Q_FUNC_INFO << "Unsetting value for unknown fixture" << fxi;
 
     m_valueListMutex.lock();
-    m_values.remove(SceneValue(fxi, ch, 0));
+    m_values.remove(ChannelValueStore::sceneKey(fxi, ch));
     m_valueListMutex.unlock();
 
     emit changed(this->id());
@@ -171,17 +163,25 @@ void Scene::unsetValue(quint32 fxi, quint32 ch)
 
 uchar Scene::value(quint32 fxi, quint32 ch)
 {
-    return m_values.value(SceneValue(fxi, ch, 0), 0);
+    QMutexLocker locker(&m_valueListMutex);
+    return m_values.value(ChannelValueStore::sceneKey(fxi, ch), 0);
 }
 
 bool Scene::checkValue(SceneValue val)
 {
-    return m_values.contains(val);
+    QMutexLocker locker(&m_valueListMutex);
+    return m_values.contains(ChannelValueStore::sceneKey(val.fxi, val.channel));
 }
 
 QList <SceneValue> Scene::values() const
 {
-    return m_values.keys();
+    return valueStore().toSceneValues();
+}
+
+ChannelValueStore Scene::valueStore() const
+{
+    QMutexLocker locker(&m_valueListMutex);
+    return m_values;
 }
 
 QColor Scene::colorValue(quint32 fxi)
@@ -191,7 +191,7 @@ QColor Scene::colorValue(quint32 fxi)
     bool found = false;
     QColor CMYcol;
 
-    foreach(SceneValue scv, m_values.keys())
+    foreach(SceneValue scv, values())
     {
         if (fxi != Fixture::invalidId() && fxi != scv.fxi)
             continue;
@@ -247,6 +247,7 @@ QColor Scene::colorValue(quint32 fxi)
 
 void Scene::clear()
 {
+    QMutexLocker locker(&m_valueListMutex);
     m_values.clear();
 }
 
@@ -299,16 +300,10 @@ void Scene::slotFixtureRemoved(quint32 fxi_id)
 {
     bool hasChanged = false;
 
-    QMutableMapIterator <SceneValue, uchar> it(m_values);
-    while (it.hasNext() == true)
-    {
-        SceneValue value(it.next().key());
-        if (value.fxi == fxi_id)
-        {
-            it.remove();
-            hasChanged = true;
-        }
-    }
+    m_valueListMutex.lock();
+    if (m_values.removeFixture(fxi_id) > 0)
+        hasChanged = true;
+    m_valueListMutex.unlock();
 
     if (removeFixture(fxi_id))
         hasChanged = true;
@@ -365,12 +360,14 @@ bool Scene::saveXML(QXmlStreamWriter *doc)
 
     /* Scene contents */
     QSet<quint32> writtenFixtures;
-    QMapIterator <SceneValue, uchar> it(m_values);
+    ChannelValueStore store = valueStore();
     qint32 currFixID = -1;
     QStringList currFixValues;
-    while (it.hasNext() == true)
+    for (int i = 0; i < store.count(); i++)
     {
-        SceneValue sv = it.next().key();
+        SceneValue sv(ChannelValueStore::sceneKeyFixture(store.at(i).key),
+                      ChannelValueStore::sceneKeyChannel(store.at(i).key),
+                      store.at(i).value);
         if (currFixID == -1) currFixID = sv.fxi;
         if ((qint32)sv.fxi != currFixID)
         {
@@ -509,14 +506,20 @@ void Scene::postLoad()
     }
 
     // Remove such fixtures and channels that don't exist
-    QMutableMapIterator <SceneValue, uchar> it(m_values);
-    while (it.hasNext() == true)
+    QMutexLocker locker(&m_valueListMutex);
+    ChannelValueStore validValues;
+    validValues.reserve(m_values.count());
+
+    for (int i = 0; i < m_values.count(); i++)
     {
-        SceneValue value(it.next().key());
-        Fixture* fxi = doc()->fixture(value.fxi);
-        if (fxi == NULL || fxi->channel(value.channel) == NULL)
-            it.remove();
+        const ChannelValueStore::Entry& entry = m_values.at(i);
+        Fixture* fxi = doc()->fixture(ChannelValueStore::sceneKeyFixture(entry.key));
+        if (fxi != NULL && fxi->channel(ChannelValueStore::sceneKeyChannel(entry.key)) != NULL)
+            validValues.insert(entry.key, entry.value);
     }
+
+    if (validValues.count() != m_values.count())
+        m_values = validValues;
 }
 
 /****************************************************************************
@@ -551,10 +554,13 @@ void Scene::writeDMX(MasterTimer* timer, QList<Universe *> ua)
     {
         // Keep HTP and LTP channels up. Flash is more or less a forceful intervention
         // so enforce all values that the user has chosen to flash.
-        foreach (const SceneValue& sv, m_values.keys())
+        ChannelValueStore store = valueStore();
+        for (int i = 0; i < store.count(); i++)
         {
-            FadeChannel fc(doc(), sv.fxi, sv.channel);
-            fc.setTarget(sv.value);
+            const ChannelValueStore::Entry& entry = store.at(i);
+            FadeChannel fc(doc(), ChannelValueStore::sceneKeyFixture(entry.key),
+                           ChannelValueStore::sceneKeyChannel(entry.key));
+            fc.setTarget(entry.value);
             fc.setFlashing(true);
             // Force add this channel, since it will be removed
             // by MasterTimer once applied
@@ -587,7 +593,7 @@ void Scene::write(MasterTimer* timer, QList<Universe*> ua)
     Q_UNUSED(timer);
     Q_ASSERT(m_fader != NULL);
 
-    if (m_values.size() == 0)
+    if (m_values.isEmpty())
     {
         stop(FunctionParent::master());
         return;
@@ -596,10 +602,11 @@ void Scene::write(MasterTimer* timer, QList<Universe*> ua)
     if (elapsed() == 0)
     {
         m_valueListMutex.lock();
-        QMapIterator <SceneValue, uchar> it(m_values);
-        while (it.hasNext() == true)
+        for (int i = 0; i < m_values.count(); i++)
         {
-            SceneValue value(it.next().key());
+            const ChannelValueStore::Entry& entry = m_values.at(i);
+            SceneValue value(ChannelValueStore::sceneKeyFixture(entry.key),
+                             ChannelValueStore::sceneKeyChannel(entry.key), entry.value);
             bool canFade = true;
 
             FadeChannel fc(doc(), value.fxi, value.channel);
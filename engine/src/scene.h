@@ -24,6 +24,7 @@
 #include <QMutex>
 #include <QList>
 
+#include "channelvaluestore.h"
 #include "genericfader.h"
 #include "fadechannel.h"
 #include "scenevalue.h"
@@ -135,6 +136,13 @@ public:
      */
     QList <SceneValue> values() const;
 
+    /**
+     * Get a snapshot of the values in this scene. The returned store
+     * shares its data with the Scene until one of them is modified,
+     * so this is much cheaper than values() for large scenes.
+     */
+    ChannelValueStore valueStore() const;
+
     /**
      * Try to retrieve a RGB/CMY color if the Scene has RGB/CMY channels set.
      * A fixture ID can be specified to retrieve a single fixture color.
@@ -148,8 +156,8 @@ public:
     void clear();
 
 protected:
-    QMap <SceneValue, uchar> m_values;
-    QMutex m_valueListMutex;
+    ChannelValueStore m_values;
+    mutable QMutex m_valueListMutex;
 
     /*********************************************************************
      * Channel Groups
@@ -47,6 +47,7 @@ ShowRunner::ShowRunner(const Doc* doc, quint32 showID, quint32 startTime)
     , m_elapsedTime(startTime)
     , m_totalRunTime(0)
     , m_currentFunctionIndex(0)
+    , m_preloadIndex(0)
 {
     Q_ASSERT(m_doc != NULL);
     Q_ASSERT(showID != Show::invalidId());
@@ -115,8 +116,17 @@ void ShowRunner::setPause(bool enable)
 
 void ShowRunner::stop()
 {
+    // release the media prepared for Functions that haven't started
+    for (int i = m_currentFunctionIndex; i < m_preloadIndex; i++)
+    {
+        Function *f = m_doc->function(m_functions.at(i)->functionID());
+        if (f != NULL)
+            f->cancelPreload();
+    }
+
     m_elapsedTime = 0;
     m_currentFunctionIndex = 0;
+    m_preloadIndex = 0;
     foreach (Function *f, m_runningQueue)
         f->stop(functionParent());
 
@@ -138,9 +148,33 @@ void ShowRunner::slotFunctionStopped(quint32 id)
     m_runningQueueMutex.unlock();
 }
 
+void ShowRunner::preloadFunctions()
+{
+    quint32 horizon = m_elapsedTime + MasterTimer::mediaPreroll();
+
+    // Functions are sorted by start time
+    while (m_preloadIndex < m_functions.count() &&
+           m_functions.at(m_preloadIndex)->startTime() <= horizon)
+    {
+        ShowFunction *sf = m_functions.at(m_preloadIndex);
+        Function *f = m_doc->function(sf->functionID());
+        if (f != NULL)
+        {
+            // same offset as write() will use when starting it
+            quint32 offset = 0;
+            if (m_elapsedTime > sf->startTime())
+                offset = m_elapsedTime - sf->startTime();
+            f->preload(offset);
+        }
+        m_preloadIndex++;
+    }
+}
+
 void ShowRunner::write()
 {
     //qDebug() << Q_FUNC_INFO << "elapsed:" << m_elapsedTime << ", total:" << m_totalRunTime;
+    preloadFunctions();
+
     if (m_currentFunctionIndex < m_functions.count())
     {
         ShowFunction *sf = m_functions.at(m_currentFunctionIndex);
@@ -79,8 +79,14 @@ private:
     /** Current step being played */
     int m_currentFunctionIndex;
 
+    /** Index of the first Function that has not been preloaded yet */
+    int m_preloadIndex;
+
 private:
     FunctionParent functionParent() const;
+
+    /** Preload the Functions starting within MasterTimer::mediaPreroll() */
+    void preloadFunctions();
 private slots:
     void slotFunctionStopped(quint32);
 
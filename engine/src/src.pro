@@ -56,6 +56,8 @@ HEADERS += avolitesd4parser.h \
            qlcinputsource.h \
            qlcmodifierscache.h \
            qlcphysical.h \
+           qlcstringpool.h \
+           qlctrace.h \
            utils.h
 
 greaterThan(QT_MAJOR_VERSION, 4) {
@@ -66,6 +68,7 @@ greaterThan(QT_MAJOR_VERSION, 4) {
 HEADERS += bus.h \
            channelsgroup.h \
            channelmodifier.h \
+           channelvaluestore.h \
            chaser.h \
            chaserrunner.h \
            chaserstep.h \
@@ -77,17 +80,21 @@ HEADERS += bus.h \
            dmxsource.h \
            efx.h \
            efxfixture.h \
+           efxpreview.h \
            efxuistate.h \
            fadechannel.h \
+           feedbackdispatcher.h \
            fixture.h \
            fixturegroup.h \
            function.h \
+           functionloader.h \
            functionuistate.h \
            genericdmxsource.h \
            genericfader.h \
            gradient.h \
            grandmaster.h \
            grouphead.h \
+           idslotmap.h \
            inputoutputmap.h \
            inputpatch.h \
            ioplugincache.h \
@@ -99,6 +106,7 @@ HEADERS += bus.h \
            rgbalgorithm.h \
            rgbaudio.h \
            rgbmatrix.h \
+           rgbmatrixpreview.h \
            rgbimage.h \
            rgbplain.h \
            rgbscriptproperty.h \
@@ -111,8 +119,10 @@ HEADERS += bus.h \
            show.h \
            showfunction.h \
            showrunner.h \
+           statejournal.h \
            track.h \
-           universe.h
+           universe.h \
+           valuemailbox.h
 
 qmlui {
   HEADERS += rgbscriptv4.h
@@ -137,7 +147,9 @@ SOURCES += avolitesd4parser.cpp \
            qlcinputprofile.cpp \
            qlcinputsource.cpp \
            qlcmodifierscache.cpp \
-           qlcphysical.cpp
+           qlcphysical.cpp \
+           qlcstringpool.cpp \
+           qlctrace.cpp
 
 greaterThan(QT_MAJOR_VERSION, 4) {
   SOURCES += video.cpp
@@ -147,6 +159,7 @@ greaterThan(QT_MAJOR_VERSION, 4) {
 SOURCES += bus.cpp \
            channelsgroup.cpp \
            channelmodifier.cpp \
+           channelvaluestore.cpp \
            chaser.cpp \
            chaserrunner.cpp \
            chaserstep.cpp \
@@ -157,11 +170,14 @@ SOURCES += bus.cpp \
            dmxdumpfactoryproperties.cpp \
            efx.cpp \
            efxfixture.cpp \
+           efxpreview.cpp \
            efxuistate.cpp \
            fadechannel.cpp \
+           feedbackdispatcher.cpp \
            fixture.cpp \
            fixturegroup.cpp \
            function.cpp \
+           functionloader.cpp \
            functionuistate.cpp \
            genericdmxsource.cpp \
            genericfader.cpp \
@@ -179,6 +195,7 @@ SOURCES += bus.cpp \
            rgbalgorithm.cpp \
            rgbaudio.cpp \
            rgbmatrix.cpp \
+           rgbmatrixpreview.cpp \
            rgbimage.cpp \
            rgbplain.cpp \
            rgbscriptscache.cpp \
@@ -190,8 +207,10 @@ SOURCES += bus.cpp \
            show.cpp \
            showfunction.cpp \
            showrunner.cpp \
+           statejournal.cpp \
            track.cpp \
-           universe.cpp
+           universe.cpp \
+           valuemailbox.cpp
 
 qmlui {
   SOURCES += rgbscriptv4.cpp
@@ -0,0 +1,431 @@
+/*
+  Q Light Controller Plus
+  statejournal.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSettings>
+#include <QDebug>
+#include <QDir>
+
+#include <climits>
+#include <cstring>
+
+#include "inputoutputmap.h"
+#include "functionparent.h"
+#include "statejournal.h"
+#include "mastertimer.h"
+#include "qlcconfig.h"
+#include "universe.h"
+#include "function.h"
+#include "chaser.h"
+#include "doc.h"
+
+#define STATEJOURNAL_ENABLED    "workspace/journal"
+#define STATEJOURNAL_INTERVAL   "workspace/journalinterval"
+#define STATEJOURNAL_FILE       "statejournal.bin"
+
+/** Default interval between two writes, in milliseconds */
+#define JOURNAL_DEFAULT_INTERVAL    250
+
+/* File layout: a header with magic, version and slot size, followed by
+ * two slots. Each slot starts with the size and the checksum of its payload */
+#define JOURNAL_MAGIC           0x4a434c51
+#define JOURNAL_VERSION         1
+#define JOURNAL_HEADER_SIZE     12
+#define JOURNAL_SLOT_HEADER     8
+#define JOURNAL_MIN_SLOT_SIZE   16384
+
+namespace
+{
+    /** A function recorded in the journal */
+    struct RunningFunction
+    {
+        quint32 id;
+        quint32 elapsed;
+        qint32 stepIndex;
+        QList<FunctionParent> parents;
+    };
+}
+
+StateJournal::StateJournal(Doc *doc, QObject *parent)
+    : QObject(parent)
+    , m_doc(doc)
+    , m_enabled(false)
+    , m_fileName(defaultFileName())
+    , m_map(NULL)
+    , m_slotSize(0)
+    , m_sequence(0)
+{
+    Q_ASSERT(doc != NULL);
+
+    QSettings settings;
+    m_enabled = settings.value(STATEJOURNAL_ENABLED, false).toBool();
+
+    int interval = JOURNAL_DEFAULT_INTERVAL;
+    QVariant var = settings.value(STATEJOURNAL_INTERVAL);
+    if (var.isValid() == true && var.toInt() > 0)
+        interval = var.toInt();
+
+    m_timer.setInterval(interval);
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(slotWrite()));
+}
+
+StateJournal::~StateJournal()
+{
+    stop();
+}
+
+bool StateJournal::isEnabled() const
+{
+    return m_enabled;
+}
+
+QString StateJournal::defaultFileName()
+{
+    return QString("%1/%2/%3").arg(QDir::homePath()).arg(USERQLCPLUSDIR).arg(STATEJOURNAL_FILE);
+}
+
+void StateJournal::setFileName(const QString &fileName)
+{
+    m_fileName = fileName;
+}
+
+void StateJournal::setWorkspace(const QString &fileName)
+{
+    if (fileName.isEmpty())
+        m_workspace = QString();
+    else
+        m_workspace = QFileInfo(fileName).absoluteFilePath();
+}
+
+qint64 StateJournal::workspaceStamp(const QString &fileName)
+{
+    QFileInfo info(fileName);
+    return info.lastModified().toMSecsSinceEpoch() ^ info.size();
+}
+
+/*********************************************************************
+ * Recording
+ *********************************************************************/
+
+void StateJournal::start()
+{
+    if (m_enabled == false || m_workspace.isEmpty())
+        return;
+
+    qDebug() << Q_FUNC_INFO << "Recording the state of" << m_workspace << "in" << m_fileName;
+
+    slotWrite();
+    m_timer.start();
+}
+
+void StateJournal::stop()
+{
+    // closing the workspace or quitting leaves nothing to resume
+    m_timer.stop();
+    invalidate();
+    unmap();
+}
+
+QByteArray StateJournal::snapshot()
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_4_6);
+
+    stream << ++m_sequence << QDateTime::currentDateTime().toMSecsSinceEpoch()
+           << m_workspace << workspaceStamp(m_workspace);
+
+    /* The timer thread runs the functions with the universes claimed, so
+     * this records the functions and the values of the same frame */
+    QList<Universe*> universes = m_doc->inputOutputMap()->claimUniverses();
+
+    /* Functions started by another function are started again by it,
+     * so only the ones started by something else are recorded */
+    QList<Function*> running = m_doc->masterTimer()->runningFunctionList();
+    QList<Function*> roots;
+    QList< QList<FunctionParent> > rootsParents;
+    foreach (Function* function, running)
+    {
+        QList<FunctionParent> parents;
+        foreach (FunctionParent parent, function->sources())
+        {
+            if (parent.type() != FunctionParent::Function)
+                parents.append(parent);
+        }
+        if (parents.isEmpty() == false)
+        {
+            roots.append(function);
+            rootsParents.append(parents);
+        }
+    }
+
+    stream << quint32(roots.count());
+    for (int i = 0; i < roots.count(); i++)
+    {
+        Function* function = roots.at(i);
+        qint32 stepIndex = -1;
+        Chaser* chaser = qobject_cast<Chaser*>(function);
+        if (chaser != NULL && chaser->isSequence() == false)
+            stepIndex = chaser->currentStepIndex();
+
+        stream << function->id() << function->elapsed() << stepIndex
+               << quint32(rootsParents.at(i).count());
+        foreach (FunctionParent parent, rootsParents.at(i))
+            stream << parent.type() << parent.id();
+    }
+
+    stream << quint32(universes.count());
+    foreach (Universe* universe, universes)
+        stream << universe->id() << universe->preGMValues().left(universe->usedChannels());
+    m_doc->inputOutputMap()->releaseUniverses(false);
+
+    return payload;
+}
+
+bool StateJournal::map(quint32 slotSize)
+{
+    unmap();
+
+    m_file.setFileName(m_fileName);
+    if (m_file.open(QIODevice::ReadWrite) == false)
+    {
+        qWarning() << Q_FUNC_INFO << "Unable to open" << m_fileName << m_file.errorString();
+        return false;
+    }
+
+    qint64 size = JOURNAL_HEADER_SIZE + 2 * qint64(slotSize);
+    if (m_file.resize(size) == true)
+        m_map = m_file.map(0, size);
+
+    if (m_map == NULL)
+    {
+        qWarning() << Q_FUNC_INFO << "Unable to map" << m_fileName << m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    memset(m_map, 0, size);
+    quint32 header[3] = { JOURNAL_MAGIC, JOURNAL_VERSION, slotSize };
+    memcpy(m_map, header, JOURNAL_HEADER_SIZE);
+    m_slotSize = slotSize;
+
+    return true;
+}
+
+void StateJournal::unmap()
+{
+    if (m_map != NULL)
+    {
+        m_file.unmap(m_map);
+        m_map = NULL;
+        m_slotSize = 0;
+    }
+    if (m_file.isOpen())
+        m_file.close();
+}
+
+void StateJournal::invalidate()
+{
+    if (m_map != NULL)
+        memset(m_map, 0, JOURNAL_HEADER_SIZE);
+}
+
+void StateJournal::slotWrite()
+{
+    QByteArray payload = snapshot();
+    quint32 needed = JOURNAL_SLOT_HEADER + payload.size();
+
+    if (m_map == NULL || needed > m_slotSize)
+    {
+        if (map(qMax(needed * 2, quint32(JOURNAL_MIN_SLOT_SIZE))) == false)
+        {
+            m_timer.stop();
+            return;
+        }
+    }
+
+    /* Write the slot not holding the last state. The size is written last,
+     * so the slot is never valid while it is being written */
+    uchar* slot = m_map + JOURNAL_HEADER_SIZE + (m_sequence % 2) * m_slotSize;
+    quint32 slotHeader[2] = { 0, qChecksum(payload.constData(), payload.size()) };
+
+    memset(slot, 0, JOURNAL_SLOT_HEADER);
+    memcpy(slot + JOURNAL_SLOT_HEADER, payload.constData(), payload.size());
+    memcpy(slot + 4, &slotHeader[1], 4);
+    slotHeader[0] = payload.size();
+    memcpy(slot, &slotHeader[0], 4);
+}
+
+/*********************************************************************
+ * Restore
+ *********************************************************************/
+
+QByteArray StateJournal::newestPayload(const uchar *data, qint64 size)
+{
+    if (size < JOURNAL_HEADER_SIZE)
+        return QByteArray();
+
+    quint32 header[3];
+    memcpy(header, data, JOURNAL_HEADER_SIZE);
+    if (header[0] != JOURNAL_MAGIC || header[1] != JOURNAL_VERSION ||
+        header[2] < JOURNAL_MIN_SLOT_SIZE ||
+        JOURNAL_HEADER_SIZE + 2 * qint64(header[2]) > size)
+        return QByteArray();
+
+    QByteArray newest;
+    quint32 newestSequence = 0;
+
+    for (int i = 0; i < 2; i++)
+    {
+        const uchar* slot = data + JOURNAL_HEADER_SIZE + i * header[2];
+        quint32 slotHeader[2];
+        memcpy(slotHeader, slot, JOURNAL_SLOT_HEADER);
+        if (slotHeader[0] == 0 || slotHeader[0] > header[2] - JOURNAL_SLOT_HEADER)
+            continue;
+
+        QByteArray payload(reinterpret_cast<const char*>(slot + JOURNAL_SLOT_HEADER), slotHeader[0]);
+        if (qChecksum(payload.constData(), payload.size()) != slotHeader[1])
+            continue;
+
+        QDataStream stream(payload);
+        stream.setVersion(QDataStream::Qt_4_6);
+        quint32 sequence = 0;
+        stream >> sequence;
+        if (newest.isEmpty() || sequence > newestSequence)
+        {
+            newest = payload;
+            newestSequence = sequence;
+        }
+    }
+
+    return newest;
+}
+
+bool StateJournal::restore()
+{
+    if (m_enabled == false || m_workspace.isEmpty())
+        return false;
+
+    QFile file(m_fileName);
+    if (file.open(QIODevice::ReadOnly) == false)
+        return false;
+
+    QByteArray payload;
+    uchar* data = file.map(0, file.size());
+    if (data != NULL)
+    {
+        payload = newestPayload(data, file.size());
+        file.unmap(data);
+    }
+    file.close();
+
+    if (payload.isEmpty())
+        return false;
+
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_4_6);
+
+    quint32 sequence = 0;
+    qint64 timestamp = 0, stamp = 0;
+    QString workspace;
+    stream >> sequence >> timestamp >> workspace >> stamp;
+
+    if (workspace != m_workspace || stamp != workspaceStamp(m_workspace))
+    {
+        qDebug() << Q_FUNC_INFO << "The journal belongs to another workspace";
+        return false;
+    }
+
+    QList<RunningFunction> functions;
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++)
+    {
+        RunningFunction rf;
+        quint32 parentsCount = 0;
+        stream >> rf.id >> rf.elapsed >> rf.stepIndex >> parentsCount;
+        for (quint32 p = 0; p < parentsCount && stream.status() == QDataStream::Ok; p++)
+        {
+            quint32 type = 0, id = 0;
+            stream >> type >> id;
+            rf.parents.append(FunctionParent(FunctionParent::Type(type), id));
+        }
+        functions.append(rf);
+    }
+
+    stream >> count;
+    QList< QPair<quint32, QByteArray> > values;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++)
+    {
+        quint32 id = 0;
+        QByteArray preGM;
+        stream >> id >> preGM;
+        values.append(QPair<quint32, QByteArray>(id, preGM));
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        qWarning() << Q_FUNC_INFO << "The journal is corrupted";
+        return false;
+    }
+
+    qDebug() << Q_FUNC_INFO << "Resuming" << functions.count() << "functions recorded"
+             << QDateTime::currentDateTime().toMSecsSinceEpoch() - timestamp << "ms ago";
+
+    /* Output the recorded values right away. LTP channels keep them until
+     * a function writes them, intensities are refreshed by the functions */
+    QList<Universe*> universes = m_doc->inputOutputMap()->claimUniverses();
+    for (int i = 0; i < values.count(); i++)
+    {
+        foreach (Universe* universe, universes)
+        {
+            if (universe->id() != values.at(i).first)
+                continue;
+
+            const QByteArray& preGM = values.at(i).second;
+            for (int ch = 0; ch < preGM.size() && ch < UNIVERSE_SIZE; ch++)
+                universe->write(ch, uchar(preGM.at(ch)), true);
+        }
+    }
+    m_doc->inputOutputMap()->releaseUniverses(true);
+    m_doc->inputOutputMap()->dumpUniverses();
+
+    /* Restart the functions where they were, including the time the
+     * application has been down, without fading in again */
+    qint64 gap = qMax(qint64(0), QDateTime::currentDateTime().toMSecsSinceEpoch() - timestamp);
+
+    foreach (const RunningFunction& rf, functions)
+    {
+        Function* function = m_doc->function(rf.id);
+        if (function == NULL)
+            continue;
+
+        Chaser* chaser = qobject_cast<Chaser*>(function);
+        if (chaser != NULL && rf.stepIndex >= 0)
+            chaser->setStepIndex(rf.stepIndex);
+
+        quint32 elapsed = quint32(qMin(qint64(rf.elapsed) + gap, qint64(UINT_MAX)));
+        foreach (FunctionParent parent, rf.parents)
+            function->start(m_doc->masterTimer(), parent, elapsed, 0);
+    }
+
+    return true;
+}
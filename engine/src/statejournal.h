@@ -0,0 +1,121 @@
+/*
+  Q Light Controller Plus
+  statejournal.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef STATEJOURNAL_H
+#define STATEJOURNAL_H
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QFile>
+
+class Doc;
+
+/** @addtogroup engine Engine
+ * @{
+ */
+
+/**
+ * StateJournal periodically records the live state of the engine (running
+ * functions with their elapsed time and chaser steps, and the universe
+ * values) into a memory mapped file, so that it survives a crash of the
+ * process. When the same workspace is loaded again, restore() writes the
+ * recorded values to the outputs right away and restarts the functions
+ * where they were.
+ *
+ * The file holds two slots written alternately, each one with a checksum,
+ * so that a slot being written during a crash is discarded in favour of
+ * the previous one. The journal is invalidated when the workspace is
+ * closed or the application quits cleanly.
+ *
+ * Journaling is disabled by default and enabled with the workspace/journal
+ * setting. The write interval in milliseconds is given by the
+ * workspace/journalinterval setting.
+ */
+class StateJournal : public QObject
+{
+    Q_OBJECT
+
+public:
+    StateJournal(Doc* doc, QObject* parent = 0);
+    ~StateJournal();
+
+    /** Return true if journaling is enabled in the settings */
+    bool isEnabled() const;
+
+    /** Return the default journal file, in the user data directory */
+    static QString defaultFileName();
+
+    /** Set the journal file. Must be called before start() */
+    void setFileName(const QString& fileName);
+
+    /** Set the file name of the workspace being loaded, or an empty string */
+    void setWorkspace(const QString& fileName);
+
+    /**
+     * Resume the state recorded for the current workspace, if any.
+     *
+     * @return true if a state has been restored
+     */
+    bool restore();
+
+    /** Start recording the state of the current workspace */
+    void start();
+
+    /** Stop recording and discard the recorded state. A state is
+     *  resumed only when the application has not been closed cleanly */
+    void stop();
+
+private:
+    /** Build the payload of a journal slot with the current state */
+    QByteArray snapshot();
+
+    /** Map the journal file with slots of at least $slotSize bytes */
+    bool map(quint32 slotSize);
+    void unmap();
+
+    /** Return the payload of the newest valid slot of $data */
+    static QByteArray newestPayload(const uchar* data, qint64 size);
+
+    /** Mark the journal as not restorable */
+    void invalidate();
+
+    /** Return an identifier of the workspace file contents */
+    static qint64 workspaceStamp(const QString& fileName);
+
+private slots:
+    void slotWrite();
+
+private:
+    Doc* m_doc;
+    bool m_enabled;
+    QString m_fileName;
+    QString m_workspace;
+
+    QTimer m_timer;
+    QFile m_file;
+    uchar* m_map;
+    quint32 m_slotSize;
+    quint32 m_sequence;
+};
+
+/** @} */
+
+#endif
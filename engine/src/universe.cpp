@@ -19,6 +19,7 @@
 
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
+#include <QMutexLocker>
 #include <QDebug>
 #include <math.h>
 
@@ -28,10 +29,12 @@
 #include "outputpatch.h"
 #include "grandmaster.h"
 #include "inputpatch.h"
+#include "qlctrace.h"
 #include "qlcmacros.h"
 #include "universe.h"
 #include "qlcfile.h"
 #include "utils.h"
+#include "valuemailbox.h"
 
 #define RELATIVE_ZERO 127
 
@@ -40,6 +43,33 @@
 #define KXMLUniverseAdditiveBlend "Additive"
 #define KXMLUniverseSubtractiveBlend "Subtractive"
 
+namespace
+{
+    /**
+     * Buffers shared by all the universes until they are written for the
+     * first time. Being implicitly shared, a universe gets its own copy of
+     * a buffer only when modifying it, so unused universes (e.g. the ones
+     * filling a gap between sparse universe IDs) cost nearly no memory.
+     */
+    const QByteArray& sharedZeroValues()
+    {
+        static const QByteArray values(UNIVERSE_SIZE, char(0));
+        return values;
+    }
+
+    const QVector<short>& sharedRelativeValues()
+    {
+        static const QVector<short> values(UNIVERSE_SIZE, 0);
+        return values;
+    }
+
+    const QVector<ChannelModifier*>& sharedModifiers()
+    {
+        static const QVector<ChannelModifier*> modifiers(UNIVERSE_SIZE, NULL);
+        return modifiers;
+    }
+}
+
 Universe::Universe(quint32 id, GrandMaster *gm, QObject *parent)
     : QObject(parent)
     , m_id(id)
@@ -49,20 +79,29 @@ Universe::Universe(quint32 id, GrandMaster *gm, QObject *parent)
     , m_inputPatch(NULL)
     , m_outputPatch(NULL)
     , m_fbPatch(NULL)
-    , m_channelsMask(new QByteArray(UNIVERSE_SIZE, char(0)))
-    , m_modifiedZeroValues(new QByteArray(UNIVERSE_SIZE, char(0)))
+    , m_channelsMask(new QByteArray(sharedZeroValues()))
+    , m_modifiers(sharedModifiers())
+    , m_modifiedZeroValues(new QByteArray(sharedZeroValues()))
     , m_usedChannels(0)
     , m_totalChannels(0)
     , m_totalChannelsChanged(false)
     , m_intensityChannelsChanged(false)
-    , m_preGMValues(new QByteArray(UNIVERSE_SIZE, char(0)))
-    , m_postGMValues(new QByteArray(UNIVERSE_SIZE, char(0)))
-    , m_lastPostGMValues(new QByteArray(UNIVERSE_SIZE, char(0)))
+    , m_preGMValues(new QByteArray(sharedZeroValues()))
+    , m_postGMValues(new QByteArray(sharedZeroValues()))
+    , m_lastPostGMValues(new QByteArray(sharedZeroValues()))
     , m_passthroughValues()
+    , m_relativeValues(sharedRelativeValues())
+    , m_hasRelativeValues(false)
+    , m_passthroughBypass(false)
+    , m_bypassActive(false)
+    , m_blackout(false)
+    , m_engineWritten(false)
+    , m_inputTimestampPending(false)
+    , m_inputTimestamp(0)
+    , m_inputLatencySamples(0)
+    , m_inputLatencyMax(0)
+    , m_inputLatencySum(0)
 {
-    m_relativeValues.fill(0, UNIVERSE_SIZE);
-    m_modifiers.fill(NULL, UNIVERSE_SIZE);
-
     m_name = QString("Universe %1").arg(id + 1);
 
     connect(m_grandMaster, SIGNAL(valueChanged(uchar)),
@@ -110,6 +149,12 @@ ushort Universe::totalChannels()
     return m_totalChannels;
 }
 
+bool Universe::isIdle() const
+{
+    return m_usedChannels == 0 && m_totalChannels == 0 && m_passthrough == false &&
+           m_inputPatch == NULL && m_outputPatch == NULL && m_fbPatch == NULL;
+}
+
 bool Universe::hasChanged()
 {
     bool changed =
@@ -185,17 +230,18 @@ void Universe::slotGMValueChanged()
 
 void Universe::reset()
 {
-    m_preGMValues->fill(0);
+    // go back to the shared buffers, releasing the written ones
+    (*m_preGMValues) = sharedZeroValues();
     if (m_passthrough)
     {
         (*m_postGMValues) = (*m_passthroughValues);
     }
     else
     {
-        m_postGMValues->fill(0);
+        (*m_postGMValues) = sharedZeroValues();
     }
     zeroRelativeValues();
-    m_modifiers.fill(NULL, UNIVERSE_SIZE);
+    m_modifiers = sharedModifiers();
     m_passthrough = false; // not releasing m_passthroughValues, see comment in setPassthrough
 }
 
@@ -221,7 +267,8 @@ void Universe::reset(int address, int range)
        range = UNIVERSE_SIZE - address;
 
     memset(m_preGMValues->data() + address, 0, range * sizeof(*m_preGMValues->data()));
-    memset(m_relativeValues.data() + address, 0, range * sizeof(*m_relativeValues.data()));
+    if (m_hasRelativeValues)
+        memset(m_relativeValues.data() + address, 0, range * sizeof(*m_relativeValues.data()));
     memcpy(m_postGMValues->data() + address, m_modifiedZeroValues->data() + address, range * sizeof(*m_postGMValues->data()));
 
     applyPassthroughValues(address, range);
@@ -266,7 +313,11 @@ const QByteArray* Universe::postGMValues() const
 
 void Universe::zeroRelativeValues()
 {
+    if (m_hasRelativeValues == false)
+        return;
+
     memset(m_relativeValues.data(), 0, UNIVERSE_SIZE * sizeof(*m_relativeValues.data()));
+    m_hasRelativeValues = false;
 }
 
 Universe::BlendMode Universe::stringToBlendMode(QString mode)
@@ -318,9 +369,10 @@ uchar Universe::preGMValue(int address) const
 
 uchar Universe::applyRelative(int channel, uchar value)
 {
-    if (m_relativeValues[channel] != 0)
+    // at() doesn't detach the shared buffer
+    if (m_relativeValues.at(channel) != 0)
     {
-        int val = m_relativeValues[channel] + value;
+        int val = m_relativeValues.at(channel) + value;
         return CLAMP(val, 0, (int)UCHAR_MAX);
     }
 
@@ -343,8 +395,9 @@ uchar Universe::applyGM(int channel, uchar value)
 
 uchar Universe::applyModifiers(int channel, uchar value)
 {
-    if (m_modifiers.at(channel) != NULL)
-        return m_modifiers.at(channel)->getValue(value);
+    ChannelModifier* modifier = m_modifiers.at(channel);
+    if (modifier != NULL)
+        return modifier->getValue(value);
 
     return value;
 }
@@ -363,7 +416,7 @@ uchar Universe::applyPassthrough(int channel, uchar value)
     return value;
 }
 
-void Universe::updatePostGMValue(int channel)
+uchar Universe::engineValue(int channel)
 {
     uchar value = preGMValue(channel);
 
@@ -379,7 +432,12 @@ void Universe::updatePostGMValue(int channel)
         value = applyModifiers(channel, value);
     }
 
-    value = applyPassthrough(channel, value);
+    return value;
+}
+
+void Universe::updatePostGMValue(int channel)
+{
+    uchar value = applyPassthrough(channel, engineValue(channel));
 
     (*m_postGMValues)[channel] = static_cast<char>(value);
 }
@@ -435,6 +493,10 @@ bool Universe::setOutputPatch(QLCIOPlugin *plugin, quint32 output)
 {
     qDebug() << "[Universe] setOutputPatch - ID:" << m_id
              << ", plugin:" << ((plugin == NULL)?"None":plugin->name()) << ", output:" << output;
+
+    // input frames might be forwarded to the output patch meanwhile
+    QMutexLocker locker(&m_bypassMutex);
+
     if (m_outputPatch == NULL)
     {
         if (plugin == NULL || output == QLCIOPlugin::invalidLine())
@@ -504,14 +566,40 @@ OutputPatch *Universe::feedbackPatch() const
 void Universe::dumpOutput(const QByteArray &data)
 {
     if (m_outputPatch == NULL)
+    {
+        // nothing reaches an output, so there's no latency to measure
+        m_inputTimestampPending = false;
         return;
+    }
 
     if (m_totalChannelsChanged == true)
     {
         m_outputPatch->setPluginParameter(PLUGIN_UNIVERSECHANNELS, m_totalChannels);
         m_totalChannelsChanged = false;
     }
+
+    QMutexLocker locker(&m_bypassMutex);
+
+    if (m_passthroughBypass == true && m_passthrough == true)
+    {
+        updateBypass();
+
+        // send the last received frame, which might be newer than the flushed input values
+        if (m_bypassActive == true && m_bypassInput.isEmpty() == false)
+        {
+            mergeBypassFrame();
+            m_outputPatch->dump(m_id, m_bypassOutput);
+
+            if (m_inputTimestampPending == true)
+                measureInputLatency();
+            return;
+        }
+    }
+
     m_outputPatch->dump(m_id, data);
+
+    if (m_inputTimestampPending == true)
+        measureInputLatency();
 }
 
 void Universe::flushInput()
@@ -528,8 +616,6 @@ void Universe::slotInputValueChanged(quint32 universe, quint32 channel, uchar va
     {
         if (universe == m_id)
         {
-            qDebug() << "write" << channel << value;
-
             if (channel >= UNIVERSE_SIZE)
                 return;
 
@@ -554,8 +640,14 @@ void Universe::connectInputPatch()
         connect(m_inputPatch, SIGNAL(inputValueChanged(quint32,quint32,uchar,const QString&)),
                 this, SIGNAL(inputValueChanged(quint32,quint32,uchar,QString)));
     else
+    {
         connect(m_inputPatch, SIGNAL(inputValueChanged(quint32,quint32,uchar,const QString&)),
                 this, SLOT(slotInputValueChanged(quint32,quint32,uchar,const QString&)));
+        // frames are forwarded from the thread of the input plugin
+        connect(m_inputPatch, SIGNAL(inputFrameReceived(quint32,QByteArray,quint32)),
+                this, SLOT(slotInputFrameReceived(quint32,QByteArray,quint32)),
+                Qt::DirectConnection);
+    }
 }
 
 void Universe::disconnectInputPatch()
@@ -567,8 +659,16 @@ void Universe::disconnectInputPatch()
         disconnect(m_inputPatch, SIGNAL(inputValueChanged(quint32,quint32,uchar,const QString&)),
                 this, SIGNAL(inputValueChanged(quint32,quint32,uchar,QString)));
     else
+    {
         disconnect(m_inputPatch, SIGNAL(inputValueChanged(quint32,quint32,uchar,const QString&)),
                 this, SLOT(slotInputValueChanged(quint32,quint32,uchar,const QString&)));
+        disconnect(m_inputPatch, SIGNAL(inputFrameReceived(quint32,QByteArray,quint32)),
+                   this, SLOT(slotInputFrameReceived(quint32,QByteArray,quint32)));
+
+        QMutexLocker locker(&m_bypassMutex);
+        m_bypassActive = false;
+        m_bypassInput.clear();
+    }
 }
 
 /************************************************************************
@@ -707,6 +807,7 @@ bool Universe::write(int channel, uchar value, bool forceLTP)
     }
 
     (*m_preGMValues)[channel] = char(value);
+    m_engineWritten = true;
 
     updatePostGMValue(channel);
 
@@ -720,10 +821,13 @@ bool Universe::writeRelative(int channel, uchar value)
     if (channel >= m_usedChannels)
         m_usedChannels = channel + 1;
 
+    m_engineWritten = true;
+
     if (value == RELATIVE_ZERO)
         return true;
 
     m_relativeValues[channel] += value - RELATIVE_ZERO;
+    m_hasRelativeValues = true;
 
     updatePostGMValue(channel);
 
@@ -735,6 +839,8 @@ bool Universe::writeBlended(int channel, uchar value, Universe::BlendMode blend)
     if (channel >= m_usedChannels)
         m_usedChannels = channel + 1;
 
+    m_engineWritten = true;
+
     switch (blend)
     {
         case NormalBlend:
@@ -781,6 +887,158 @@ bool Universe::writeBlended(int channel, uchar value, Universe::BlendMode blend)
     return true;
 }
 
+/*********************************************************************
+ * Passthrough bypass
+ *********************************************************************/
+
+void Universe::setPassthroughBypass(bool enable)
+{
+    QMutexLocker locker(&m_bypassMutex);
+
+    qDebug() << "Set universe" << id() << "passthrough bypass to" << enable;
+
+    m_passthroughBypass = enable;
+    m_bypassActive = false;
+    m_bypassInput.clear();
+}
+
+bool Universe::passthroughBypass() const
+{
+    return m_passthroughBypass;
+}
+
+void Universe::setBlackout(bool blackout)
+{
+    QMutexLocker locker(&m_bypassMutex);
+
+    m_blackout = blackout;
+    if (blackout == true)
+        m_bypassActive = false;
+}
+
+void Universe::slotInputFrameReceived(quint32 universe, const QByteArray &data, quint32 timestamp)
+{
+    if (universe != m_id || m_passthroughBypass == false)
+        return;
+
+    QMutexLocker locker(&m_bypassMutex);
+
+    m_bypassInput = data;
+
+    if (m_bypassActive == false || m_outputPatch == NULL)
+        return;
+
+    mergeBypassFrame();
+    m_outputPatch->dump(m_id, m_bypassOutput);
+
+    // unsigned arithmetic takes care of the clock wrapping around
+    quint32 latency = ValueMailbox::clock() - timestamp;
+    recordInputLatency(latency);
+
+#ifdef QLC_TRACING
+    QLCTrace::recordElapsed("Passthrough bypass latency", qint64(latency) * 1000, m_id);
+#endif
+}
+
+void Universe::updateBypass()
+{
+    bool active = m_engineWritten == false && m_blackout == false;
+    m_engineWritten = false;
+
+    if (active == true)
+    {
+        // the engine output doesn't change until a function writes the universe again
+        if (m_bypassBase.size() != m_usedChannels)
+            m_bypassBase.resize(m_usedChannels);
+
+        char *base = m_bypassBase.data();
+        for (int i = 0; i < m_usedChannels; i++)
+            base[i] = char(engineValue(i));
+    }
+
+    m_bypassActive = active;
+}
+
+void Universe::mergeBypassFrame()
+{
+    int size = qMax(m_bypassBase.size(), m_bypassInput.size());
+    if (m_bypassOutput.size() != size)
+        m_bypassOutput.resize(size);
+
+    const uchar *base = reinterpret_cast<const uchar *>(m_bypassBase.constData());
+    const uchar *input = reinterpret_cast<const uchar *>(m_bypassInput.constData());
+    uchar *output = reinterpret_cast<uchar *>(m_bypassOutput.data());
+    int baseSize = m_bypassBase.size();
+    int inputSize = m_bypassInput.size();
+
+    // HTP merge
+    for (int i = 0; i < size; i++)
+    {
+        uchar baseValue = i < baseSize ? base[i] : 0;
+        uchar inputValue = i < inputSize ? input[i] : 0;
+        output[i] = qMax(baseValue, inputValue);
+    }
+}
+
+/*********************************************************************
+ * Input latency
+ *********************************************************************/
+
+void Universe::markInputTimestamp(quint32 timestamp)
+{
+    if (m_inputTimestampPending == true)
+        return;
+
+    m_inputTimestamp = timestamp;
+    m_inputTimestampPending = true;
+}
+
+int Universe::inputLatencySamples() const
+{
+    return m_inputLatencySamples;
+}
+
+quint32 Universe::inputLatencyMax() const
+{
+    return m_inputLatencyMax;
+}
+
+quint32 Universe::inputLatencyAverage() const
+{
+    if (m_inputLatencySamples == 0)
+        return 0;
+
+    return quint32(m_inputLatencySum / quint64(m_inputLatencySamples));
+}
+
+void Universe::resetInputLatency()
+{
+    m_inputLatencySamples = 0;
+    m_inputLatencyMax = 0;
+    m_inputLatencySum = 0;
+}
+
+void Universe::measureInputLatency()
+{
+    // unsigned arithmetic takes care of the clock wrapping around
+    quint32 latency = ValueMailbox::clock() - m_inputTimestamp;
+    m_inputTimestampPending = false;
+
+    recordInputLatency(latency);
+
+#ifdef QLC_TRACING
+    QLCTrace::recordElapsed("Input latency", qint64(latency) * 1000, m_id);
+#endif
+}
+
+void Universe::recordInputLatency(quint32 latency)
+{
+    m_inputLatencySamples++;
+    m_inputLatencySum += latency;
+    if (latency > m_inputLatencyMax)
+        m_inputLatencyMax = latency;
+}
+
 /*********************************************************************
  * Load & Save
  *********************************************************************/
@@ -807,6 +1065,14 @@ bool Universe::loadXML(QXmlStreamReader &root, int index, InputOutputMap *ioMap)
             setPassthrough(false);
     }
 
+    if (attrs.hasAttribute(KXMLQLCUniversePassthroughBypass))
+    {
+        if (attrs.value(KXMLQLCUniversePassthroughBypass).toString() == KXMLQLCTrue)
+            setPassthroughBypass(true);
+        else
+            setPassthroughBypass(false);
+    }
+
     while (root.readNextStartElement())
     {
         qDebug() << "Universe tag:" << root.name();
@@ -942,6 +1208,9 @@ bool Universe::saveXML(QXmlStreamWriter *doc) const
     else
         doc->writeAttribute(KXMLQLCUniversePassthrough, KXMLQLCFalse);
 
+    if (passthroughBypass() == true)
+        doc->writeAttribute(KXMLQLCUniversePassthroughBypass, KXMLQLCTrue);
+
     if (inputPatch() != NULL)
     {
         doc->writeStartElement(KXMLQLCUniverseInputPatch);
@@ -23,6 +23,7 @@
 
 #include <QScopedPointer>
 #include <QByteArray>
+#include <QMutex>
 #include <QSet>
 
 #include "qlcchannel.h"
@@ -46,6 +47,7 @@ class InputPatch;
 #define KXMLQLCUniverseName "Name"
 #define KXMLQLCUniverseID "ID"
 #define KXMLQLCUniversePassthrough "Passthrough"
+#define KXMLQLCUniversePassthroughBypass "PassthroughBypass"
 
 #define KXMLQLCUniverseInputPatch "Input"
 #define KXMLQLCUniverseInputPlugin "Plugin"
@@ -130,6 +132,13 @@ public:
      */
     bool hasChanged();
 
+    /**
+     * Return true if this universe has never been written, has no
+     * channels defined and is not patched. Per-tick operations
+     * skip idle universes.
+     */
+    bool isIdle() const;
+
     /**
      * Enable or disable the passthrough mode for this universe
      */
@@ -170,6 +179,10 @@ protected:
     uchar applyRelative(int channel, uchar value);
     uchar applyModifiers(int channel, uchar value);
     uchar applyPassthrough(int channel, uchar value);
+
+    /** Return the value of $channel as written by the engine,
+     *  without the passthrough values */
+    uchar engineValue(int channel);
     void updatePostGMValue(int channel);
 
 signals:
@@ -404,6 +417,8 @@ protected:
     QScopedPointer<QByteArray> m_passthroughValues;
 
     QVector<short> m_relativeValues;
+    /** Flag set when m_relativeValues has non zero values, to avoid useless resets */
+    bool m_hasRelativeValues;
 
     /* impl speedup */
     void updateIntensityChannelsRanges();
@@ -464,6 +479,98 @@ public:
      */
     bool writeBlended(int channel, uchar value, BlendMode blend = NormalBlend);
 
+    /*********************************************************************
+     * Passthrough bypass
+     *********************************************************************/
+public:
+    /**
+     * Enable or disable the passthrough bypass. When the universe is in
+     * passthrough mode and no function is writing it, the DMX frames
+     * received by the input plugin are merged (HTP) with the engine output
+     * and forwarded to the output patch right away, from the input plugin
+     * thread, instead of waiting for the next MasterTimer tick.
+     * As soon as a function writes the universe, input values are merged
+     * on every tick as usual.
+     *
+     * Only input plugins emitting whole frames (see
+     * QLCIOPlugin::inputFrameReceived) are forwarded this way.
+     */
+    void setPassthroughBypass(bool enable);
+
+    /** Returns if the passthrough bypass is enabled */
+    bool passthroughBypass() const;
+
+    /** Stop forwarding input frames while a blackout is active */
+    void setBlackout(bool blackout);
+
+protected slots:
+    /** Slot called from the input plugin thread every time
+     *  the input patch receives a whole DMX frame */
+    void slotInputFrameReceived(quint32 universe, const QByteArray& data, quint32 timestamp);
+
+private:
+    /** Update the bypass state and the engine output it is merged with.
+     *  Called on every dump, with m_bypassMutex locked */
+    void updateBypass();
+
+    /** Merge the last input frame with the engine output into m_bypassOutput */
+    void mergeBypassFrame();
+
+private:
+    bool m_passthroughBypass;
+    /** Serializes the forwarded frames with the dumps of the MasterTimer */
+    QMutex m_bypassMutex;
+    /** True when frames can be forwarded right away */
+    bool m_bypassActive;
+    bool m_blackout;
+    /** Set by the write methods and reset on every dump, to know
+     *  if any function is writing this universe */
+    bool m_engineWritten;
+    /** The engine output without the passthrough values */
+    QByteArray m_bypassBase;
+    /** The last frame received by the input plugin */
+    QByteArray m_bypassInput;
+    /** The values forwarded to the output patch */
+    QByteArray m_bypassOutput;
+
+    /*********************************************************************
+     * Input latency
+     *********************************************************************/
+public:
+    /**
+     * Notify the universe that a value posted by a control at $timestamp
+     * (see ValueMailbox::clock()) has been written into it. The latency is
+     * measured when the universe is dumped to its output plugin.
+     * Only the oldest timestamp between two dumps is retained.
+     */
+    void markInputTimestamp(quint32 timestamp);
+
+    /** Return the number of latency samples measured since the last reset */
+    int inputLatencySamples() const;
+
+    /** Return the highest measured latency in microseconds */
+    quint32 inputLatencyMax() const;
+
+    /** Return the average measured latency in microseconds */
+    quint32 inputLatencyAverage() const;
+
+    /** Reset the latency statistics */
+    void resetInputLatency();
+
+private:
+    /** Measure the latency of the pending timestamp, if any */
+    void measureInputLatency();
+
+    /** Add a latency sample, in microseconds */
+    void recordInputLatency(quint32 latency);
+
+private:
+    bool m_inputTimestampPending;
+    quint32 m_inputTimestamp;
+    int m_inputLatencySamples;
+    quint32 m_inputLatencyMax;
+    quint64 m_inputLatencySum;
+
     /*********************************************************************
      * Load & Save
      *********************************************************************/
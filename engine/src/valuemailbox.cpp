@@ -0,0 +1,102 @@
+/*
+  Q Light Controller Plus
+  valuemailbox.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QElapsedTimer>
+
+#include "valuemailbox.h"
+
+namespace
+{
+    /** Started during static initialization, so clock() never races on it */
+    struct MailboxClock
+    {
+        MailboxClock() { timer.start(); }
+        QElapsedTimer timer;
+    };
+
+    MailboxClock s_clock;
+}
+
+ValueMailbox::ValueMailbox(quint32 value)
+    : m_value(int(value))
+    , m_sequence(0)
+    , m_timestamp(0)
+{
+}
+
+ValueMailbox::~ValueMailbox()
+{
+}
+
+/****************************************************************************
+ * Writer
+ ****************************************************************************/
+
+void ValueMailbox::post(quint32 value)
+{
+    m_value.fetchAndStoreRelease(int(value));
+    m_timestamp.fetchAndStoreRelease(int(clock()));
+    /* The sequence is incremented last: a reader seeing the new sequence
+     * is guaranteed to see the new value too */
+    m_sequence.fetchAndAddRelease(1);
+}
+
+void ValueMailbox::store(quint32 value)
+{
+    m_value.fetchAndStoreRelease(int(value));
+}
+
+/****************************************************************************
+ * Reader
+ ****************************************************************************/
+
+bool ValueMailbox::fetch(quint32 &value, int &sequence) const
+{
+    /* Read the sequence before the value. If the writer posts in between,
+     * the newer value is returned now and the sequence change is
+     * reported again at the next fetch, so no post is ever missed */
+    int current = this->sequence();
+    value = this->value();
+
+    if (current == sequence)
+        return false;
+
+    sequence = current;
+    return true;
+}
+
+quint32 ValueMailbox::value() const
+{
+    return quint32(const_cast<QAtomicInt&>(m_value).fetchAndAddAcquire(0));
+}
+
+int ValueMailbox::sequence() const
+{
+    return const_cast<QAtomicInt&>(m_sequence).fetchAndAddAcquire(0);
+}
+
+quint32 ValueMailbox::timestamp() const
+{
+    return quint32(const_cast<QAtomicInt&>(m_timestamp).fetchAndAddAcquire(0));
+}
+
+quint32 ValueMailbox::clock()
+{
+    return quint32(s_clock.timer.nsecsElapsed() / 1000);
+}
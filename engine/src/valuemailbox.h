@@ -0,0 +1,105 @@
+/*
+  Q Light Controller Plus
+  valuemailbox.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef VALUEMAILBOX_H
+#define VALUEMAILBOX_H
+
+#include <QAtomicInt>
+
+/** @addtogroup engine Engine
+ * @{
+ */
+
+/**
+ * ValueMailbox passes the latest value of a control (e.g. a Virtual Console
+ * slider) from the UI thread to the MasterTimer thread without locking.
+ *
+ * Only the most recent value is retained: intermediate values posted between
+ * two ticks are overwritten, so the engine always picks up the current control
+ * position at its next tick, regardless of how busy the UI thread is.
+ *
+ * Every post() increments a sequence number, which the reader compares with
+ * the last one it has seen to know if the value has changed. The time of the
+ * last post is retained as well, to measure the latency between a control
+ * movement and the moment the value is sent to an output plugin.
+ *
+ * The mailbox is meant to have a single writer and a single reader.
+ */
+class ValueMailbox
+{
+public:
+    ValueMailbox(quint32 value = 0);
+    ~ValueMailbox();
+
+private:
+    Q_DISABLE_COPY(ValueMailbox)
+
+    /************************************************************************
+     * Writer
+     ************************************************************************/
+public:
+    /** Post a new value and notify the reader that it has changed */
+    void post(quint32 value);
+
+    /**
+     * Replace the current value without notifying the reader.
+     * This is used when the control is following the engine output
+     * (e.g. channels monitoring) and nothing has to be written back.
+     */
+    void store(quint32 value);
+
+    /************************************************************************
+     * Reader
+     ************************************************************************/
+public:
+    /**
+     * Read the current value into $value.
+     *
+     * @param value The current value
+     * @param sequence The last sequence number seen by the reader.
+     *                 It is updated with the current one.
+     * @return true if a value has been posted since $sequence
+     */
+    bool fetch(quint32& value, int& sequence) const;
+
+    /** Return the current value */
+    quint32 value() const;
+
+    /** Return the current sequence number */
+    int sequence() const;
+
+    /** Return the clock() time of the last post() */
+    quint32 timestamp() const;
+
+    /**
+     * Return a monotonic time in microseconds, shared by all the mailboxes.
+     * The value wraps around every ~71 minutes, so only differences between
+     * two close timestamps are meaningful.
+     */
+    static quint32 clock();
+
+private:
+    QAtomicInt m_value;
+    QAtomicInt m_sequence;
+    QAtomicInt m_timestamp;
+};
+
+/** @} */
+
+#endif
@@ -411,3 +411,15 @@ void Video::postRun(MasterTimer* timer, QList<Universe*> universes)
     emit requestStop();
     Function::postRun(timer, universes);
 }
+
+void Video::preload(quint32 startTime)
+{
+    if (isRunning() == false)
+        emit requestPreload(startTime);
+}
+
+void Video::cancelPreload()
+{
+    if (isRunning() == false)
+        emit requestCancelPreload();
+}
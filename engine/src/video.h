@@ -174,6 +174,8 @@ signals:
     void totalTimeChanged(qint64);
     void metaDataChanged(QString key, QVariant data);
     void requestPlayback();
+    void requestPreload(quint32 startTime);
+    void requestCancelPreload();
     void requestPause(bool enable);
     void requestStop();
     void requestBrightnessAdjust(int value);
@@ -227,6 +229,11 @@ public:
     /** @reimpl */
     void postRun(MasterTimer* timer, QList<Universe *> universes);
 
+    /** @reimpl */
+    void preload(quint32 startTime);
+
+    /** @reimpl */
+    void cancelPreload();
 };
 
 /** @} */
@@ -0,0 +1,25 @@
+include(../../../variables.pri)
+include(../../../coverage.pri)
+TEMPLATE = app
+LANGUAGE = C++
+TARGET   = audiodecodermad_test
+
+QT      += testlib
+CONFIG  -= app_bundle
+
+greaterThan(QT_MAJOR_VERSION, 4) {
+    macx:QT_CONFIG -= no-pkg-config
+}
+CONFIG    += link_pkgconfig
+PKGCONFIG += mad
+
+# The decoder is a plugin, so its sources are built in the test
+INCLUDEPATH += ../../audio/src
+INCLUDEPATH += ../../audio/plugins/mad
+HEADERS += ../../audio/src/audiodecoder.h ../../audio/src/audioparameters.h
+SOURCES += ../../audio/src/audiodecoder.cpp ../../audio/src/audioparameters.cpp
+HEADERS += ../../audio/plugins/mad/audiodecoder_mad.h
+SOURCES += ../../audio/plugins/mad/audiodecoder_mad.cpp
+
+SOURCES += audiodecodermad_test.cpp
+HEADERS += audiodecodermad_test.h
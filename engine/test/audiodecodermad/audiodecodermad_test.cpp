@@ -0,0 +1,159 @@
+/*
+  Q Light Controller Plus - Unit test
+  audiodecodermad_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+
+#define private public
+#include "audiodecodermad_test.h"
+#include "audiodecoder_mad.h"
+#undef private
+
+/** MPEG 1 Layer III, 128kbps, 44.1kHz, mono, no CRC */
+#define FRAME_HEADER    "\xFF\xFB\x90\xC4"
+/** 144 * 128000 / 44100 bytes, without padding */
+#define FRAME_SIZE      417
+/** Samples per channel of a Layer III frame */
+#define FRAME_SAMPLES   1152
+#define FRAME_COUNT     100
+
+void AudioDecoderMAD_Test::initTestCase()
+{
+    m_dir = QDir::tempPath() + "/qlcplus_audiodecodermad_test";
+    QVERIFY(QDir().mkpath(m_dir) == true);
+    m_fileName = m_dir + "/silence.mp3";
+}
+
+void AudioDecoderMAD_Test::cleanupTestCase()
+{
+    QDir().rmdir(m_dir);
+}
+
+void AudioDecoderMAD_Test::init()
+{
+    writeMP3(FRAME_COUNT);
+}
+
+void AudioDecoderMAD_Test::cleanup()
+{
+    QFile::remove(m_fileName);
+    QFile::remove(m_fileName + ".qlcseek");
+}
+
+void AudioDecoderMAD_Test::writeMP3(int frames)
+{
+    QByteArray frame(FRAME_SIZE, 0);
+    frame.replace(0, 4, QByteArray(FRAME_HEADER, 4));
+
+    QFile file(m_fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate) == true);
+    for (int i = 0; i < frames; i++)
+        file.write(frame);
+
+    // libmad needs MAD_BUFFER_GUARD bytes after the last frame
+    file.write(QByteArray(MAD_BUFFER_GUARD, 0));
+    file.close();
+}
+
+void AudioDecoderMAD_Test::lazySeekIndex()
+{
+    AudioDecoderMAD decoder;
+    QVERIFY(decoder.initialize(m_fileName) == true);
+
+    // the file is not scanned when opened
+    QVERIFY(decoder.m_seekIndex.isEmpty() == true);
+    QVERIFY(decoder.m_seekIndexPending == true);
+    QVERIFY(QFile::exists(m_fileName + ".qlcseek") == false);
+
+    // rewinding doesn't need the index
+    decoder.seek(0);
+    QVERIFY(decoder.m_seekIndex.isEmpty() == true);
+    QVERIFY(decoder.m_seekIndexPending == true);
+
+    QSignalSpy spy(&decoder, SIGNAL(totalTimeChanged(qint64)));
+    decoder.seek(1000);
+    QVERIFY(decoder.m_seekIndexPending == false);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(decoder.m_seekIndex.count(), FRAME_COUNT);
+    for (int i = 0; i < FRAME_COUNT; i++)
+        QCOMPARE(decoder.m_seekIndex.at(i), quint32(i * FRAME_SIZE));
+    QCOMPARE(decoder.m_frameSamples, quint32(FRAME_SAMPLES));
+    QVERIFY(QFile::exists(m_fileName + ".qlcseek") == true);
+
+    // the index gives the exact duration
+    QCOMPARE(decoder.totalTime(), qint64(FRAME_COUNT) * FRAME_SAMPLES * 1000 / 44100);
+}
+
+void AudioDecoderMAD_Test::seekToFrame()
+{
+    AudioDecoderMAD decoder;
+    QVERIFY(decoder.initialize(m_fileName) == true);
+
+    // 1000ms is in frame 38. Decoding starts two frames earlier.
+    decoder.seek(1000);
+    QCOMPARE(decoder.m_input.pos(), qint64(36 * FRAME_SIZE));
+    QCOMPARE(decoder.m_skip_frames, 2);
+
+    // the first frames can't start earlier
+    decoder.seek(30);
+    QCOMPARE(decoder.m_input.pos(), qint64(0));
+    QCOMPARE(decoder.m_skip_frames, 1);
+
+    // past the end: the last frame
+    decoder.seek(60000);
+    QCOMPARE(decoder.m_input.pos(), qint64((FRAME_COUNT - 3) * FRAME_SIZE));
+    QCOMPARE(decoder.m_skip_frames, 2);
+}
+
+void AudioDecoderMAD_Test::loadSeekIndex()
+{
+    {
+        AudioDecoderMAD decoder;
+        QVERIFY(decoder.initialize(m_fileName) == true);
+        decoder.seek(1000);
+    }
+
+    // a saved index is loaded when opening the file
+    AudioDecoderMAD decoder;
+    QVERIFY(decoder.initialize(m_fileName) == true);
+    QVERIFY(decoder.m_seekIndexPending == false);
+    QCOMPARE(decoder.m_seekIndex.count(), FRAME_COUNT);
+    QCOMPARE(decoder.m_frameSamples, quint32(FRAME_SAMPLES));
+    QCOMPARE(decoder.totalTime(), qint64(FRAME_COUNT) * FRAME_SAMPLES * 1000 / 44100);
+}
+
+void AudioDecoderMAD_Test::staleSeekIndex()
+{
+    {
+        AudioDecoderMAD decoder;
+        QVERIFY(decoder.initialize(m_fileName) == true);
+        decoder.seek(1000);
+    }
+
+    // the audio file is replaced: the index is built again
+    writeMP3(FRAME_COUNT * 2);
+
+    AudioDecoderMAD decoder;
+    QVERIFY(decoder.initialize(m_fileName) == true);
+    QVERIFY(decoder.m_seekIndexPending == true);
+
+    decoder.seek(1000);
+    QCOMPARE(decoder.m_seekIndex.count(), FRAME_COUNT * 2);
+}
+
+QTEST_APPLESS_MAIN(AudioDecoderMAD_Test)
@@ -0,0 +1,6 @@
+#!/bin/sh
+# The MAD decoder is built only when libmad is available
+if [ ! -x ./audiodecodermad_test ]; then
+    exit 0
+fi
+./audiodecodermad_test
@@ -0,0 +1,16 @@
+include(../../../variables.pri)
+include(../../../coverage.pri)
+TEMPLATE = app
+LANGUAGE = C++
+TARGET   = audioprefetcher_test
+
+QT      += testlib
+CONFIG  -= app_bundle
+
+DEPENDPATH   += ../../audio/src
+INCLUDEPATH  += ../../audio/src
+QMAKE_LIBDIR += ../../audio/src
+LIBS         += -lqlcplusaudio
+
+SOURCES += audioprefetcher_test.cpp
+HEADERS += audioprefetcher_test.h
@@ -0,0 +1,209 @@
+/*
+  Q Light Controller Plus - Unit test
+  audioprefetcher_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+#include <QThread>
+
+#include "audioprefetcher_test.h"
+#include "audioprefetcher.h"
+
+/** Bytes of decoded audio per millisecond of the stub decoder */
+#define BYTES_PER_MS    100
+/** Larger than the prefetcher ring buffer, so that it wraps around */
+#define SOURCE_SIZE     (6000 * BYTES_PER_MS)
+/** Bytes returned by each read of the stub decoder, like an MP3 frame */
+#define FRAME_SIZE      4608
+
+namespace
+{
+    /** A decoder producing a known byte sequence */
+    class StubDecoder : public AudioDecoder
+    {
+    public:
+        StubDecoder()
+            : m_position(0)
+            , m_seekCount(0)
+            , m_seekThread(NULL)
+            , m_seekTotalTime(-1)
+        {
+            configure(44100, 2, PCM_S16LE);
+        }
+
+        static char byteAt(qint64 position)
+        {
+            return char(position % 251);
+        }
+
+        AudioDecoder *createCopy() { return new StubDecoder(); }
+        QStringList supportedFormats() { return QStringList() << "*.stub"; }
+        bool initialize(const QString &) { return true; }
+        qint64 totalTime() { return SOURCE_SIZE / BYTES_PER_MS; }
+        int bitrate() { return 1411; }
+
+        void seek(qint64 time)
+        {
+            m_position = qMin(time * BYTES_PER_MS, qint64(SOURCE_SIZE));
+            m_seekCount++;
+            m_seekThread = QThread::currentThread();
+
+            // like a decoder scanning the file on the first seek
+            if (m_seekTotalTime >= 0)
+                emit totalTimeChanged(m_seekTotalTime);
+        }
+
+        qint64 read(char *data, qint64 maxSize)
+        {
+            qint64 size = qMin(qMin(maxSize, qint64(FRAME_SIZE)), SOURCE_SIZE - m_position);
+            for (qint64 i = 0; i < size; i++)
+                data[i] = byteAt(m_position + i);
+            m_position += size;
+            return size;
+        }
+
+    public:
+        qint64 m_position;
+        int m_seekCount;
+        QThread* m_seekThread;
+        qint64 m_seekTotalTime;
+    };
+}
+
+qint64 AudioPrefetcher_Test::readAndCheck(AudioPrefetcher *prefetcher, qint64 position, qint64 maxBytes)
+{
+    char buffer[1000];
+    qint64 total = 0;
+
+    while (maxBytes < 0 || total < maxBytes)
+    {
+        qint64 size = prefetcher->read(buffer, sizeof(buffer));
+        if (size <= 0)
+            break;
+
+        for (qint64 i = 0; i < size; i++)
+        {
+            if (buffer[i] != StubDecoder::byteAt(position + total + i))
+                return -1;
+        }
+        total += size;
+    }
+
+    return total;
+}
+
+void AudioPrefetcher_Test::properties()
+{
+    StubDecoder source;
+    AudioPrefetcher prefetcher(&source);
+
+    QVERIFY(prefetcher.source() == &source);
+    QCOMPARE(prefetcher.totalTime(), qint64(6000));
+    QCOMPARE(prefetcher.audioParameters().sampleRate(), quint32(44100));
+    QCOMPARE(prefetcher.audioParameters().channels(), 2);
+    QCOMPARE(prefetcher.supportedFormats(), QStringList() << "*.stub");
+
+    // the source is initialized by its owner
+    QVERIFY(prefetcher.initialize("foo.stub") == true);
+}
+
+void AudioPrefetcher_Test::readAll()
+{
+    StubDecoder source;
+    AudioPrefetcher prefetcher(&source);
+
+    QCOMPARE(readAndCheck(&prefetcher, 0), qint64(SOURCE_SIZE));
+    QCOMPARE(prefetcher.bitrate(), 1411);
+
+    // the end of the stream doesn't block
+    char buffer[16];
+    QCOMPARE(prefetcher.read(buffer, sizeof(buffer)), qint64(0));
+}
+
+void AudioPrefetcher_Test::seek()
+{
+    StubDecoder source;
+    AudioPrefetcher prefetcher(&source);
+
+    QCOMPARE(readAndCheck(&prefetcher, 0, 10000), qint64(10000));
+
+    // data decoded ahead is discarded, and the source seeks on the worker
+    prefetcher.seek(2000);
+    qint64 read = readAndCheck(&prefetcher, 2000 * BYTES_PER_MS);
+    QCOMPARE(read, qint64(SOURCE_SIZE - 2000 * BYTES_PER_MS));
+    QCOMPARE(source.m_seekCount, 1);
+    QVERIFY(source.m_seekThread != NULL);
+    QVERIFY(source.m_seekThread != QThread::currentThread());
+
+    // seek back after the end of the stream
+    prefetcher.seek(0);
+    QCOMPARE(readAndCheck(&prefetcher, 0), qint64(SOURCE_SIZE));
+}
+
+void AudioPrefetcher_Test::seekTwice()
+{
+    StubDecoder source;
+    AudioPrefetcher prefetcher(&source);
+
+    // only the latest position is read
+    prefetcher.seek(1000);
+    prefetcher.seek(4000);
+    QCOMPARE(readAndCheck(&prefetcher, 4000 * BYTES_PER_MS),
+             qint64(SOURCE_SIZE - 4000 * BYTES_PER_MS));
+}
+
+void AudioPrefetcher_Test::seekPastEnd()
+{
+    StubDecoder source;
+    AudioPrefetcher prefetcher(&source);
+
+    prefetcher.seek(10000);
+    char buffer[16];
+    QCOMPARE(prefetcher.read(buffer, sizeof(buffer)), qint64(0));
+}
+
+void AudioPrefetcher_Test::destroyWhileFull()
+{
+    StubDecoder source;
+    AudioPrefetcher* prefetcher = new AudioPrefetcher(&source);
+
+    // let the worker fill the ring and wait for space
+    QTest::qWait(50);
+
+    // must not hang
+    delete prefetcher;
+    QVERIFY(source.m_position > 0);
+}
+
+void AudioPrefetcher_Test::totalTimeChanged()
+{
+    StubDecoder source;
+    source.m_seekTotalTime = 5800;
+    AudioPrefetcher prefetcher(&source);
+    QSignalSpy spy(&prefetcher, SIGNAL(totalTimeChanged(qint64)));
+
+    QCOMPARE(prefetcher.totalTime(), qint64(6000));
+
+    // once data is read at the new position, the seek is done
+    prefetcher.seek(1000);
+    QCOMPARE(readAndCheck(&prefetcher, 1000 * BYTES_PER_MS, 1000), qint64(1000));
+    QCOMPARE(prefetcher.totalTime(), qint64(5800));
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toLongLong(), qint64(5800));
+}
+
+QTEST_MAIN(AudioPrefetcher_Test)
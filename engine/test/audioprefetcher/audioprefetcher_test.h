@@ -0,0 +1,50 @@
+/*
+  Q Light Controller Plus - Unit test
+  audioprefetcher_test.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef AUDIOPREFETCHER_TEST_H
+#define AUDIOPREFETCHER_TEST_H
+
+#include <QObject>
+
+class AudioPrefetcher;
+
+class AudioPrefetcher_Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void properties();
+    void readAll();
+    void seek();
+    void seekTwice();
+    void seekPastEnd();
+    void destroyWhileFull();
+    void totalTimeChanged();
+
+private:
+    /**
+     * Read from $prefetcher until the end of the stream, checking that
+     * the data is the source data starting at $position.
+     *
+     * @return the number of bytes read
+     */
+    qint64 readAndCheck(AudioPrefetcher* prefetcher, qint64 position, qint64 maxBytes = -1);
+};
+
+#endif
@@ -0,0 +1,159 @@
+/*
+  Q Light Controller Plus - Unit test
+  channelvaluestore_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+
+#include "channelvaluestore_test.h"
+#include "channelvaluestore.h"
+
+void ChannelValueStore_Test::initial()
+{
+    ChannelValueStore store;
+    QVERIFY(store.isEmpty() == true);
+    QCOMPARE(store.count(), 0);
+    QVERIFY(store.contains(0) == false);
+    QCOMPARE(store.value(0), uchar(0));
+    QCOMPARE(store.value(0, 42), uchar(42));
+}
+
+void ChannelValueStore_Test::insertSorted()
+{
+    ChannelValueStore store;
+    store.insert(10, 1);
+    store.insert(2, 2);
+    store.insert(512, 3);
+    store.insert(7, 4);
+
+    QCOMPARE(store.count(), 4);
+    QCOMPARE(store.at(0).key, quint64(2));
+    QCOMPARE(store.at(1).key, quint64(7));
+    QCOMPARE(store.at(2).key, quint64(10));
+    QCOMPARE(store.at(3).key, quint64(512));
+
+    /* Replace an existing value */
+    store.insert(7, 100);
+    QCOMPARE(store.count(), 4);
+    QCOMPARE(store.value(7), uchar(100));
+    QVERIFY(store.contains(10) == true);
+    QVERIFY(store.contains(11) == false);
+}
+
+void ChannelValueStore_Test::remove()
+{
+    ChannelValueStore store;
+    store.insert(1, 1);
+    store.insert(2, 2);
+    store.insert(3, 3);
+
+    QVERIFY(store.remove(4) == false);
+    QCOMPARE(store.count(), 3);
+
+    QVERIFY(store.remove(2) == true);
+    QCOMPARE(store.count(), 2);
+    QCOMPARE(store.at(0).key, quint64(1));
+    QCOMPARE(store.at(1).key, quint64(3));
+
+    store.clear();
+    QVERIFY(store.isEmpty() == true);
+}
+
+void ChannelValueStore_Test::sharing()
+{
+    ChannelValueStore store;
+    store.insert(1, 10);
+    store.insert(2, 20);
+
+    ChannelValueStore copy(store);
+    QVERIFY(copy == store);
+
+    /* Modifying the copy must not affect the original */
+    copy.insert(1, 11);
+    copy.insert(3, 30);
+    QVERIFY(copy != store);
+    QCOMPARE(store.count(), 2);
+    QCOMPARE(store.value(1), uchar(10));
+    QCOMPARE(copy.count(), 3);
+    QCOMPARE(copy.value(1), uchar(11));
+
+    ChannelValueStore assigned;
+    assigned = store;
+    QVERIFY(assigned == store);
+    store.clear();
+    QCOMPARE(assigned.count(), 2);
+}
+
+void ChannelValueStore_Test::sceneValues()
+{
+    QList<SceneValue> list;
+    list << SceneValue(4, 5, 6);
+    list << SceneValue(1, 2, 3);
+    list << SceneValue(1, 0, 7);
+
+    ChannelValueStore store = ChannelValueStore::fromSceneValues(list);
+    QCOMPARE(store.count(), 3);
+    QVERIFY(store.contains(ChannelValueStore::sceneKey(1, 2)) == true);
+    QVERIFY(store.contains(ChannelValueStore::sceneKey(2, 1)) == false);
+
+    /* Values must come back in SceneValue order */
+    QList<SceneValue> sorted = store.toSceneValues();
+    QCOMPARE(sorted.count(), 3);
+    QVERIFY(sorted.at(0) == SceneValue(1, 0));
+    QCOMPARE(sorted.at(0).value, uchar(7));
+    QVERIFY(sorted.at(1) == SceneValue(1, 2));
+    QCOMPARE(sorted.at(1).value, uchar(3));
+    QVERIFY(sorted.at(2) == SceneValue(4, 5));
+    QCOMPARE(sorted.at(2).value, uchar(6));
+
+    quint64 key = ChannelValueStore::sceneKey(31337, 5150);
+    QCOMPARE(ChannelValueStore::sceneKeyFixture(key), quint32(31337));
+    QCOMPARE(ChannelValueStore::sceneKeyChannel(key), quint32(5150));
+}
+
+void ChannelValueStore_Test::removeFixture()
+{
+    ChannelValueStore store;
+    store.insert(SceneValue(1, 0, 1));
+    store.insert(SceneValue(2, 0, 2));
+    store.insert(SceneValue(2, 1, 3));
+    store.insert(SceneValue(3, 0, 4));
+
+    QCOMPARE(store.removeFixture(5), 0);
+    QCOMPARE(store.removeFixture(2), 2);
+    QCOMPARE(store.count(), 2);
+    QCOMPARE(ChannelValueStore::sceneKeyFixture(store.at(0).key), quint32(1));
+    QCOMPARE(ChannelValueStore::sceneKeyFixture(store.at(1).key), quint32(3));
+}
+
+void ChannelValueStore_Test::hash()
+{
+    QHash<uint, uchar> values;
+    values[932] = 5;
+    values[0] = 14;
+    values[5] = 255;
+
+    ChannelValueStore store = ChannelValueStore::fromHash(values);
+    QCOMPARE(store.count(), 3);
+    QCOMPARE(store.at(0).key, quint64(0));
+    QCOMPARE(store.at(1).key, quint64(5));
+    QCOMPARE(store.at(2).key, quint64(932));
+
+    QVERIFY(store.toHash() == values);
+}
+
+QTEST_APPLESS_MAIN(ChannelValueStore_Test)
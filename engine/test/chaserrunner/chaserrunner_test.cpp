@@ -41,6 +41,33 @@
 
 #include "../common/resource_paths.h"
 
+/** A scene counting the preload requests of the runner */
+class PreloadScene : public Scene
+{
+public:
+    PreloadScene(Doc* doc)
+        : Scene(doc)
+        , m_preloads(0)
+        , m_cancels(0)
+    {
+    }
+
+    void preload(quint32 startTime)
+    {
+        Q_UNUSED(startTime);
+        m_preloads++;
+    }
+
+    void cancelPreload()
+    {
+        m_cancels++;
+    }
+
+public:
+    int m_preloads;
+    int m_cancels;
+};
+
 void ChaserRunner_Test::initTestCase()
 {
     m_doc = new Doc(this);
@@ -1372,4 +1399,96 @@ void ChaserRunner_Test::adjustIntensity()
     QCOMPARE(m_scene3->getAttributeValue(Function::Intensity), qreal(1.0));
 }
 
+Chaser* ChaserRunner_Test::createPreloadChaser(QList<PreloadScene*>& scenes)
+{
+    Chaser* chaser = new Chaser(m_doc);
+    for (int i = 0; i < 3; i++)
+    {
+        PreloadScene* scene = new PreloadScene(m_doc);
+        m_doc->addFunction(scene);
+        chaser->addStep(ChaserStep(scene->id()));
+        scenes.append(scene);
+    }
+    chaser->setDirection(Function::Forward);
+    chaser->setRunOrder(Function::Loop);
+    chaser->setDuration(MasterTimer::mediaPreroll() * 2);
+    m_doc->addFunction(chaser);
+
+    return chaser;
+}
+
+void ChaserRunner_Test::preloadNextStep()
+{
+    QList<PreloadScene*> scenes;
+    Chaser* chaser = createPreloadChaser(scenes);
+    uint dur = chaser->duration();
+
+    ChaserRunner cr(m_doc, chaser);
+    MasterTimer timer(m_doc);
+
+    /* The next step is preloaded once the current one is about to end */
+    uint elapsed = 0;
+    while (scenes[1]->m_preloads == 0)
+    {
+        QVERIFY(cr.write(&timer, QList<Universe*>()) == true);
+        timer.timerTick();
+        elapsed += MasterTimer::tick();
+        QVERIFY(elapsed < dur);
+    }
+    QVERIFY(elapsed + MasterTimer::mediaPreroll() >= dur);
+    QCOMPARE(timer.m_functionList.size(), 1);
+    QCOMPARE(timer.m_functionList[0], scenes[0]);
+    QVERIFY(cr.m_preloadFunction == scenes[1]);
+
+    /* Only once, and the preloaded function is started as the next step */
+    while (timer.m_functionList.contains(scenes[1]) == false)
+    {
+        QVERIFY(cr.write(&timer, QList<Universe*>()) == true);
+        timer.timerTick();
+        elapsed += MasterTimer::tick();
+        QVERIFY(elapsed <= dur + MasterTimer::tick());
+    }
+    QCOMPARE(scenes[1]->m_preloads, 1);
+    QCOMPARE(scenes[1]->m_cancels, 0);
+    QVERIFY(cr.m_preloadFunction == NULL);
+    QCOMPARE(scenes[0]->m_preloads, 0);
+    QCOMPARE(scenes[2]->m_preloads, 0);
+
+    cr.postRun(&timer, QList<Universe*>());
+}
+
+void ChaserRunner_Test::cancelPreload()
+{
+    QList<PreloadScene*> scenes;
+    Chaser* chaser = createPreloadChaser(scenes);
+
+    ChaserRunner cr(m_doc, chaser);
+    MasterTimer timer(m_doc);
+
+    while (scenes[1]->m_preloads == 0)
+    {
+        QVERIFY(cr.write(&timer, QList<Universe*>()) == true);
+        timer.timerTick();
+    }
+
+    /* Jumping to another step releases the preloaded one */
+    cr.setCurrentStep(2);
+    QVERIFY(cr.write(&timer, QList<Universe*>()) == true);
+    timer.timerTick();
+    QVERIFY(timer.m_functionList.contains(scenes[2]) == true);
+    QCOMPARE(scenes[1]->m_cancels, 1);
+    QVERIFY(cr.m_preloadFunction == NULL);
+
+    /* So does stopping */
+    while (scenes[0]->m_preloads == 0)
+    {
+        QVERIFY(cr.write(&timer, QList<Universe*>()) == true);
+        timer.timerTick();
+    }
+    QCOMPARE(scenes[0]->m_cancels, 0);
+    cr.postRun(&timer, QList<Universe*>());
+    QCOMPARE(scenes[0]->m_cancels, 1);
+    QVERIFY(cr.m_preloadFunction == NULL);
+}
+
 QTEST_APPLESS_MAIN(ChaserRunner_Test)
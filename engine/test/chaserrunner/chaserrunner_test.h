@@ -21,8 +21,10 @@
 #define CHASERRUNNER_TEST_H
 
 #include <QObject>
+#include <QList>
 #include "qlcfixturedefcache.h"
 
+class PreloadScene;
 class Chaser;
 class Scene;
 class Doc;
@@ -68,6 +70,13 @@ private slots:
 
     void adjustIntensity();
 
+    void preloadNextStep();
+    void cancelPreload();
+
+private:
+    /** Create a looping chaser of three scenes counting their preloads */
+    Chaser* createPreloadChaser(QList<PreloadScene*>& scenes);
+
 private:
     Doc* m_doc;
     Scene* m_scene1;
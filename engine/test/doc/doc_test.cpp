@@ -140,8 +140,9 @@ void Doc_Test::createFixtureId()
     for (quint32 i = 0; i < 16384; i++)
     {
         quint32 id = m_doc->createFixtureId();
-        m_doc->m_fixtures[i] = new Fixture(m_doc);
-        m_doc->m_fixtures[i]->setID(id);
+        Fixture* fxi = new Fixture(m_doc);
+        fxi->setID(id);
+        m_doc->m_fixtures.insert(id, fxi);
         QCOMPARE(id, i);
     }
 }
@@ -636,6 +637,65 @@ void Doc_Test::load()
     QVERIFY(Bus::instance()->value(31) == 500);
 }
 
+void Doc_Test::loadManyFunctions()
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly | QIODevice::Text);
+    QXmlStreamWriter xmlWriter(&buffer);
+
+    xmlWriter.writeStartElement("Engine");
+
+    /* Enough functions to be loaded by the thread pool, in two batches
+     * separated by another tag. Each one contains the previous one. */
+    QList <quint32> ids;
+    for (quint32 i = 0; i < 48; i++)
+    {
+        if (i == 32)
+        {
+            createFixtureNode(xmlWriter, 0, m_currentAddr, 18);
+            m_currentAddr += 18;
+        }
+
+        quint32 id = (i < 32) ? 100 + i : 200 + i;
+        xmlWriter.writeStartElement("Function");
+        xmlWriter.writeAttribute("Type", "Collection");
+        xmlWriter.writeAttribute("ID", QString::number(id));
+        if (ids.isEmpty() == false)
+            xmlWriter.writeTextElement("Step", QString::number(ids.last()));
+        xmlWriter.writeEndElement();
+
+        ids.append(id);
+    }
+
+    xmlWriter.writeEndDocument();
+    xmlWriter.setDevice(NULL);
+    buffer.close();
+
+    buffer.open(QIODevice::ReadOnly | QIODevice::Text);
+    QXmlStreamReader xmlReader(&buffer);
+    xmlReader.readNextStartElement();
+
+    QVERIFY(m_doc->loadXML(xmlReader) == true);
+    QVERIFY(m_doc->fixtures().size() == 1);
+    QVERIFY(m_doc->functions().size() == 48);
+
+    for (int i = 0; i < ids.count(); i++)
+    {
+        Collection* coll = qobject_cast<Collection*> (m_doc->function(ids.at(i)));
+        QVERIFY(coll != NULL);
+        QCOMPARE(coll->id(), ids.at(i));
+        if (i == 0)
+        {
+            QCOMPARE(coll->functions().count(), 0);
+        }
+        else
+        {
+            QCOMPARE(coll->functions().count(), 1);
+            QCOMPARE(coll->functions().at(0).toUInt(), ids.at(i - 1));
+        }
+    }
+}
+
 void Doc_Test::loadWrongRoot()
 {
     QBuffer buffer;
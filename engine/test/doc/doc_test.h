@@ -55,6 +55,7 @@ private slots:
     void function();
 
     void load();
+    void loadManyFunctions();
     void loadWrongRoot();
     void save();
 
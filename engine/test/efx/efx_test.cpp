@@ -30,6 +30,7 @@
 #include "qlcfixturedef.h"
 #include "genericfader.h"
 #include "efxfixture.h"
+#include "efxpreview.h"
 #include "qlcchannel.h"
 #include "universe.h"
 #include "efx_test.h"
@@ -2043,6 +2044,78 @@ void EFX_Test::previewLissajousBackwards()
     }
 }
 
+void EFX_Test::previewGeometryKey()
+{
+    EFX e(m_doc);
+    QByteArray key = EFXPreview::geometryKey(&e);
+    QCOMPARE(EFXPreview::geometryKey(&e), key);
+
+    e.setWidth(10);
+    QVERIFY(EFXPreview::geometryKey(&e) != key);
+    e.setWidth(127);
+    QCOMPARE(EFXPreview::geometryKey(&e), key);
+
+    /* Fixture direction and offset change their paths */
+    EFXFixture* ef = new EFXFixture(&e);
+    ef->setHead(GroupHead(0, 0));
+    e.addFixture(ef);
+    key = EFXPreview::geometryKey(&e);
+    ef->setStartOffset(90);
+    QVERIFY(EFXPreview::geometryKey(&e) != key);
+}
+
+void EFX_Test::previewWorker()
+{
+    EFX e(m_doc);
+    e.setAlgorithm(EFX::Eight);
+    EFXFixture* ef = new EFXFixture(&e);
+    ef->setHead(GroupHead(0, 0));
+    ef->setStartOffset(45);
+    e.addFixture(ef);
+
+    QPolygonF expected;
+    QVector <QPolygonF> expectedFixtures;
+    e.preview(expected);
+    e.previewFixtures(expectedFixtures);
+
+    int docChildren = m_doc->children().count();
+
+    EFXPreview preview;
+    QPolygonF poly;
+    QVector <QPolygonF> fixtures;
+
+    /* Not cached yet: computed by the worker */
+    QCOMPARE(preview.request(&e, poly, fixtures), false);
+    bool ready = false;
+    for (int i = 0; i < 100 && ready == false; i++)
+    {
+        ready = preview.takeGeometry(poly, fixtures);
+        if (ready == false)
+            QTest::qSleep(10);
+    }
+    QVERIFY(ready == true);
+    QCOMPARE(poly, expected);
+    QCOMPARE(fixtures, expectedFixtures);
+
+    /* Taken only once */
+    QCOMPARE(preview.takeGeometry(poly, fixtures), false);
+
+    /* Cached: returned immediately */
+    poly.clear();
+    fixtures.clear();
+    QCOMPARE(preview.request(&e, poly, fixtures), true);
+    QCOMPARE(poly, expected);
+    QCOMPARE(fixtures, expectedFixtures);
+
+    /* Copies given to the worker are not parented to the Doc */
+    QCOMPARE(m_doc->children().count(), docChildren);
+
+    /* A pending copy is not parented either, and is freed with the preview */
+    e.setWidth(10);
+    QCOMPARE(preview.request(&e, poly, fixtures), false);
+    QCOMPARE(m_doc->children().count(), docChildren);
+}
+
 void EFX_Test::widthHeightOffset()
 {
     EFX e(m_doc);
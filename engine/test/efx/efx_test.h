@@ -68,6 +68,9 @@ private slots:
     void previewLeafBackwards();
     void previewLissajousBackwards();
 
+    void previewGeometryKey();
+    void previewWorker();
+
     void rotateAndScale();
     void widthHeightOffset();
 
@@ -336,4 +336,34 @@ void FadeChannel_Test::calculateCurrent()
     QCOMPARE(fch.calculateCurrent(200, 200), uchar(101));
 }
 
+void FadeChannel_Test::calculateCurrent16bit()
+{
+    FadeChannel fch;
+    fch.setStart(0x10);
+    fch.setTarget(0x11);
+    fch.setCurrent(0x10);
+    QVERIFY(fch.is16Bit() == false);
+
+    // Couple the fine values: fade from 0x10FF to 0x1101
+    fch.setLsbValues(0xFF, 0x01, 0xFF);
+    QVERIFY(fch.is16Bit() == true);
+    QCOMPARE(fch.start(), uchar(0x10));
+    QCOMPARE(fch.startLsb(), uchar(0xFF));
+    QCOMPARE(fch.target(), uchar(0x11));
+    QCOMPARE(fch.targetLsb(), uchar(0x01));
+
+    // The fine byte must not fade backwards while the coarse byte steps
+    QCOMPARE(fch.calculateCurrent(2, 0), uchar(0x10));
+    QCOMPARE(fch.currentLsb(), uchar(0xFF));
+    QCOMPARE(fch.calculateCurrent(2, 1), uchar(0x11));
+    QCOMPARE(fch.currentLsb(), uchar(0x00));
+    QCOMPARE(fch.calculateCurrent(2, 2), uchar(0x11));
+    QCOMPARE(fch.currentLsb(), uchar(0x01));
+
+    // Setting the MSB retains the LSB part
+    fch.setTarget(0x20);
+    QCOMPARE(fch.target(), uchar(0x20));
+    QCOMPARE(fch.targetLsb(), uchar(0x01));
+}
+
 QTEST_APPLESS_MAIN(FadeChannel_Test)
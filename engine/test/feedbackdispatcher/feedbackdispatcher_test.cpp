@@ -0,0 +1,169 @@
+/*
+  Q Light Controller Plus - Unit test
+  feedbackdispatcher_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+
+#define private public
+#include "feedbackdispatcher_test.h"
+#include "feedbackdispatcher.h"
+#include "qlcioplugin.h"
+#undef private
+
+/* The plugin is never dereferenced while batches are taken by hand */
+#define PLUGIN reinterpret_cast<QLCIOPlugin*>(0x1)
+
+/* Stop the worker, so that batches can be taken by the test */
+static void stopWorker(FeedbackDispatcher& fd)
+{
+    {
+        QMutexLocker locker(&fd.m_mutex);
+        fd.m_exit = true;
+        fd.m_condition.wakeAll();
+    }
+    fd.wait();
+    FeedbackDispatcher::s_interval = 20;
+}
+
+void FeedbackDispatcher_Test::latestValueWins()
+{
+    FeedbackDispatcher fd;
+    stopWorker(fd);
+
+    fd.post(PLUGIN, 0, 0, 1, 100, QString());
+    fd.post(PLUGIN, 0, 0, 1, 120, QString());
+    fd.post(PLUGIN, 0, 0, 2, 10, QString());
+    QCOMPARE(fd.m_pending.count(), 2);
+
+    QList<FeedbackDispatcher::Feedback> batch;
+    QCOMPARE(fd.takeBatch(batch), qint64(-1));
+    QCOMPARE(batch.count(), 2);
+    QVERIFY(fd.m_pending.isEmpty());
+    QCOMPARE(fd.m_sent.value(FeedbackDispatcher::channelKey(0, 1)), uchar(120));
+    QCOMPARE(fd.m_sent.value(FeedbackDispatcher::channelKey(0, 2)), uchar(10));
+}
+
+void FeedbackDispatcher_Test::sameValueDiscarded()
+{
+    FeedbackDispatcher fd;
+    stopWorker(fd);
+
+    QList<FeedbackDispatcher::Feedback> batch;
+    fd.post(PLUGIN, 0, 0, 1, 100, QString());
+    fd.takeBatch(batch);
+    QCOMPARE(batch.count(), 1);
+
+    // already shown by the device
+    fd.post(PLUGIN, 0, 0, 1, 100, QString());
+    QVERIFY(fd.m_pending.isEmpty());
+
+    // changed and then restored before being sent
+    fd.post(PLUGIN, 0, 0, 1, 50, QString());
+    fd.post(PLUGIN, 0, 0, 1, 100, QString());
+    QCOMPARE(fd.m_pending.count(), 1);
+
+    fd.m_nextBatch.clear();
+    batch.clear();
+    fd.takeBatch(batch);
+    QVERIFY(batch.isEmpty());
+    QVERIFY(fd.m_pending.isEmpty());
+}
+
+void FeedbackDispatcher_Test::rateLimit()
+{
+    FeedbackDispatcher fd;
+    stopWorker(fd);
+
+    QLCIOPlugin* other = reinterpret_cast<QLCIOPlugin*>(0x2);
+    QList<FeedbackDispatcher::Feedback> batch;
+
+    fd.post(PLUGIN, 0, 0, 1, 100, QString());
+    fd.takeBatch(batch);
+    QCOMPARE(batch.count(), 1);
+
+    // the same device must wait for the interval
+    batch.clear();
+    fd.post(PLUGIN, 0, 0, 1, 110, QString());
+    fd.post(other, 0, 1, 1, 30, QString());
+    qint64 wait = fd.takeBatch(batch);
+    QVERIFY(wait > 0 && wait <= qint64(FeedbackDispatcher::interval()));
+    QCOMPARE(batch.count(), 1);
+    QVERIFY(batch.at(0).plugin == other);
+    QCOMPARE(fd.m_pending.count(), 1);
+
+    QTest::qSleep(FeedbackDispatcher::interval() + 5);
+
+    batch.clear();
+    fd.takeBatch(batch);
+    QCOMPARE(batch.count(), 1);
+    QCOMPARE(batch.at(0).value, uchar(110));
+}
+
+void FeedbackDispatcher_Test::reset()
+{
+    FeedbackDispatcher fd;
+    stopWorker(fd);
+
+    QList<FeedbackDispatcher::Feedback> batch;
+    fd.post(PLUGIN, 0, 0, 1, 100, QString());
+    fd.post(PLUGIN, 0, 1, 1, 100, QString());
+    fd.takeBatch(batch);
+    QCOMPARE(batch.count(), 2);
+
+    fd.reset(0, PLUGIN, 0);
+    QCOMPARE(fd.m_sent.count(), 1);
+
+    // sent again to the new feedback patch
+    fd.post(PLUGIN, 0, 0, 1, 100, QString());
+    fd.post(PLUGIN, 0, 1, 1, 100, QString());
+    QCOMPARE(fd.m_pending.count(), 1);
+}
+
+void FeedbackDispatcher_Test::resetDropsStale()
+{
+    FeedbackDispatcher fd;
+    stopWorker(fd);
+
+    QLCIOPlugin* other = reinterpret_cast<QLCIOPlugin*>(0x2);
+
+    fd.post(PLUGIN, 0, 0, 1, 100, QString());
+    fd.post(PLUGIN, 0, 0, 2, 100, QString());
+    fd.post(PLUGIN, 0, 1, 1, 100, QString());
+    QCOMPARE(fd.m_pending.count(), 3);
+
+    // the same patch: pending values are kept
+    fd.reset(0, PLUGIN, 0);
+    QCOMPARE(fd.m_pending.count(), 3);
+
+    // another line: the values of universe 0 are dropped
+    fd.reset(0, PLUGIN, 1);
+    QCOMPARE(fd.m_pending.count(), 1);
+    QVERIFY(fd.m_pending.contains(FeedbackDispatcher::channelKey(1, 1)));
+
+    // another plugin
+    fd.post(PLUGIN, 0, 1, 2, 50, QString());
+    fd.reset(1, other, 0);
+    QVERIFY(fd.m_pending.isEmpty());
+
+    // no feedback patch anymore
+    fd.post(PLUGIN, 0, 0, 1, 100, QString());
+    fd.reset(0, NULL, QLCIOPlugin::invalidLine());
+    QVERIFY(fd.m_pending.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(FeedbackDispatcher_Test)
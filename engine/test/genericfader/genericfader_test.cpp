@@ -212,4 +212,85 @@ void GenericFader_Test::adjustIntensity()
     }
 }
 
+void GenericFader_Test::couple16Bit()
+{
+    QLCFixtureDef* def = new QLCFixtureDef();
+    def->setManufacturer("Foo");
+    def->setModel("Bar");
+
+    QLCChannel* pan = new QLCChannel();
+    pan->setName("Pan");
+    pan->setGroup(QLCChannel::Pan);
+    pan->setControlByte(QLCChannel::MSB);
+    def->addChannel(pan);
+
+    QLCChannel* panFine = new QLCChannel();
+    panFine->setName("Pan fine");
+    panFine->setGroup(QLCChannel::Pan);
+    panFine->setControlByte(QLCChannel::LSB);
+    def->addChannel(panFine);
+
+    QLCFixtureMode* mode = new QLCFixtureMode(def);
+    mode->setName("16 bit");
+    mode->insertChannel(pan, 0);
+    mode->insertChannel(panFine, 1);
+    def->addMode(mode);
+
+    Fixture* fxi = new Fixture(m_doc);
+    fxi->setFixtureDefinition(def, mode);
+    fxi->setAddress(100);
+    QVERIFY(m_doc->addFixture(fxi) == true);
+    QCOMPARE(fxi->channelLsbPair(0), quint32(1));
+    QCOMPARE(fxi->channelMsbPair(1), quint32(0));
+
+    QList<Universe*> ua;
+    ua.append(new Universe(0, new GrandMaster()));
+    GenericFader fader(m_doc);
+
+    FadeChannel msb(m_doc, fxi->id(), 0);
+    msb.setStart(0x10);
+    msb.setCurrent(0x10);
+    msb.setTarget(0x11);
+    msb.setFadeTime(1000);
+
+    FadeChannel lsb(m_doc, fxi->id(), 1);
+    lsb.setStart(0xFF);
+    lsb.setCurrent(0xFF);
+    lsb.setTarget(0x01);
+    lsb.setFadeTime(1000);
+
+    /* The LSB stays visible, coupled to the MSB */
+    fader.add(lsb);
+    fader.add(msb);
+    QCOMPARE(fader.channels().count(), 2);
+    QVERIFY(fader.m_channels[lsb].isCoupled() == true);
+    QVERIFY(fader.m_channels[msb].is16Bit() == true);
+    QCOMPARE(fader.m_channels[msb].targetLsb(), uchar(0x01));
+
+    /* HTP check on the LSB: a lower value is discarded */
+    FadeChannel lower(lsb);
+    lower.setCurrent(0x80);
+    lower.setTarget(0x80);
+    fader.add(lower);
+    QCOMPARE(fader.m_channels[lsb].target(), uchar(0x01));
+    QCOMPARE(fader.m_channels[msb].targetLsb(), uchar(0x01));
+
+    /* The MSB writes both values and keeps the LSB in sync */
+    fader.write(ua);
+    uchar fine = fader.m_channels[msb].currentLsb();
+    QCOMPARE(uchar(ua[0]->preGMValues()[101]), fine);
+    QCOMPARE(fader.m_channels[lsb].current(), fine);
+
+    /* Removing the MSB lets the LSB fade on its own */
+    fader.remove(msb);
+    QCOMPARE(fader.channels().count(), 1);
+    QVERIFY(fader.m_channels[lsb].isCoupled() == false);
+
+    fader.add(msb);
+    QVERIFY(fader.m_channels[lsb].isCoupled() == true);
+    fader.remove(lsb);
+    QVERIFY(fader.m_channels[msb].is16Bit() == false);
+    QCOMPARE(fader.m_channels[msb].target(), uchar(0x11));
+}
+
 QTEST_APPLESS_MAIN(GenericFader_Test)
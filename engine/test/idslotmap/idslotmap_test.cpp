@@ -0,0 +1,110 @@
+/*
+  Q Light Controller Plus - Unit test
+  idslotmap_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+
+#define private public
+#include "idslotmap_test.h"
+#include "idslotmap.h"
+#undef private
+
+void IdSlotMap_Test::initial()
+{
+    IdSlotMap<int> map;
+    QCOMPARE(map.count(), 0);
+    QVERIFY(map.isEmpty() == true);
+    QVERIFY(map.value(0) == NULL);
+    QVERIFY(map.value(123456) == NULL);
+    QVERIFY(map.contains(0) == false);
+}
+
+void IdSlotMap_Test::insert()
+{
+    IdSlotMap<int> map;
+    int a = 1, b = 2, c = 3;
+
+    QVERIFY(map.insert(5, &a) == true);
+    QVERIFY(map.insert(2, &b) == true);
+    QVERIFY(map.insert(9, &c) == true);
+
+    // already taken
+    QVERIFY(map.insert(5, &c) == false);
+
+    QCOMPARE(map.count(), 3);
+    QVERIFY(map.value(5) == &a);
+    QVERIFY(map.value(2) == &b);
+    QVERIFY(map.value(9) == &c);
+    QVERIFY(map.value(3) == NULL);
+    QVERIFY(map.value(10) == NULL);
+
+    // sorted by ID
+    QCOMPARE(map.keys(), QList<quint32>() << 2 << 5 << 9);
+    QCOMPARE(map.values(), QList<int*>() << &b << &a << &c);
+}
+
+void IdSlotMap_Test::take()
+{
+    IdSlotMap<int> map;
+    int a = 1, b = 2, c = 3;
+
+    map.insert(0, &a);
+    map.insert(1, &b);
+    map.insert(2, &c);
+
+    QVERIFY(map.take(1) == &b);
+    QVERIFY(map.take(1) == NULL);
+    QCOMPARE(map.count(), 2);
+    QVERIFY(map.contains(1) == false);
+    QCOMPARE(map.values(), QList<int*>() << &a << &c);
+
+    // the slot can be reused
+    QVERIFY(map.insert(1, &b) == true);
+    QCOMPARE(map.values(), QList<int*>() << &a << &b << &c);
+}
+
+void IdSlotMap_Test::sparse()
+{
+    IdSlotMap<int> map;
+    int a = 1, b = 2;
+
+    QVERIFY(map.insert(IDSLOTMAP_DENSE_SIZE + 10, &a) == true);
+    QVERIFY(map.insert(4, &b) == true);
+    QVERIFY(map.m_slots.size() < IDSLOTMAP_DENSE_SIZE);
+
+    QVERIFY(map.value(IDSLOTMAP_DENSE_SIZE + 10) == &a);
+    QVERIFY(map.value(IDSLOTMAP_DENSE_SIZE) == NULL);
+    QCOMPARE(map.keys(), QList<quint32>() << 4 << IDSLOTMAP_DENSE_SIZE + 10);
+
+    QVERIFY(map.take(IDSLOTMAP_DENSE_SIZE + 10) == &a);
+    QVERIFY(map.contains(IDSLOTMAP_DENSE_SIZE + 10) == false);
+    QCOMPARE(map.count(), 1);
+}
+
+void IdSlotMap_Test::clear()
+{
+    IdSlotMap<int> map;
+    int a = 1;
+
+    map.insert(3, &a);
+    map.clear();
+    QVERIFY(map.isEmpty() == true);
+    QVERIFY(map.value(3) == NULL);
+}
+
+QTEST_APPLESS_MAIN(IdSlotMap_Test)
@@ -198,6 +198,42 @@ void QLCChannel_Test::searchCapabilityByValue()
     delete channel;
 }
 
+void QLCChannel_Test::searchCapabilityAfterChanges()
+{
+    QLCChannel* channel = new QLCChannel();
+    QVERIFY(channel->searchCapability(0) == NULL);
+
+    QLCCapability* cap1 = new QLCCapability(0, 9, "0-9");
+    QVERIFY(channel->addCapability(cap1) == true);
+    QVERIFY(channel->searchCapability(5) == cap1);
+    QVERIFY(channel->searchCapability(15) == NULL);
+
+    QLCCapability* cap2 = new QLCCapability(10, 255, "10-255");
+    QVERIFY(channel->addCapability(cap2) == true);
+    QVERIFY(channel->searchCapability(15) == cap2);
+    QVERIFY(channel->searchCapability(255) == cap2);
+
+    QVERIFY(channel->setCapabilityRange(cap1, 0, 4) == true);
+    QVERIFY(channel->searchCapability(4) == cap1);
+    QVERIFY(channel->searchCapability(5) == NULL);
+
+    QVERIFY(channel->removeCapability(cap2) == true);
+    QVERIFY(channel->searchCapability(15) == NULL);
+    QVERIFY(channel->searchCapability(255) == NULL);
+
+    /* A copy has its own table */
+    QLCChannel* copy = new QLCChannel(channel);
+    QVERIFY(copy->searchCapability(0) != NULL);
+    QVERIFY(copy->searchCapability(0) != cap1);
+    QCOMPARE(copy->searchCapability(0)->name(), QString("0-9"));
+
+    *copy = QLCChannel();
+    QVERIFY(copy->searchCapability(0) == NULL);
+
+    delete copy;
+    delete channel;
+}
+
 void QLCChannel_Test::searchCapabilityByName()
 {
     QLCChannel* channel = new QLCChannel();
@@ -35,6 +35,7 @@ private slots:
     void colour();
     void searchCapabilityByValue();
     void searchCapabilityByName();
+    void searchCapabilityAfterChanges();
     void addCapability();
     void removeCapability();
     void sortCapabilities();
@@ -24,6 +24,7 @@
 #undef private
 
 #include "qlcfixturedefcache_test.h"
+#include "qlcchannel.h"
 #include "qlcfixturedef.h"
 #include "qlcconfig.h"
 #include "qlcfile.h"
@@ -178,6 +179,49 @@ void QLCFixtureDefCache_Test::load()
     QVERIFY(cache.manufacturers().contains("SGM") == true);
 }
 
+void QLCFixtureDefCache_Test::releaseUnused()
+{
+    QVERIFY(cache.m_defs.size() > 1);
+
+    QLCFixtureDef* used = cache.m_defs.at(0);
+    QLCFixtureDef* unused = cache.m_defs.at(1);
+    QVERIFY(used->isLoaded() == true);
+    QVERIFY(unused->isLoaded() == true);
+    int channels = unused->channels().size();
+    QVERIFY(channels > 0);
+
+    used->ref();
+    QCOMPARE(cache.releaseUnused(), cache.m_defs.size() - 1);
+    QVERIFY(used->isLoaded() == true);
+    QVERIFY(used->channels().isEmpty() == false);
+    QVERIFY(unused->isLoaded() == false);
+    QVERIFY(unused->channels().isEmpty() == true);
+    QVERIFY(unused->modes().isEmpty() == true);
+
+    /* Released definitions are loaded again when requested */
+    QVERIFY(cache.fixtureDef(unused->manufacturer(), unused->model()) == unused);
+    QVERIFY(unused->isLoaded() == true);
+    QCOMPARE(unused->channels().size(), channels);
+
+    /* Nothing left to release but the definition loaded again */
+    QCOMPARE(cache.releaseUnused(), 1);
+    QCOMPARE(cache.releaseUnused(), 0);
+
+    used->deref();
+    QCOMPARE(used->refCount(), 0);
+    QCOMPARE(cache.releaseUnused(), 1);
+    QVERIFY(used->isLoaded() == false);
+
+    /* Definitions created in memory can't be released */
+    QLCFixtureDef* def = new QLCFixtureDef();
+    def->setManufacturer("Foo");
+    def->setModel("Bar");
+    def->addChannel(new QLCChannel());
+    QVERIFY(cache.addFixtureDef(def) == true);
+    QVERIFY(def->unload() == false);
+    QCOMPARE(def->channels().size(), 1);
+}
+
 void QLCFixtureDefCache_Test::defDirectories()
 {
     QDir dir = QLCFixtureDefCache::systemDefinitionDirectory();
@@ -35,6 +35,7 @@ private slots:
     void add();
     void fixtureDef();
 	void load();
+    void releaseUnused();
     void defDirectories();
 
 private:
@@ -0,0 +1,17 @@
+include(../../../variables.pri)
+include(../../../coverage.pri)
+TEMPLATE = app
+LANGUAGE = C++
+TARGET   = qlctrace_test
+
+QT      += testlib
+CONFIG  -= app_bundle
+
+DEPENDPATH   += ../../src
+INCLUDEPATH  += ../../../plugins/interfaces
+INCLUDEPATH  += ../../src
+QMAKE_LIBDIR += ../../src
+LIBS         += -lqlcplusengine
+
+SOURCES += qlctrace_test.cpp
+HEADERS += qlctrace_test.h
@@ -0,0 +1,199 @@
+/*
+  Q Light Controller Plus - Unit test
+  qlctrace_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+#include <QThread>
+
+#define private public
+#include "qlctrace_test.h"
+#include "qlctrace.h"
+#undef private
+
+/** Same as TRACE_BUFFER_SIZE in qlctrace.cpp */
+#define BUFFER_SIZE (1 << 17)
+
+namespace
+{
+    class TraceThread : public QThread
+    {
+    protected:
+        void run()
+        {
+            QLCTrace::Scope scope("Worker scope", 7);
+        }
+    };
+}
+
+void QLCTrace_Test::initTestCase()
+{
+    m_fileName = QDir::tempPath() + "/qlcplus_qlctrace_test.json";
+}
+
+void QLCTrace_Test::cleanupTestCase()
+{
+    QFile::remove(m_fileName);
+}
+
+void QLCTrace_Test::init()
+{
+    QLCTrace::clear();
+}
+
+void QLCTrace_Test::cleanup()
+{
+    QLCTrace::stop();
+    QFile::remove(m_fileName);
+}
+
+QString QLCTrace_Test::exportTrace()
+{
+    if (QLCTrace::exportChromeTrace(m_fileName) == false)
+        return QString();
+
+    QFile file(m_fileName);
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text) == false)
+        return QString();
+
+    return QString::fromUtf8(file.readAll());
+}
+
+void QLCTrace_Test::notRecording()
+{
+    QVERIFY(QLCTrace::isRecording() == false);
+
+    {
+        QLCTrace::Scope scope("Idle scope");
+    }
+    QLCTrace::recordElapsed("Idle elapsed", 1000);
+
+    QString json = exportTrace();
+    QVERIFY(json.startsWith("{\"traceEvents\":[") == true);
+    QVERIFY(json.contains("Idle scope") == false);
+    QVERIFY(json.contains("Idle elapsed") == false);
+}
+
+void QLCTrace_Test::scope()
+{
+    QLCTrace::start();
+    QVERIFY(QLCTrace::isRecording() == true);
+
+    {
+        QLCTrace::Scope scope("Test scope", 42);
+        QTest::qWait(5);
+    }
+    {
+        QLCTrace::Scope scope("No arg scope");
+    }
+
+    QLCTrace::stop();
+    QVERIFY(QLCTrace::isRecording() == false);
+
+    // events recorded after stop are ignored
+    {
+        QLCTrace::Scope scope("Stopped scope");
+    }
+
+    QString json = exportTrace();
+    QCOMPARE(json.count("\"name\":\"Test scope\",\"ph\":\"X\""), 1);
+    QVERIFY(json.contains("\"args\":{\"id\":42}") == true);
+    QCOMPARE(json.count("\"name\":\"No arg scope\",\"ph\":\"X\""), 1);
+    QVERIFY(json.contains("Stopped scope") == false);
+    QVERIFY(json.trimmed().endsWith("],\"displayTimeUnit\":\"ms\"}") == true);
+
+    // the 5ms wait must be accounted in the scope duration
+    int idx = json.indexOf("\"name\":\"Test scope\"");
+    int durIdx = json.indexOf("\"dur\":", idx) + 6;
+    int endIdx = json.indexOf(",", durIdx);
+    double duration = json.mid(durIdx, endIdx - durIdx).toDouble();
+    QVERIFY(duration >= 5000.0);
+}
+
+void QLCTrace_Test::recordElapsed()
+{
+    QLCTrace::start();
+    QLCTrace::recordElapsed("Latency", 2000000, 3);
+    QLCTrace::stop();
+
+    QString json = exportTrace();
+    QVERIFY(json.contains("\"name\":\"Latency\"") == true);
+    QVERIFY(json.contains("\"dur\":2000.000,\"args\":{\"id\":3}") == true);
+}
+
+void QLCTrace_Test::clear()
+{
+    QLCTrace::start();
+    {
+        QLCTrace::Scope scope("Cleared scope");
+    }
+    QLCTrace::stop();
+
+    QVERIFY(exportTrace().contains("Cleared scope") == true);
+
+    QLCTrace::clear();
+    QVERIFY(exportTrace().contains("Cleared scope") == false);
+}
+
+void QLCTrace_Test::threadName()
+{
+    QLCTrace::setThreadName("Test \"main\" thread");
+
+    QString json = exportTrace();
+    QVERIFY(json.contains("\"ph\":\"M\"") == true);
+    QVERIFY(json.contains("\"args\":{\"name\":\"Test \\\"main\\\" thread\"}") == true);
+}
+
+void QLCTrace_Test::otherThread()
+{
+    TraceThread thread;
+    thread.setObjectName("Worker thread");
+
+    QLCTrace::start();
+    thread.start();
+    QVERIFY(thread.wait(5000) == true);
+    QLCTrace::stop();
+
+    // the buffer outlives its thread
+    QString json = exportTrace();
+    QVERIFY(json.contains("\"args\":{\"name\":\"Worker thread\"}") == true);
+    QCOMPARE(json.count("\"name\":\"Worker scope\""), 1);
+    QVERIFY(json.contains("\"args\":{\"id\":7}") == true);
+}
+
+void QLCTrace_Test::ringBuffer()
+{
+    QLCTrace::start();
+    for (int i = 0; i < BUFFER_SIZE + 100; i++)
+        QLCTrace::record("Wrap", i, 1, i);
+    QLCTrace::stop();
+
+    // only the newest events are retained
+    QString json = exportTrace();
+    QCOMPARE(json.count("\"name\":\"Wrap\""), BUFFER_SIZE);
+    QVERIFY(json.contains("\"args\":{\"id\":99}") == false);
+    QVERIFY(json.contains("\"args\":{\"id\":100}") == true);
+    QVERIFY(json.contains(QString("\"args\":{\"id\":%1}").arg(BUFFER_SIZE + 99)) == true);
+}
+
+void QLCTrace_Test::exportFailure()
+{
+    QString fileName = QDir::tempPath() + "/qlcplus_qlctrace_missing/trace.json";
+    QVERIFY(QLCTrace::exportChromeTrace(fileName) == false);
+}
+
+QTEST_MAIN(QLCTrace_Test)
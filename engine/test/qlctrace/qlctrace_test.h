@@ -0,0 +1,52 @@
+/*
+  Q Light Controller Plus - Unit test
+  qlctrace_test.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef QLCTRACE_TEST_H
+#define QLCTRACE_TEST_H
+
+#include <QObject>
+
+class QLCTrace_Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void notRecording();
+    void scope();
+    void recordElapsed();
+    void clear();
+    void threadName();
+    void otherThread();
+    void ringBuffer();
+    void exportFailure();
+
+private:
+    /** Export the recorded events and return the resulting JSON */
+    QString exportTrace();
+
+private:
+    QString m_fileName;
+};
+
+#endif
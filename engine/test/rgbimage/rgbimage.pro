@@ -0,0 +1,18 @@
+include(../../../variables.pri)
+include(../../../coverage.pri)
+TEMPLATE = app
+LANGUAGE = C++
+TARGET   = rgbimage_test
+
+QT      += testlib
+CONFIG  -= app_bundle
+
+DEPENDPATH   += ../../src
+INCLUDEPATH  += ../../../plugins/interfaces
+INCLUDEPATH  += ../mastertimer
+INCLUDEPATH  += ../../src
+QMAKE_LIBDIR += ../../src
+LIBS         += -lqlcplusengine
+
+SOURCES += rgbimage_test.cpp
+HEADERS += rgbimage_test.h
@@ -0,0 +1,137 @@
+/*
+  Q Light Controller Plus - Unit test
+  rgbimage_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+
+#define private public
+#include "rgbimage_test.h"
+#include "rgbimage.h"
+#undef private
+
+#include "doc.h"
+
+namespace
+{
+    /** A 4x2 image where each pixel has a different red value */
+    QByteArray testImageData()
+    {
+        QByteArray data;
+        for (int i = 0; i < 8; i++)
+            data.append(char(i * 10 + 10)).append(char(0)).append(char(0));
+        return data;
+    }
+
+    uint testPixel(int x, int y)
+    {
+        return qRgb((y * 4 + x) * 10 + 10, 0, 0);
+    }
+}
+
+void RGBImage_Test::initTestCase()
+{
+    m_doc = new Doc(this);
+}
+
+void RGBImage_Test::cleanupTestCase()
+{
+    delete m_doc;
+}
+
+void RGBImage_Test::staticImage()
+{
+    RGBImage image(m_doc);
+    QCOMPARE(image.rgbMap(QSize(2, 2), 0, 0).size(), 0);
+
+    image.setImageData(4, 2, testImageData());
+    QCOMPARE(image.m_image.format(), QImage::Format_ARGB32);
+    QCOMPARE(image.rgbMapStepCount(QSize(2, 2)), 1);
+
+    RGBMap map = image.rgbMap(QSize(2, 2), 0, 0);
+    QCOMPARE(map.size(), 2);
+    for (int y = 0; y < 2; y++)
+    {
+        QCOMPARE(map[y].size(), 2);
+        for (int x = 0; x < 2; x++)
+            QCOMPARE(map[y][x], testPixel(x, y));
+    }
+}
+
+void RGBImage_Test::horizontal()
+{
+    RGBImage image(m_doc);
+    image.setImageData(4, 2, testImageData());
+    image.setAnimationStyle(RGBImage::Horizontal);
+    QCOMPARE(image.rgbMapStepCount(QSize(2, 2)), 4);
+
+    // the image wraps around
+    RGBMap map = image.rgbMap(QSize(2, 2), 0, 3);
+    QCOMPARE(map[0][0], testPixel(3, 0));
+    QCOMPARE(map[0][1], testPixel(0, 0));
+    QCOMPARE(map[1][0], testPixel(3, 1));
+    QCOMPARE(map[1][1], testPixel(0, 1));
+}
+
+void RGBImage_Test::animation()
+{
+    RGBImage image(m_doc);
+    image.setImageData(4, 2, testImageData());
+    image.setAnimationStyle(RGBImage::Animation);
+    QCOMPARE(image.rgbMapStepCount(QSize(2, 2)), 2);
+
+    RGBMap map = image.rgbMap(QSize(2, 2), 0, 1);
+    QCOMPARE(map[0][0], testPixel(2, 0));
+    QCOMPARE(map[1][1], testPixel(3, 1));
+}
+
+void RGBImage_Test::frameCache()
+{
+    RGBImage image(m_doc);
+    image.setImageData(4, 2, testImageData());
+    image.setAnimationStyle(RGBImage::Horizontal);
+
+    RGBMap map = image.rgbMap(QSize(2, 2), 0, 1);
+    QCOMPARE(image.m_frames.size(), 2);
+    QCOMPARE(image.m_framesPixels, 4);
+
+    // a cached frame is shared, not rendered again
+    RGBMap cached = image.rgbMap(QSize(2, 2), 0, 1);
+    QCOMPARE(cached, map);
+    QVERIFY(cached[0].constData() == map[0].constData());
+    QCOMPARE(image.m_framesPixels, 4);
+
+    // the offset changes the frames
+    image.setXOffset(1);
+    QCOMPARE(image.m_frames.size(), 0);
+    map = image.rgbMap(QSize(2, 2), 0, 1);
+    QCOMPARE(map[0][0], testPixel(2, 0));
+
+    // so does the size
+    map = image.rgbMap(QSize(1, 1), 0, 1);
+    QCOMPARE(image.m_framesSize, QSize(1, 1));
+    QCOMPARE(image.m_framesPixels, 1);
+    QCOMPARE(map[0][0], testPixel(2, 0));
+
+    // and the image
+    image.setImageData(1, 1, QByteArray(3, char(255)));
+    QCOMPARE(image.m_framesPixels, 0);
+    map = image.rgbMap(QSize(1, 1), 0, 0);
+    QCOMPARE(map[0][0], qRgb(255, 255, 255));
+}
+
+QTEST_MAIN(RGBImage_Test)
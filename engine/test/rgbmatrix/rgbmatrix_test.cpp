@@ -28,6 +28,8 @@
 #include "qlcfixturemode.h"
 #include "qlcfixturedef.h"
 #include "fixturegroup.h"
+#include "genericfader.h"
+#include "fadechannel.h"
 #include "mastertimer.h"
 #include "rgbmatrix.h"
 #include "fixture.h"
@@ -173,6 +175,64 @@ void RGBMatrix_Test::previewMaps()
     }
 }
 
+void RGBMatrix_Test::mapTiles()
+{
+    /* A group large enough to be split in tiles */
+    FixtureGroup* grp = new FixtureGroup(m_doc);
+    grp->setSize(QSize(64, 32));
+    m_doc->addFixtureGroup(grp);
+    foreach (Fixture* fxi, m_doc->fixtures())
+        grp->assignFixture(fxi->id(), QLCPoint(fxi->id() % 64, (fxi->id() * 7) % 32));
+
+    RGBMatrix mtx(m_doc);
+    mtx.setFixtureGroup(grp->id());
+    mtx.setDimmerControl(false);
+
+    RGBMap map(32);
+    for (int y = 0; y < 32; y++)
+    {
+        map[y].resize(64);
+        for (int x = 0; x < 64; x++)
+            map[y][x] = qRgb(x * 4, y * 8, 255 - x);
+    }
+
+    /* The whole map as a single tile */
+    RGBMatrix::MapTile serial;
+    serial.firstRow = 0;
+    serial.rowCount = 32;
+    serial.fader = NULL;
+    mtx.m_fader = new GenericFader(m_doc);
+    mtx.mapTileChannels(map, grp, 0, serial);
+    QCOMPARE(serial.pixels.count(), m_doc->fixtures().count());
+
+    /* A tile with a fader is not staged */
+    RGBMatrix::MapTile direct;
+    direct.firstRow = 0;
+    direct.rowCount = 32;
+    direct.fader = new GenericFader(m_doc);
+    mtx.mapTileChannels(map, grp, 0, direct);
+    QVERIFY(direct.channels.isEmpty() == true);
+    QVERIFY(direct.pixels.isEmpty() == true);
+    QCOMPARE(direct.fader->channels().count(), serial.channels.count());
+    delete direct.fader;
+
+    /* Tiles computed in parallel and joined must give the same channels.
+     * The tile pool has at least one thread, so the map is always split */
+    QVERIFY(RGBMatrix::mapTilePool()->maxThreadCount() >= 1);
+    QCOMPARE(RGBMatrix::mapTileCount(map), 2);
+    mtx.updateMapChannels(map, grp);
+    QCOMPARE(mtx.m_fader->channels().count(), serial.channels.count());
+    foreach (FadeChannel fc, serial.channels)
+    {
+        QVERIFY(mtx.m_fader->channels().contains(fc));
+        QCOMPARE(mtx.m_fader->channels()[fc].target(), fc.target());
+    }
+
+    delete mtx.m_fader;
+    mtx.m_fader = NULL;
+    m_doc->deleteFixtureGroup(grp->id());
+}
+
 void RGBMatrix_Test::loadSave()
 {
     RGBMatrix* mtx = new RGBMatrix(m_doc);
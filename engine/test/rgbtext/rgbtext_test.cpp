@@ -424,4 +424,50 @@ void RGBText_Test::verticalScroll()
     }
 }
 
+void RGBText_Test::glyphStrip()
+{
+    RGBText text(m_doc);
+    text.setText("QLC");
+    text.setAnimationStyle(RGBText::Horizontal);
+
+    QFontMetrics fm(text.font());
+    QCOMPARE(text.m_glyphsValid, false);
+
+    RGBMap white = text.rgbMap(QSize(10, 10), QRgb(0xFFFFFFFF), 0);
+    QCOMPARE(text.m_glyphsValid, true);
+    QCOMPARE(text.m_glyphsWidth, fm.width("QLC"));
+    QCOMPARE(text.m_glyphsHeight, 10);
+    QCOMPARE(text.m_glyphs.size(), fm.width("QLC") * 10);
+
+    // The same glyphs are colored with each step's color
+    RGBMap red = text.rgbMap(QSize(10, 10), QRgb(0xFFFF0000), 0);
+    for (int y = 0; y < 10; y++)
+    {
+        for (int x = 0; x < 10; x++)
+        {
+            if (white[y][x] == QRgb(0xFFFFFFFF))
+                QCOMPARE(red[y][x], QRgb(0xFFFF0000));
+            else
+                QCOMPARE(red[y][x], white[y][x]);
+        }
+    }
+
+    // Any change renders the glyphs again
+    text.setText("QLC+");
+    QCOMPARE(text.m_glyphsValid, false);
+    QCOMPARE(text.rgbMapStepCount(QSize()), fm.width("QLC+"));
+    text.rgbMap(QSize(10, 10), QRgb(0xFFFFFFFF), 0);
+    QCOMPARE(text.m_glyphsWidth, fm.width("QLC+"));
+
+    text.rgbMap(QSize(10, 12), QRgb(0xFFFFFFFF), 0);
+    QCOMPARE(text.m_glyphsHeight, 12);
+
+    // Static letters are rendered side by side
+    text.setAnimationStyle(RGBText::StaticLetters);
+    QCOMPARE(text.m_glyphsValid, false);
+    text.rgbMap(QSize(10, 12), QRgb(0xFFFFFFFF), 0);
+    QCOMPARE(text.m_glyphsWidth, 40);
+    QCOMPARE(text.m_glyphsHeight, 12);
+}
+
 QTEST_MAIN(RGBText_Test)
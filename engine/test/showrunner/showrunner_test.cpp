@@ -0,0 +1,170 @@
+/*
+  Q Light Controller Plus - Unit test
+  showrunner_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+
+#define private public
+#include "showrunner_test.h"
+#include "showfunction.h"
+#include "mastertimer.h"
+#include "showrunner.h"
+#include "track.h"
+#include "scene.h"
+#include "show.h"
+#include "doc.h"
+#undef private
+
+/** A scene counting the preload requests of the runner */
+class PreloadScene : public Scene
+{
+public:
+    PreloadScene(Doc* doc)
+        : Scene(doc)
+        , m_preloads(0)
+        , m_cancels(0)
+        , m_startTime(0)
+    {
+    }
+
+    void preload(quint32 startTime)
+    {
+        m_preloads++;
+        m_startTime = startTime;
+    }
+
+    void cancelPreload()
+    {
+        m_cancels++;
+    }
+
+public:
+    int m_preloads;
+    int m_cancels;
+    quint32 m_startTime;
+};
+
+void ShowRunner_Test::initTestCase()
+{
+    m_doc = new Doc(this);
+}
+
+void ShowRunner_Test::cleanupTestCase()
+{
+    delete m_doc;
+}
+
+void ShowRunner_Test::init()
+{
+    m_first = new PreloadScene(m_doc);
+    m_doc->addFunction(m_first);
+    m_second = new PreloadScene(m_doc);
+    m_doc->addFunction(m_second);
+
+    m_show = new Show(m_doc);
+    m_doc->addFunction(m_show);
+
+    /* The second function starts well after the preload time */
+    Track* track = new Track();
+    m_show->addTrack(track);
+    ShowFunction* sf = track->createShowFunction(m_first->id());
+    sf->setStartTime(0);
+    sf->setDuration(secondStartTime());
+
+    track = new Track();
+    m_show->addTrack(track);
+    sf = track->createShowFunction(m_second->id());
+    sf->setStartTime(secondStartTime());
+    sf->setDuration(1000);
+}
+
+void ShowRunner_Test::cleanup()
+{
+    m_doc->clearContents();
+}
+
+quint32 ShowRunner_Test::secondStartTime() const
+{
+    return MasterTimer::mediaPreroll() * 4;
+}
+
+void ShowRunner_Test::preloadAhead()
+{
+    ShowRunner runner(m_doc, m_show->id());
+
+    runner.write();
+    QCOMPARE(m_first->m_preloads, 1);
+    QCOMPARE(m_first->m_startTime, quint32(0));
+    QVERIFY(runner.m_runningQueue.contains(m_first) == true);
+
+    /* Preloaded once, within the preload time and before being started */
+    quint32 elapsed = runner.m_elapsedTime;
+    while (m_second->m_preloads == 0)
+    {
+        elapsed = runner.m_elapsedTime;
+        runner.write();
+        QVERIFY(runner.m_elapsedTime < secondStartTime());
+    }
+    QVERIFY(elapsed + MasterTimer::mediaPreroll() >= secondStartTime());
+    QVERIFY(elapsed + MasterTimer::mediaPreroll() < secondStartTime() + MasterTimer::tick());
+    QCOMPARE(m_second->m_startTime, quint32(0));
+    QVERIFY(runner.m_runningQueue.contains(m_second) == false);
+
+    while (runner.m_runningQueue.contains(m_second) == false)
+        runner.write();
+    QCOMPARE(m_second->m_preloads, 1);
+    QCOMPARE(m_second->m_cancels, 0);
+    QCOMPARE(m_first->m_preloads, 1);
+
+    runner.stop();
+}
+
+void ShowRunner_Test::preloadAfterSeek()
+{
+    /* Started in the middle of the second function */
+    ShowRunner runner(m_doc, m_show->id(), secondStartTime() + 100);
+    QCOMPARE(runner.m_functions.count(), 1);
+
+    runner.write();
+    QCOMPARE(m_first->m_preloads, 0);
+    QCOMPARE(m_second->m_preloads, 1);
+    QCOMPARE(m_second->m_startTime, quint32(100));
+    QVERIFY(runner.m_runningQueue.contains(m_second) == true);
+
+    runner.stop();
+}
+
+void ShowRunner_Test::cancelPreloadOnStop()
+{
+    ShowRunner runner(m_doc, m_show->id());
+
+    while (m_second->m_preloads == 0)
+        runner.write();
+
+    /* Only the function that has not been started is released */
+    runner.stop();
+    QCOMPARE(m_first->m_cancels, 0);
+    QCOMPARE(m_second->m_cancels, 1);
+    QCOMPARE(runner.m_preloadIndex, 0);
+
+    /* Nothing is left to release */
+    runner.stop();
+    QCOMPARE(m_second->m_cancels, 1);
+}
+
+QTEST_APPLESS_MAIN(ShowRunner_Test)
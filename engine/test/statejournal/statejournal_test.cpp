@@ -0,0 +1,222 @@
+/*
+  Q Light Controller Plus - Unit test
+  statejournal_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+
+#define private public
+#include "statejournal_test.h"
+#include "inputoutputmap.h"
+#include "statejournal.h"
+#include "mastertimer.h"
+#include "chaserstep.h"
+#include "universe.h"
+#include "fixture.h"
+#include "chaser.h"
+#include "scene.h"
+#include "doc.h"
+#undef private
+
+/** Long enough for the chaser to stay on a step during a test */
+#define STEP_HOLD   60000
+
+void StateJournal_Test::initTestCase()
+{
+    m_dir = QDir::tempPath() + "/qlcplus_statejournal_test";
+    QVERIFY(QDir().mkpath(m_dir) == true);
+
+    m_workspace = m_dir + "/workspace.qxw";
+    QFile file(m_workspace);
+    QVERIFY(file.open(QIODevice::WriteOnly) == true);
+    file.write("<Workspace/>");
+    file.close();
+}
+
+void StateJournal_Test::cleanupTestCase()
+{
+    QFile::remove(m_workspace);
+    QDir().rmdir(m_dir);
+}
+
+void StateJournal_Test::init()
+{
+    m_doc = new Doc(this);
+    setupJournal(m_doc);
+}
+
+void StateJournal_Test::cleanup()
+{
+    delete m_doc;
+    QFile::remove(m_dir + "/journal.bin");
+}
+
+void StateJournal_Test::writeValue(Doc *doc, uchar value)
+{
+    QList<Universe*> universes = doc->inputOutputMap()->claimUniverses();
+    universes.first()->write(0, value, true);
+    doc->inputOutputMap()->releaseUniverses(false);
+}
+
+uchar StateJournal_Test::readValue(Doc *doc)
+{
+    QList<Universe*> universes = doc->inputOutputMap()->claimUniverses();
+    uchar value = uchar(universes.first()->preGMValues().at(0));
+    doc->inputOutputMap()->releaseUniverses(false);
+    return value;
+}
+
+void StateJournal_Test::setupJournal(Doc *doc)
+{
+    StateJournal* journal = doc->stateJournal();
+    journal->m_enabled = true;
+    journal->setFileName(m_dir + "/journal.bin");
+    journal->setWorkspace(m_workspace);
+}
+
+Chaser* StateJournal_Test::addChaser(Doc *doc)
+{
+    Fixture* fxi = new Fixture(doc);
+    fxi->setAddress(0);
+    fxi->setUniverse(0);
+    fxi->setChannels(4);
+    doc->addFixture(fxi);
+
+    Chaser* chaser = new Chaser(doc);
+    chaser->setDurationMode(Chaser::PerStep);
+    for (int i = 0; i < 3; i++)
+    {
+        Scene* scene = new Scene(doc);
+        scene->setValue(fxi->id(), 0, 50 * (i + 1));
+        doc->addFunction(scene);
+        chaser->addStep(ChaserStep(scene->id(), 0, STEP_HOLD, 0));
+    }
+    doc->addFunction(chaser);
+
+    return chaser;
+}
+
+void StateJournal_Test::restoreValues()
+{
+    writeValue(m_doc, 142);
+    m_doc->stateJournal()->slotWrite();
+
+    /* Leave the journal as a crash would */
+    m_doc->stateJournal()->unmap();
+
+    Doc doc(this);
+    setupJournal(&doc);
+    QCOMPARE(readValue(&doc), uchar(0));
+    QVERIFY(doc.stateJournal()->restore() == true);
+    QCOMPARE(readValue(&doc), uchar(142));
+}
+
+void StateJournal_Test::otherWorkspace()
+{
+    writeValue(m_doc, 142);
+    m_doc->stateJournal()->slotWrite();
+    m_doc->stateJournal()->unmap();
+
+    Doc doc(this);
+    setupJournal(&doc);
+    doc.stateJournal()->setWorkspace(m_dir + "/other.qxw");
+    QVERIFY(doc.stateJournal()->restore() == false);
+    QCOMPARE(readValue(&doc), uchar(0));
+
+    /* Disabled journal */
+    setupJournal(&doc);
+    doc.stateJournal()->m_enabled = false;
+    QVERIFY(doc.stateJournal()->restore() == false);
+}
+
+void StateJournal_Test::cleanShutdown()
+{
+    writeValue(m_doc, 142);
+    m_doc->stateJournal()->start();
+    m_doc->stateJournal()->stop();
+
+    Doc doc(this);
+    setupJournal(&doc);
+    QVERIFY(doc.stateJournal()->restore() == false);
+    QCOMPARE(readValue(&doc), uchar(0));
+}
+
+void StateJournal_Test::corruptedSlot()
+{
+    StateJournal* journal = m_doc->stateJournal();
+
+    writeValue(m_doc, 100);
+    journal->slotWrite();
+    writeValue(m_doc, 200);
+    journal->slotWrite();
+
+    /* Corrupt the payload of the newest slot, as an interrupted write would */
+    uchar* slot = journal->m_map + 12 + (journal->m_sequence % 2) * journal->m_slotSize;
+    slot[8 + 4] ^= 0xff;
+    journal->unmap();
+
+    Doc doc(this);
+    setupJournal(&doc);
+    QVERIFY(doc.stateJournal()->restore() == true);
+    QCOMPARE(readValue(&doc), uchar(100));
+}
+
+void StateJournal_Test::resumeChaser()
+{
+    /* Started by a VC widget, not by another function */
+    FunctionParent parent(FunctionParent::ManualVCWidget, 7);
+
+    Chaser* chaser = addChaser(m_doc);
+    chaser->setStepIndex(2);
+    chaser->start(m_doc->masterTimer(), parent);
+    for (int i = 0; i < 10; i++)
+        m_doc->masterTimer()->timerTick();
+    QVERIFY(chaser->isRunning() == true);
+    QCOMPARE(chaser->currentStepIndex(), 2);
+
+    quint32 elapsed = chaser->elapsed();
+    QVERIFY(elapsed > 0);
+    m_doc->stateJournal()->slotWrite();
+    m_doc->stateJournal()->unmap();
+
+    chaser->stop(FunctionParent::master());
+    m_doc->masterTimer()->timerTick();
+
+    /* The application is down for a while */
+    QTest::qSleep(200);
+
+    Doc doc(this);
+    setupJournal(&doc);
+    Chaser* restored = addChaser(&doc);
+    QCOMPARE(restored->id(), chaser->id());
+    QVERIFY(doc.stateJournal()->restore() == true);
+    doc.masterTimer()->timerTick();
+
+    /* Started again by the same parent, on the same step, and the
+     * downtime counts as elapsed */
+    QVERIFY(restored->isRunning() == true);
+    QCOMPARE(restored->sources().count(), 1);
+    QVERIFY(restored->sources().first() == parent);
+    QCOMPARE(restored->currentStepIndex(), 2);
+    QVERIFY(restored->elapsed() >= elapsed + 200);
+    QVERIFY(restored->elapsed() < STEP_HOLD);
+
+    restored->stop(FunctionParent::master());
+    doc.masterTimer()->timerTick();
+}
+
+QTEST_MAIN(StateJournal_Test)
@@ -0,0 +1,61 @@
+/*
+  Q Light Controller Plus - Unit test
+  statejournal_test.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef STATEJOURNAL_TEST_H
+#define STATEJOURNAL_TEST_H
+
+#include <QObject>
+
+class Chaser;
+class Doc;
+
+class StateJournal_Test : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+
+    void restoreValues();
+    void otherWorkspace();
+    void cleanShutdown();
+    void corruptedSlot();
+    void resumeChaser();
+
+private:
+    /** Write $value to the first channel of the first universe of $doc */
+    void writeValue(Doc* doc, uchar value);
+    uchar readValue(Doc* doc);
+
+    /** Add a fixture and a chaser of three scenes to $doc */
+    Chaser* addChaser(Doc* doc);
+
+    /** Enable the journal of $doc on the test files */
+    void setupJournal(Doc* doc);
+
+private:
+    QString m_dir;
+    QString m_workspace;
+    Doc* m_doc;
+};
+
+#endif
@@ -1,5 +1,7 @@
 TEMPLATE = subdirs
+SUBDIRS += audioprefetcher
 SUBDIRS += bus
+SUBDIRS += channelvaluestore
 SUBDIRS += chaser
 SUBDIRS += chaserrunner
 SUBDIRS += chaserstep
@@ -10,11 +12,13 @@ SUBDIRS += doc
 SUBDIRS += efx
 SUBDIRS += efxfixture
 SUBDIRS += fadechannel
+SUBDIRS += feedbackdispatcher
 SUBDIRS += fixture
 SUBDIRS += fixturegroup
 SUBDIRS += function
 SUBDIRS += genericfader
 SUBDIRS += grandmaster
+SUBDIRS += idslotmap
 SUBDIRS += inputoutputmap
 SUBDIRS += inputpatch
 SUBDIRS += mastertimer
@@ -32,14 +36,24 @@ SUBDIRS += qlcinputprofile
 SUBDIRS += qlcmacros
 SUBDIRS += qlcphysical
 SUBDIRS += qlcpoint
+SUBDIRS += qlctrace
 SUBDIRS += rgbalgorithm
+SUBDIRS += rgbimage
 SUBDIRS += rgbmatrix
 SUBDIRS += rgbscript
 SUBDIRS += rgbtext
 SUBDIRS += scene
 SUBDIRS += scenevalue
 SUBDIRS += script
+SUBDIRS += showrunner
+SUBDIRS += statejournal
 SUBDIRS += universe
+SUBDIRS += valuemailbox
+
+# The MAD decoder is built only when libmad is available
+system(pkg-config --exists mad) {
+  SUBDIRS += audiodecodermad
+}
 
 # Stubs
 SUBDIRS += iopluginstub
@@ -24,9 +24,12 @@
 #include "testmacros.h"
 
 #define protected public
+#define private public
 #include "universe.h"
+#undef private
 #undef protected
 
+#include "channelmodifier.h"
 #include "grandmaster.h"
 
 void Universe_Test::init()
@@ -69,6 +72,25 @@ void Universe_Test::initial()
     }
 }
 
+void Universe_Test::idle()
+{
+    QVERIFY(m_uni->isIdle() == true);
+
+    Universe uni(1, m_gm);
+    uni.setChannelCapability(0, QLCChannel::Intensity);
+    QVERIFY(uni.isIdle() == false);
+
+    QVERIFY(m_uni->write(4, 100) == true);
+    QVERIFY(m_uni->isIdle() == false);
+    QCOMPARE(quint8(m_uni->postGMValues()->at(4)), quint8(100));
+
+    /* Writing a universe doesn't touch the others */
+    Universe uni2(2, m_gm);
+    QVERIFY(uni2.isIdle() == true);
+    QCOMPARE(quint8(uni2.postGMValues()->at(4)), quint8(0));
+    QCOMPARE(quint8(uni2.preGMValue(4)), quint8(0));
+}
+
 void Universe_Test::channelCapabilities()
 {
     m_uni->setChannelCapability(0, QLCChannel::Intensity);
@@ -368,6 +390,75 @@ void Universe_Test::reset()
         QCOMPARE((int)m_uni->postGMValues()->at(i), 0);
 }
 
+void Universe_Test::passthroughBypass()
+{
+    m_uni->setPassthrough(true);
+    m_uni->setPassthroughBypass(true);
+    QVERIFY(m_uni->passthroughBypass() == true);
+
+    m_uni->write(0, 100);
+    m_uni->write(1, 50);
+
+    // a function wrote the universe, so frames are merged on ticks
+    m_uni->updateBypass();
+    QVERIFY(m_uni->m_bypassActive == false);
+
+    // nothing written since the last tick
+    m_uni->updateBypass();
+    QVERIFY(m_uni->m_bypassActive == true);
+    QCOMPARE(m_uni->m_bypassBase.size(), 2);
+
+    QByteArray frame(3, 0);
+    frame[0] = char(50);
+    frame[1] = char(200);
+    frame[2] = char(10);
+    m_uni->m_bypassInput = frame;
+    m_uni->mergeBypassFrame();
+
+    // HTP merge with the engine output
+    QCOMPARE(m_uni->m_bypassOutput.size(), 3);
+    QCOMPARE(uchar(m_uni->m_bypassOutput.at(0)), uchar(100));
+    QCOMPARE(uchar(m_uni->m_bypassOutput.at(1)), uchar(200));
+    QCOMPARE(uchar(m_uni->m_bypassOutput.at(2)), uchar(10));
+
+    m_uni->setBlackout(true);
+    m_uni->updateBypass();
+    QVERIFY(m_uni->m_bypassActive == false);
+}
+
+void Universe_Test::channelModifiers()
+{
+    QList< QPair<uchar, uchar> > map;
+    map << QPair<uchar, uchar>(0, 20) << QPair<uchar, uchar>(255, 120);
+    ChannelModifier mod;
+    mod.setModifierMap(map);
+
+    m_uni->setChannelModifier(4, &mod);
+    QVERIFY(m_uni->channelModifier(4) == &mod);
+    QVERIFY(m_uni->channelModifier(5) == NULL);
+
+    QVERIFY(m_uni->write(4, 255) == true);
+    QVERIFY(m_uni->write(5, 255) == true);
+    QCOMPARE(quint8(m_uni->postGMValues()->at(4)), mod.getValue(255));
+    QCOMPARE(quint8(m_uni->postGMValues()->at(5)), quint8(255));
+
+    /* Ranged reset uses the modified zero value */
+    m_uni->reset(4, 2);
+    QCOMPARE(quint8(m_uni->postGMValues()->at(4)), quint8(20));
+    QCOMPARE(quint8(m_uni->postGMValues()->at(5)), quint8(0));
+
+    /* Changing the map of a modifier in use is applied right away */
+    map.clear();
+    map << QPair<uchar, uchar>(0, 0) << QPair<uchar, uchar>(255, 10);
+    mod.setModifierMap(map);
+    QVERIFY(m_uni->write(4, 255) == true);
+    QCOMPARE(quint8(m_uni->postGMValues()->at(4)), quint8(10));
+
+    m_uni->setChannelModifier(4, NULL);
+    QVERIFY(m_uni->write(4, 255) == true);
+    QCOMPARE(quint8(m_uni->postGMValues()->at(4)), quint8(255));
+}
+
 void Universe_Test::setGMValueEfficiency()
 {
     int i;
@@ -35,6 +35,7 @@ private slots:
     void cleanup();
 
     void initial();
+    void idle();
     void channelCapabilities();
     void grandMasterIntensityReduce();
     void grandMasterIntensityLimit();
@@ -44,6 +45,8 @@ private slots:
     void write();
     void writeRelative();
     void reset();
+    void passthroughBypass();
+    void channelModifiers();
     void setGMValueEfficiency();
     void writeEfficiency();
     void hasChangedEfficiency();
@@ -0,0 +1,113 @@
+/*
+  Q Light Controller Plus - Unit test
+  valuemailbox_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+
+#include "valuemailbox_test.h"
+#include "valuemailbox.h"
+
+void ValueMailbox_Test::initial()
+{
+    ValueMailbox mb;
+    QCOMPARE(mb.value(), quint32(0));
+    QCOMPARE(mb.sequence(), 0);
+
+    ValueMailbox mb2(42);
+    QCOMPARE(mb2.value(), quint32(42));
+
+    int seq = 0;
+    quint32 value = 1;
+    QVERIFY(mb2.fetch(value, seq) == false);
+    QCOMPARE(value, quint32(42));
+    QCOMPARE(seq, 0);
+}
+
+void ValueMailbox_Test::post()
+{
+    ValueMailbox mb;
+    int seq = 0;
+    quint32 value = 0;
+
+    mb.post(127);
+    QCOMPARE(mb.sequence(), 1);
+    QVERIFY(mb.fetch(value, seq) == true);
+    QCOMPARE(value, quint32(127));
+    QCOMPARE(seq, 1);
+
+    /* Nothing new */
+    QVERIFY(mb.fetch(value, seq) == false);
+    QCOMPARE(value, quint32(127));
+
+    /* Posting the same value is still a change */
+    mb.post(127);
+    QVERIFY(mb.fetch(value, seq) == true);
+    QCOMPARE(value, quint32(127));
+
+    mb.post(0xFFFFFFFF);
+    QVERIFY(mb.fetch(value, seq) == true);
+    QCOMPARE(value, quint32(0xFFFFFFFF));
+}
+
+void ValueMailbox_Test::latestValueWins()
+{
+    ValueMailbox mb;
+    int seq = 0;
+    quint32 value = 0;
+
+    for (quint32 i = 0; i < 100; i++)
+        mb.post(i);
+
+    QVERIFY(mb.fetch(value, seq) == true);
+    QCOMPARE(value, quint32(99));
+    QCOMPARE(seq, 100);
+    QVERIFY(mb.fetch(value, seq) == false);
+}
+
+void ValueMailbox_Test::store()
+{
+    ValueMailbox mb;
+    int seq = 0;
+    quint32 value = 0;
+
+    mb.store(10);
+    QCOMPARE(mb.sequence(), 0);
+    QVERIFY(mb.fetch(value, seq) == false);
+    QCOMPARE(value, quint32(10));
+
+    mb.post(20);
+    mb.store(30);
+    QVERIFY(mb.fetch(value, seq) == true);
+    QCOMPARE(value, quint32(30));
+}
+
+void ValueMailbox_Test::timestamp()
+{
+    ValueMailbox mb;
+
+    quint32 before = ValueMailbox::clock();
+    mb.post(1);
+    quint32 after = ValueMailbox::clock();
+
+    QVERIFY(mb.timestamp() - before <= after - before);
+
+    QTest::qSleep(10);
+    QVERIFY(ValueMailbox::clock() - mb.timestamp() >= 10000);
+}
+
+QTEST_APPLESS_MAIN(ValueMailbox_Test)
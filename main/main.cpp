@@ -32,6 +32,7 @@
 #include <QDir>
 
 #include "qlcconfig.h"
+#include "qlctrace.h"
 #include "qlci18n.h"
 
 #if defined(WIN32) || defined(__APPLE__)
@@ -86,6 +87,9 @@ namespace QLCArgs
     /** Log to file flag */
     bool logToFile = false;
 
+    /** If not empty, record engine trace events and write them to this file on exit */
+    QString traceFile;
+
     QFile logFile;
 
 #if defined(WIN32) || defined(__APPLE__)
@@ -174,6 +178,9 @@ void printUsage()
     cout << "  -n or --nogui\t\t\tStart the application with the GUI hidden (Raspberry Pi only)" << endl;
     cout << "  -o or --open <file>\t\tOpen the specified workspace file" << endl;
     cout << "  -p or --operate\t\tStart in operate mode" << endl;
+#ifdef QLC_TRACING
+    cout << "  -t or --trace <file>\t\tRecord engine trace events and save them to <file> on exit" << endl;
+#endif
     cout << "  -v or --version\t\tPrint version information" << endl;
     cout << "  -w or --web\t\t\tEnable remote web access" << endl;
     cout << endl;
@@ -257,6 +264,13 @@ bool parseArgs()
         {
             QLCArgs::operate = true;
         }
+#ifdef QLC_TRACING
+        else if (arg == "-t" || arg == "--trace")
+        {
+            if (it.hasNext() == true)
+                QLCArgs::traceFile = it.next();
+        }
+#endif
         else if (arg == "-w" || arg == "--web")
         {
             QLCArgs::enableWebAccess = true;
@@ -314,6 +328,9 @@ int main(int argc, char** argv)
     qInstallMessageHandler(qlcMessageHandler);
 #endif
 
+    if (QLCArgs::traceFile.isEmpty() == false)
+        QLCTrace::start();
+
     /* Create and initialize the QLC application object */
     App app;
 
@@ -353,5 +370,13 @@ int main(int argc, char** argv)
                 &app, SLOT(slotSaveAutostart(QString)));
     }
 
-    return qapp.exec();
+    int ret = qapp.exec();
+
+    if (QLCArgs::traceFile.isEmpty() == false)
+    {
+        QLCTrace::stop();
+        QLCTrace::exportChromeTrace(QLCArgs::traceFile);
+    }
+
+    return ret;
 }
@@ -419,14 +419,18 @@ void E131Controller::processPendingPackets()
                         m_dmxValuesMap[universe] = new QByteArray(512, 0);
                     dmxValues = m_dmxValuesMap[universe];
 
+                    bool changed = false;
                     for (int i = 0; i < dmxData.length(); i++)
                     {
                         if (dmxValues->at(i) != dmxData.at(i))
                         {
                             dmxValues->replace(i, 1, (const char *)(dmxData.data() + i), 1);
                             emit valueChanged(universe, m_line, i, (uchar)dmxData.at(i));
+                            changed = true;
                         }
                     }
+                    if (changed)
+                        emit inputFrameReceived(universe, m_line, dmxData);
                 }
             }
         }
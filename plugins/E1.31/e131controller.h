@@ -177,6 +177,8 @@ private slots:
 
 signals:
     void valueChanged(quint32 universe, quint32 input, quint32 channel, uchar value);
+
+    void inputFrameReceived(quint32 universe, quint32 input, const QByteArray& data);
 };
 
 #endif
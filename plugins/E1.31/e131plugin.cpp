@@ -148,6 +148,8 @@ bool E131Plugin::openOutput(quint32 output, quint32 universe)
                                                         output, this);
         connect(controller, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)),
                 this, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)));
+        connect(controller, SIGNAL(inputFrameReceived(quint32,quint32,QByteArray)),
+                this, SIGNAL(inputFrameReceived(quint32,quint32,QByteArray)));
         m_IOmapping[output].controller = controller;
     }
 
@@ -218,6 +220,8 @@ bool E131Plugin::openInput(quint32 input, quint32 universe)
                                                         input, this);
         connect(controller, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)),
                 this, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)));
+        connect(controller, SIGNAL(inputFrameReceived(quint32,quint32,QByteArray)),
+                this, SIGNAL(inputFrameReceived(quint32,quint32,QByteArray)));
         m_IOmapping[input].controller = controller;
     }
 
@@ -358,6 +358,7 @@ bool ArtNetController::handleArtNetDmx(QByteArray const& datagram, QHostAddress
             qDebug() << "[ArtNet] -> universe" << (universe + 1);
 #endif
 
+            bool changed = false;
             for (int i = 0; i < dmxData.length(); i++)
             {
                 if (dmxValues->at(i) != dmxData.at(i))
@@ -367,8 +368,11 @@ bool ArtNetController::handleArtNetDmx(QByteArray const& datagram, QHostAddress
 #endif
                     dmxValues->replace(i, 1, (const char *)(dmxData.data() + i), 1);
                     emit valueChanged(universe, m_line, i, (uchar)dmxData.at(i));
+                    changed = true;
                 }
             }
+            if (changed)
+                emit inputFrameReceived(universe, m_line, dmxData);
             ++m_packetReceived;
             return true;
         }
@@ -162,6 +162,8 @@ bool ArtNetPlugin::openOutput(quint32 output, quint32 universe)
                                                             output, this);
         connect(controller, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)),
                 this, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)));
+        connect(controller, SIGNAL(inputFrameReceived(quint32,quint32,QByteArray)),
+                this, SIGNAL(inputFrameReceived(quint32,quint32,QByteArray)));
         m_IOmapping[output].controller = controller;
     }
 
@@ -234,6 +236,8 @@ bool ArtNetPlugin::openInput(quint32 input, quint32 universe)
                                                             input, this);
         connect(controller, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)),
                 this, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)));
+        connect(controller, SIGNAL(inputFrameReceived(quint32,quint32,QByteArray)),
+                this, SIGNAL(inputFrameReceived(quint32,quint32,QByteArray)));
         m_IOmapping[input].controller = controller;
     }
 
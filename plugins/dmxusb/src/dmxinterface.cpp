@@ -70,6 +70,11 @@ quint8 DMXInterface::busLocation()
     return 0;
 }
 
+void DMXInterface::updateLocation(DMXInterface *iface)
+{
+    m_id = iface->id();
+}
+
 bool DMXInterface::validInterface(quint16 vendor, quint16 product)
 {
     if (vendor != DMXInterface::FTDIVID &&
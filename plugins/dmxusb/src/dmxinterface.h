@@ -72,6 +72,13 @@ public:
      *  Used only in Linux to perform a sysfs lookup */
     virtual quint8 busLocation();
 
+    /**
+     * Take the location of $iface (ID, bus location, serial port...),
+     * found by a new enumeration of the same device, so that this
+     * interface opens the device where it is now when reopened.
+     */
+    virtual void updateLocation(DMXInterface *iface);
+
 private:
     QString m_serial;
     QString m_name;
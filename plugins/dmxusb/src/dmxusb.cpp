@@ -57,14 +57,82 @@ int DMXUSB::capabilities() const
 
 bool DMXUSB::rescanWidgets()
 {
-    int linesCount = m_inputs.count() + m_outputs.count();
-    m_inputs.clear();
-    m_outputs.clear();
+    QList<DMXInterface *> interfaces = DMXUSBWidget::interfaces();
+    QMap <QString,QVariant> types(DMXInterface::typeMap());
+    QList<DMXUSBWidget *> widgets;
+    quint32 output_id = 0;
+    quint32 input_id = 0;
+    bool changed = false;
+
+    /* Clones of the same model may have the same serial, or none, so a
+     * widget can be matched to its device only by a unique serial */
+    QMap <QString,int> serialCount;
+    foreach (DMXInterface *iface, interfaces)
+        serialCount[iface->serial()]++;
+
+    /* Widgets still connected are kept running, as long as their lines
+     * don't move and they are not forced to another type. The other
+     * widgets are rebuilt, and devices plugged in meanwhile are appended
+     * after the kept ones */
+    foreach (DMXUSBWidget *widget, m_widgets)
+    {
+        DMXInterface *iface = NULL;
+        QString serial = widget->interface()->serial();
+        bool unique = serial.isEmpty() == false && serialCount.value(serial) == 1;
 
-    while(m_widgets.isEmpty() == false)
-        delete m_widgets.takeFirst();
+        for (int i = 0; unique && i < interfaces.count(); i++)
+        {
+            if (widget->matches(interfaces.at(i)))
+            {
+                iface = interfaces.takeAt(i);
+                break;
+            }
+        }
+
+        if (iface == NULL)
+        {
+            qDebug() << Q_FUNC_INFO << "Removing widget" << widget->uniqueName();
+            delete widget;
+            changed = true;
+            continue;
+        }
+
+        if (widget->outputBaseLine() == output_id &&
+            (widget->inputsNumber() == 0 || widget->inputBaseLine() == input_id) &&
+            (types.contains(iface->serial()) == false ||
+             types[iface->serial()].toInt() == int(widget->type())))
+        {
+            widgets << widget;
+            m_retainedWidgets << widget;
+            output_id += widget->outputsNumber();
+            input_id += widget->inputsNumber();
+
+            /* The device may have moved in the enumeration (FTD2XX index,
+             * serial port...), so reopening the widget must use the new
+             * location. The open handle, if any, is not affected. */
+            widget->interface()->updateLocation(iface);
+            delete iface;
+        }
+        else
+        {
+            qDebug() << Q_FUNC_INFO << "Recreating widget" << widget->uniqueName();
+            delete widget;
+            widgets << DMXUSBWidget::createWidget(iface, output_id, input_id);
+            changed = true;
+        }
+    }
 
-    m_widgets = DMXUSBWidget::widgets();
+    foreach (DMXInterface *iface, interfaces)
+    {
+        DMXUSBWidget *widget = DMXUSBWidget::createWidget(iface, output_id, input_id);
+        qDebug() << Q_FUNC_INFO << "Adding widget" << widget->uniqueName();
+        widgets << widget;
+        changed = true;
+    }
+
+    m_widgets = widgets;
+    m_inputs.clear();
+    m_outputs.clear();
 
     foreach (DMXUSBWidget* widget, m_widgets)
     {
@@ -75,9 +143,13 @@ bool DMXUSB::rescanWidgets()
             m_inputs.append(widget);
     }
 
-    if (m_inputs.count() + m_outputs.count() != linesCount)
+    /* Patches are reconnected when the configuration changes, but the
+     * lines of the retained widgets are left open meanwhile */
+    if (changed)
         emit configurationChanged();
 
+    m_retainedWidgets.clear();
+
     return true;
 }
 
@@ -105,7 +177,8 @@ void DMXUSB::closeOutput(quint32 output, quint32 universe)
     if (output < quint32(m_outputs.size()))
     {
         removeFromMap(output, universe, Output);
-        m_outputs.at(output)->close(output, false);
+        if (m_retainedWidgets.contains(m_outputs.at(output)) == false)
+            m_outputs.at(output)->close(output, false);
     }
 }
 
@@ -206,7 +279,8 @@ bool DMXUSB::openInput(quint32 input, quint32 universe)
         {
             EnttecDMXUSBPro* pro = (EnttecDMXUSBPro*) widget;
             connect(pro, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)),
-                    this, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)));
+                    this, SIGNAL(valueChanged(quint32,quint32,quint32,uchar)),
+                    Qt::UniqueConnection);
         }
         addToMap(universe, input, Input);
         return widget->open(input, true);
@@ -220,6 +294,8 @@ void DMXUSB::closeInput(quint32 input, quint32 universe)
     {
         DMXUSBWidget *widget = m_inputs.at(input);
         removeFromMap(input, universe, Input);
+        if (m_retainedWidgets.contains(widget))
+            return;
         widget->close(input, true);
         if (widget->type() == DMXUSBWidget::ProRXTX ||
             widget->type() == DMXUSBWidget::ProMk2 ||
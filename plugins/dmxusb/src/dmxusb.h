@@ -62,6 +62,10 @@ private:
     /** List of references to the discovered USB widgets */
     QList <DMXUSBWidget*> m_widgets;
 
+    /** Widgets kept running by rescanWidgets(). Their lines are not
+     *  closed while the patches are reconnected */
+    QList <DMXUSBWidget*> m_retainedWidgets;
+
     /************************************************************************
      * Outputs
      ************************************************************************/
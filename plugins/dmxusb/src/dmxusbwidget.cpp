@@ -65,12 +65,9 @@ QString DMXUSBWidget::interfaceTypeString() const
     return m_interface->typeString();
 }
 
-QList<DMXUSBWidget *> DMXUSBWidget::widgets()
+QList<DMXInterface *> DMXUSBWidget::interfaces()
 {
-    QList<DMXUSBWidget *> widgetList;
     QList<DMXInterface *> interfacesList;
-    quint32 input_id = 0;
-    quint32 output_id = 0;
 
 #if defined(FTD2XX)
     interfacesList.append(FTD2XXInterface::interfaces(interfacesList));
@@ -82,132 +79,155 @@ QList<DMXUSBWidget *> DMXUSBWidget::widgets()
     interfacesList.append(LibFTDIInterface::interfaces(interfacesList));
 #endif
 
+    return interfacesList;
+}
+
+DMXUSBWidget *DMXUSBWidget::createWidget(DMXInterface *iface, quint32 &output_id, quint32 &input_id)
+{
     QMap <QString,QVariant> types(DMXInterface::typeMap());
+    DMXUSBWidget *widget = NULL;
 
-    foreach (DMXInterface *iface, interfacesList)
+    if (types.contains(iface->serial()) == true)
     {
-        if (types.contains(iface->serial()) == true)
+        // Force a widget with a specific serial to either type
+        DMXUSBWidget::Type type = (DMXUSBWidget::Type) types[iface->serial()].toInt();
+        switch (type)
         {
-            // Force a widget with a specific serial to either type
-            DMXUSBWidget::Type type = (DMXUSBWidget::Type) types[iface->serial()].toInt();
-            switch (type)
+            case DMXUSBWidget::OpenTX:
+                widget = new EnttecDMXUSBOpen(iface, output_id++);
+            break;
+            case DMXUSBWidget::ProMk2:
             {
-                case DMXUSBWidget::OpenTX:
-                    widgetList << new EnttecDMXUSBOpen(iface, output_id++);
-                break;
-                case DMXUSBWidget::ProMk2:
-                {
-                    EnttecDMXUSBPro *promkii = new EnttecDMXUSBPro(iface, output_id, input_id);
-                    promkii->setOutputsNumber(2);
-                    promkii->setMidiPortsNumber(1, 1);
-                    output_id += 3;
-                    input_id += 2;
-                    widgetList << promkii;
-                }
-                break;
-                case DMXUSBWidget::UltraPro:
-                {
-                    EnttecDMXUSBPro *ultra = new EnttecDMXUSBPro(iface, output_id, input_id++);
-                    ultra->setOutputsNumber(2);
-                    ultra->setDMXKingMode();
-                    output_id += 2;
-                    widgetList << ultra;
-                }
-                break;
-                case DMXUSBWidget::DMX4ALL:
-                    widgetList << new Stageprofi(iface, output_id++);
-                break;
-                case DMXUSBWidget::VinceTX:
-                    widgetList << new VinceUSBDMX512(iface, output_id++);
-                break;
+                EnttecDMXUSBPro *promkii = new EnttecDMXUSBPro(iface, output_id, input_id);
+                promkii->setOutputsNumber(2);
+                promkii->setMidiPortsNumber(1, 1);
+                output_id += 3;
+                input_id += 2;
+                widget = promkii;
+            }
+            break;
+            case DMXUSBWidget::UltraPro:
+            {
+                EnttecDMXUSBPro *ultra = new EnttecDMXUSBPro(iface, output_id, input_id++);
+                ultra->setOutputsNumber(2);
+                ultra->setDMXKingMode();
+                output_id += 2;
+                widget = ultra;
+            }
+            break;
+            case DMXUSBWidget::DMX4ALL:
+                widget = new Stageprofi(iface, output_id++);
+            break;
+            case DMXUSBWidget::VinceTX:
+                widget = new VinceUSBDMX512(iface, output_id++);
+            break;
 #if defined(Q_WS_X11) || defined(Q_OS_LINUX) || defined(Q_OS_OSX)
-                case DMXUSBWidget::Eurolite:
-                    widgetList << new EuroliteUSBDMXPro(iface, output_id++);
-                break;
+            case DMXUSBWidget::Eurolite:
+                widget = new EuroliteUSBDMXPro(iface, output_id++);
+            break;
 #endif
-                default:
-                case DMXUSBWidget::ProRXTX:
-                    widgetList << new EnttecDMXUSBPro(iface, output_id++, input_id++);
-                break;
-            }
+            default:
+            case DMXUSBWidget::ProRXTX:
+                widget = new EnttecDMXUSBPro(iface, output_id++, input_id++);
+            break;
         }
-        else if (iface->name().toUpper().contains("PRO MK2") == true)
-        {
-            EnttecDMXUSBPro *promkii = new EnttecDMXUSBPro(iface, output_id, input_id);
-            promkii->setOutputsNumber(2);
-            promkii->setMidiPortsNumber(1, 1);
-            output_id += 3;
-            input_id += 2;
-            widgetList << promkii;
-        }
-        else if (iface->name().toUpper().contains("DMX USB PRO"))
+    }
+    else if (iface->name().toUpper().contains("PRO MK2") == true)
+    {
+        EnttecDMXUSBPro *promkii = new EnttecDMXUSBPro(iface, output_id, input_id);
+        promkii->setOutputsNumber(2);
+        promkii->setMidiPortsNumber(1, 1);
+        output_id += 3;
+        input_id += 2;
+        widget = promkii;
+    }
+    else if (iface->name().toUpper().contains("DMX USB PRO"))
+    {
+        /** Check if the device responds to label 77 and 78, so it might be a DMXking adapter */
+        int ESTAID = 0;
+        int DEVID = 0;
+        QString manName = iface->readLabel(DMXKING_USB_DEVICE_MANUFACTURER, &ESTAID);
+        qDebug() << "--------> Device Manufacturer: " << manName;
+        QString devName = iface->readLabel(DMXKING_USB_DEVICE_NAME, &DEVID);
+        qDebug() << "--------> Device Name: " << devName;
+        qDebug() << "--------> ESTA Code: " << QString::number(ESTAID, 16) << ", Device ID: " << QString::number(DEVID, 16);
+        if (ESTAID == DMXKING_ESTA_ID)
         {
-            /** Check if the device responds to label 77 and 78, so it might be a DMXking adapter */
-            int ESTAID = 0;
-            int DEVID = 0;
-            QString manName = iface->readLabel(DMXKING_USB_DEVICE_MANUFACTURER, &ESTAID);
-            qDebug() << "--------> Device Manufacturer: " << manName;
-            QString devName = iface->readLabel(DMXKING_USB_DEVICE_NAME, &DEVID);
-            qDebug() << "--------> Device Name: " << devName;
-            qDebug() << "--------> ESTA Code: " << QString::number(ESTAID, 16) << ", Device ID: " << QString::number(DEVID, 16);
-            if (ESTAID == DMXKING_ESTA_ID)
+            if (DEVID == ULTRADMX_PRO_DEV_ID)
             {
-                if (DEVID == ULTRADMX_PRO_DEV_ID)
-                {
-                    EnttecDMXUSBPro *ultra = new EnttecDMXUSBPro(iface, output_id, input_id++);
-                    ultra->setOutputsNumber(2);
-                    ultra->setDMXKingMode();
-                    ultra->setRealName(devName);
-                    output_id += 2;
-                    widgetList << ultra;
-                }
-                else
-                {
-                    EnttecDMXUSBPro *pro = new EnttecDMXUSBPro(iface, output_id++);
-                    pro->setInputsNumber(0);
-                    pro->setRealName(devName);
-                    widgetList << pro;
-                }
+                EnttecDMXUSBPro *ultra = new EnttecDMXUSBPro(iface, output_id, input_id++);
+                ultra->setOutputsNumber(2);
+                ultra->setDMXKingMode();
+                ultra->setRealName(devName);
+                output_id += 2;
+                widget = ultra;
             }
             else
             {
-                /* This is probably a Enttec DMX USB Pro widget */
-                EnttecDMXUSBPro *pro = new EnttecDMXUSBPro(iface, output_id++, input_id++);
+                EnttecDMXUSBPro *pro = new EnttecDMXUSBPro(iface, output_id++);
+                pro->setInputsNumber(0);
                 pro->setRealName(devName);
-                widgetList << pro;
+                widget = pro;
             }
         }
-        else if (iface->name().toUpper().contains("USB-DMX512 CONVERTER") == true)
-        {
-            widgetList << new VinceUSBDMX512(iface, output_id++);
-        }
-        else if (iface->vendorID() == DMXInterface::FTDIVID &&
-                 iface->productID() == DMXInterface::DMX4ALLPID)
+        else
         {
-            widgetList << new Stageprofi(iface, output_id++);
+            /* This is probably a Enttec DMX USB Pro widget */
+            EnttecDMXUSBPro *pro = new EnttecDMXUSBPro(iface, output_id++, input_id++);
+            pro->setRealName(devName);
+            widget = pro;
         }
+    }
+    else if (iface->name().toUpper().contains("USB-DMX512 CONVERTER") == true)
+    {
+        widget = new VinceUSBDMX512(iface, output_id++);
+    }
+    else if (iface->vendorID() == DMXInterface::FTDIVID &&
+             iface->productID() == DMXInterface::DMX4ALLPID)
+    {
+        widget = new Stageprofi(iface, output_id++);
+    }
 #if defined(Q_WS_X11) || defined(Q_OS_LINUX) || defined(Q_OS_OSX)
-        else if (iface->vendorID() == DMXInterface::ATMELVID &&
-                 iface->productID() == DMXInterface::NANODMXPID)
-        {
-            widgetList << new NanoDMX(iface, output_id++);
-        }
-        else if (iface->vendorID() == DMXInterface::MICROCHIPVID &&
-                 iface->productID() == DMXInterface::EUROLITEPID)
-        {
-            widgetList << new EuroliteUSBDMXPro(iface, output_id++);
-        }
+    else if (iface->vendorID() == DMXInterface::ATMELVID &&
+             iface->productID() == DMXInterface::NANODMXPID)
+    {
+        widget = new NanoDMX(iface, output_id++);
+    }
+    else if (iface->vendorID() == DMXInterface::MICROCHIPVID &&
+             iface->productID() == DMXInterface::EUROLITEPID)
+    {
+        widget = new EuroliteUSBDMXPro(iface, output_id++);
+    }
 #endif
-        else
-        {
-            /* This is probably an Open DMX USB widget */
-            widgetList << new EnttecDMXUSBOpen(iface, output_id++);
-        }
+    else
+    {
+        /* This is probably an Open DMX USB widget */
+        widget = new EnttecDMXUSBOpen(iface, output_id++);
     }
 
+    return widget;
+}
+
+QList<DMXUSBWidget *> DMXUSBWidget::widgets()
+{
+    QList<DMXUSBWidget *> widgetList;
+    quint32 input_id = 0;
+    quint32 output_id = 0;
+
+    foreach (DMXInterface *iface, interfaces())
+        widgetList << createWidget(iface, output_id, input_id);
+
     return widgetList;
 }
 
+bool DMXUSBWidget::matches(DMXInterface *iface) const
+{
+    return m_interface->serial() == iface->serial() &&
+           m_interface->name() == iface->name() &&
+           m_interface->vendorID() == iface->vendorID() &&
+           m_interface->productID() == iface->productID();
+}
+
 bool DMXUSBWidget::forceInterfaceDriver(DMXInterface::Type type)
 {
     DMXInterface *forcedIface = NULL;
@@ -361,6 +381,11 @@ QStringList DMXUSBWidget::outputNames()
     return names;
 }
 
+quint32 DMXUSBWidget::outputBaseLine() const
+{
+    return m_outputBaseLine;
+}
+
 /********************************************************************
  * Inputs
  ********************************************************************/
@@ -386,6 +411,11 @@ QStringList DMXUSBWidget::inputNames()
     return names;
 }
 
+quint32 DMXUSBWidget::inputBaseLine() const
+{
+    return m_inputBaseLine;
+}
+
 /****************************************************************************
  * Name & Serial
  ****************************************************************************/
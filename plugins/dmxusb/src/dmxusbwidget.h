@@ -68,8 +68,24 @@ public:
     /** Get the DMXInterface driver in use as a string */
     QString interfaceTypeString() const;
 
+    /** Enumerate the DMX interfaces currently connected */
+    static QList<DMXInterface *> interfaces();
+
+    /**
+     * Create the widget handling $iface. Its lines start at $output_id and
+     * $input_id, which are then moved past the lines of the widget.
+     */
+    static DMXUSBWidget *createWidget(DMXInterface *iface, quint32 &output_id, quint32 &input_id);
+
+    /** Create the widgets of all the DMX interfaces currently connected */
     static QList<DMXUSBWidget *> widgets();
 
+    /**
+     * Return true if $iface refers to the same device of this widget.
+     * Devices without a unique serial can't be told apart.
+     */
+    bool matches(DMXInterface *iface) const;
+
     bool forceInterfaceDriver(DMXInterface::Type type);
 
 private:
@@ -127,6 +143,9 @@ public:
      */
     virtual QStringList outputNames();
 
+    /** Return the QLC+ output line number where this widget outputs start */
+    quint32 outputBaseLine() const;
+
 protected:
     /** The number of output lines supported by this widget */
     int m_outputsNumber;
@@ -160,6 +179,9 @@ public:
      */
     virtual QStringList inputNames();
 
+    /** Return the QLC+ input line number where this widget inputs start */
+    quint32 inputBaseLine() const;
+
 protected:
     /** The number of output lines supported by this widget */
     int m_inputsNumber;
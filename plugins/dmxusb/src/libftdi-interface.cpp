@@ -110,6 +110,12 @@ quint8 LibFTDIInterface::busLocation()
     return m_busLocation;
 }
 
+void LibFTDIInterface::updateLocation(DMXInterface *iface)
+{
+    DMXInterface::updateLocation(iface);
+    m_busLocation = iface->busLocation();
+}
+
 DMXInterface::Type LibFTDIInterface::type()
 {
     return DMXInterface::libFTDI;
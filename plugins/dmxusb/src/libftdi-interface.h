@@ -45,6 +45,9 @@ public:
     /** @reimpl */
     quint8 busLocation();
 
+    /** @reimpl */
+    void updateLocation(DMXInterface *iface);
+
     /************************************************************************
      * DMX/Serial Interface Methods
      ************************************************************************/
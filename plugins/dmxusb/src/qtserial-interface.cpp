@@ -147,6 +147,13 @@ void QtSerialInterface::setInfo(QSerialPortInfo info)
     m_info = info;
 }
 
+void QtSerialInterface::updateLocation(DMXInterface *iface)
+{
+    DMXInterface::updateLocation(iface);
+    if (iface->type() == DMXInterface::QtSerial)
+        m_info = static_cast<QtSerialInterface *>(iface)->m_info;
+}
+
 bool QtSerialInterface::open()
 {
     if (isOpen() == true)
@@ -38,6 +38,9 @@ public:
 
     void setInfo(QSerialPortInfo info);
 
+    /** @reimpl */
+    void updateLocation(DMXInterface *iface);
+
     /** @reimpl */
     QString readLabel(uchar label, int *ESTA_code);
 
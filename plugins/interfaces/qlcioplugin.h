@@ -274,6 +274,19 @@ signals:
      */
     void valueChanged(quint32 universe, quint32 input, quint32 channel, uchar value, const QString& key = 0);
 
+    /**
+     * Tells that a whole DMX frame has been received on an input line.
+     * Plugins receiving complete frames (like network protocols) can emit
+     * this in addition to valueChanged(), so that universes in passthrough
+     * mode can forward the frame to their output with the lowest latency.
+     * Receivers are invoked directly in the thread emitting the signal.
+     *
+     * @param universe The universe ID detected from the data received
+     * @param input The input line that received the frame
+     * @param data The DMX values of the frame
+     */
+    void inputFrameReceived(quint32 universe, quint32 input, const QByteArray& data);
+
     /*************************************************************************
      * Configure
      *************************************************************************/
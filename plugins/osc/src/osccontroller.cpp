@@ -22,6 +22,11 @@
 #include <QMutexLocker>
 #include <QByteArray>
 #include <QDebug>
+#include <cstring>
+
+/** Maximum number of interned OSC paths. Paths are received from the
+ *  network, so they must not grow the table forever */
+#define MAX_INTERNED_PATHS  1024
 
 OSCController::OSCController(QString ipaddr, Type type, quint32 line, QObject *parent)
     : QObject(parent)
@@ -33,6 +38,8 @@ OSCController::OSCController(QString ipaddr, Type type, quint32 line, QObject *p
     , m_packetizer(new OSCPacketizer())
 {
     qDebug() << "[OSCController] type: " << type;
+    m_messages.reserve(16);
+    m_values.reserve(256);
     // Ensure packets will be sent from the correct interface
     m_outputSocket->bind(m_ipAddr, 0);
 }
@@ -335,6 +342,35 @@ void OSCController::sendFeedback(const quint32 universe, quint32 channel, uchar
         m_packetSent++;
 }
 
+OSCController::PathInfo &OSCController::internPath(const OSCPacketizer::Message &msg)
+{
+    // looking up raw data doesn't copy the path
+    QByteArray rawPath = QByteArray::fromRawData(msg.path, msg.pathLength);
+    QHash<QByteArray, PathInfo>::iterator it = m_paths.find(rawPath);
+
+    if (it == m_paths.end())
+    {
+        // start over when full. Paths still in use are interned again.
+        if (m_paths.count() >= MAX_INTERNED_PATHS)
+            m_paths.clear();
+
+        PathInfo info;
+        info.path = QString(QByteArray(msg.path, msg.pathLength));
+        info.channel = getHash(info.path);
+        it = m_paths.insert(QByteArray(msg.path, msg.pathLength), info);
+    }
+
+    PathInfo& info = it.value();
+    for (int i = info.valueKeys.count(); i < msg.valuesCount && msg.valuesCount > 1; i++)
+    {
+        QString key = QString("%1_%2").arg(info.path).arg(i);
+        info.valueKeys.append(key);
+        info.valueChannels.append(getHash(key));
+    }
+
+    return info;
+}
+
 void OSCController::handlePacket(QUdpSocket* socket, QByteArray const& datagram, QHostAddress const& senderAddress)
 {
 #if _DEBUG_RECEIVED_PACKETS
@@ -343,37 +379,37 @@ void OSCController::handlePacket(QUdpSocket* socket, QByteArray const& datagram,
     Q_UNUSED(senderAddress);
 #endif
 
-    QList< QPair<QString, QByteArray> > messages = m_packetizer->parsePacket(datagram);
+    m_packetizer->parsePacket(datagram, m_messages, m_values);
 
-    QListIterator <QPair<QString,QByteArray> > it(messages);
-    while (it.hasNext() == true)
+    for (int m = 0; m < m_messages.count(); m++)
     {
-        QPair <QString,QByteArray> msg(it.next());
-
-        QString path = msg.first;
-        QByteArray values = msg.second;
-
-        qDebug() << "[OSC] message has path:" << path << "values:" << values.count();
-        if (values.isEmpty())
+        const OSCPacketizer::Message& msg = m_messages.at(m);
+        if (msg.valuesCount == 0)
             continue;
 
+        PathInfo& pathInfo = internPath(msg);
+        const uchar* values = m_values.constData() + msg.valuesIndex;
+
         for (QMap<quint32, UniverseInfo>::iterator it = m_universeMap.begin(); it != m_universeMap.end(); ++it)
         {
             quint32 universe = it.key();
             UniverseInfo& info = it.value();
             if (info.inputSocket == socket)
             {
-                if (values.count() > 1)
+                if (msg.valuesCount > 1)
                 {
-                    info.multipartCache[path] = values;
-                    for(int i = 0; i < values.count(); i++)
-                    {
-                        QString modPath = QString("%1_%2").arg(path).arg(i);
-                        emit valueChanged(universe, m_line, getHash(modPath), (uchar)values.at(i), modPath);
-                    }
+                    // update the cached values in place
+                    QByteArray& cache = info.multipartCache[pathInfo.path];
+                    if (cache.size() != msg.valuesCount)
+                        cache.resize(msg.valuesCount);
+                    memcpy(cache.data(), values, msg.valuesCount);
+
+                    for (int i = 0; i < msg.valuesCount; i++)
+                        emit valueChanged(universe, m_line, pathInfo.valueChannels.at(i), values[i],
+                                          pathInfo.valueKeys.at(i));
                 }
                 else
-                    emit valueChanged(universe, m_line, getHash(path), (uchar)values.at(0), path);
+                    emit valueChanged(universe, m_line, pathInfo.channel, values[0], pathInfo.path);
             }
         }
     }
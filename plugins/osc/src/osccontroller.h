@@ -25,6 +25,7 @@
 #include <QScopedPointer>
 #include <QtNetwork>
 #include <QObject>
+#include <QVector>
 #include <QHash>
 #include <QMap>
 
@@ -127,6 +128,23 @@ protected:
     quint16 getHash(QString path);
 
 private:
+    /** An OSC path received by this controller, with the channels of its values */
+    struct PathInfo
+    {
+        QString path;
+        quint16 channel;
+
+        /** Keys ($path_0, $path_1, ...) and channels of the values of a
+         *  multiple value path, added as soon as the values are received */
+        QStringList valueKeys;
+        QVector<quint16> valueChannels;
+    };
+
+    /** Return the information of the OSC path held by $msg. The path is
+     *  interned the first time it is received, so that receiving it
+     *  again doesn't allocate nor compute hashes anymore */
+    PathInfo& internPath(const OSCPacketizer::Message& msg);
+
     void handlePacket(QUdpSocket* socket, QByteArray const& datagram, QHostAddress const& senderAddress);
 
 private slots:
@@ -170,6 +188,14 @@ private:
       * to quickly retrieve a unique channel number
       */
     QHash<QString, quint16> m_hashMap;
+
+    /** The OSC paths received so far, by their raw bytes.
+     *  Cleared when it reaches MAX_INTERNED_PATHS entries */
+    QHash<QByteArray, PathInfo> m_paths;
+
+    /** Buffers reused to parse the received packets */
+    QVector<OSCPacketizer::Message> m_messages;
+    QVector<uchar> m_values;
 };
 
 #endif
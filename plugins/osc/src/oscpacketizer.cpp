@@ -0,0 +1,257 @@
+/*
+  Q Light Controller Plus
+  oscpacketizer.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "oscpacketizer.h"
+
+#include <QStringList>
+#include <cstring>
+#include <QDebug>
+
+OSCPacketizer::OSCPacketizer()
+{
+}
+
+OSCPacketizer::~OSCPacketizer()
+{
+}
+
+/*********************************************************************
+ * Sender functions
+ *********************************************************************/
+
+void OSCPacketizer::setupOSCDmx(QByteArray &data, quint32 universe, quint32 channel, uchar value)
+{
+    data.clear();
+    QString path = QString("/%1/dmx/%2").arg(universe).arg(channel);
+    data.append(path);
+
+    // add trailing zeros to reach a multiple of 4
+    int zeroNumber = 4 - (path.length() % 4);
+    if (zeroNumber > 0)
+        data.append(QByteArray(zeroNumber, 0x00));
+
+    data.append(",f");
+    data.append((char)0x00);
+    data.append((char)0x00);
+    // Output value
+    float fVal = (float)value / 255.f;
+    data.append(*(((char *)&fVal) + 3));
+    data.append(*(((char *)&fVal) + 2));
+    data.append(*(((char *)&fVal) + 1));
+    data.append(*(((char *)&fVal) + 0));
+}
+
+void OSCPacketizer::setupOSCGeneric(QByteArray &data, QString &path, QString types, QByteArray &values)
+{
+    data.clear();
+    if (path.isEmpty())
+    {
+        qDebug() << Q_FUNC_INFO << "Empty path, can't create packet";
+        return;
+    }
+
+    data.append(path);
+    // add trailing zeros to reach a multiple of 4
+    int zeroNumber = 4 - (path.length() % 4);
+    if (zeroNumber > 0)
+        data.append(QByteArray(zeroNumber, 0x00));
+
+    data.append(",");
+    data.append(types);
+
+    zeroNumber = 4 - ((types.length() + 1) % 4);
+    if (zeroNumber > 0)
+        data.append(QByteArray(zeroNumber, 0x00));
+
+    for (int i = 0; i < types.length() && i < values.length(); i++)
+    {
+        if (types.at(i) == 'f')
+        {
+            uchar val = (uchar)values.at(i);
+            float fVal = (float)val / 255.f;
+            data.append(*(((char *)&fVal) + 3));
+            data.append(*(((char *)&fVal) + 2));
+            data.append(*(((char *)&fVal) + 1));
+            data.append(*(((char *)&fVal) + 0));
+        }
+    }
+}
+
+/*********************************************************************
+ * Receiver functions
+ *********************************************************************/
+static inline quint32 readUInt32(const char* data)
+{
+    return (quint32(uchar(data[0])) << 24) | (quint32(uchar(data[1])) << 16) |
+           (quint32(uchar(data[2])) << 8) | quint32(uchar(data[3]));
+}
+
+/** Round $pos to the next multiple of 4, as OSC fields are 32 bit aligned */
+static inline int align4(int pos)
+{
+    return (pos + 3) & ~3;
+}
+
+bool OSCPacketizer::parseMessage(const char* data, int size, Message& msg, QVector<uchar>& values)
+{
+    msg.path = data;
+    msg.pathLength = int(qstrnlen(data, uint(size)));
+    msg.valuesIndex = values.count();
+    msg.valuesCount = 0;
+
+    if (msg.pathLength == 0 || msg.pathLength == size)
+        return false;
+
+    // the type tags string follows the path, starting with a comma
+    int tagPos = align4(msg.pathLength + 1);
+    if (tagPos >= size || data[tagPos] != ',')
+        return false;
+
+    int tagEnd = tagPos + int(qstrnlen(data + tagPos, uint(size - tagPos)));
+    int currPos = align4(tagEnd + 1);
+
+    for (int i = tagPos + 1; i < tagEnd && currPos < size; i++)
+    {
+        switch (data[i])
+        {
+            case 'i':
+            {
+                if (currPos + 4 > size)
+                    return msg.valuesCount > 0;
+
+                quint32 iVal = readUInt32(data + currPos);
+
+                if (iVal < 256)
+                    values.append(uchar(iVal));
+                else
+                    values.append(uchar(iVal / 0xFFFFFF));
+
+                msg.valuesCount++;
+                currPos += 4;
+            }
+            break;
+            case 'f':
+            {
+                if (currPos + 4 > size)
+                    return msg.valuesCount > 0;
+
+                quint32 iVal = readUInt32(data + currPos);
+                float fVal;
+                memcpy(&fVal, &iVal, sizeof(fVal));
+
+                values.append(uchar(char(255.0 * fVal)));
+                msg.valuesCount++;
+                currPos += 4;
+            }
+            break;
+            case 's':
+            {
+                // strings are skipped, including their trailing zeros
+                currPos = align4(currPos + int(qstrnlen(data + currPos, uint(size - currPos))) + 1);
+            }
+            break;
+            case 'b':
+            {
+                if (currPos + 4 > size)
+                    return msg.valuesCount > 0;
+
+                // blobs are skipped, including their size
+                quint32 blobSize = readUInt32(data + currPos);
+                if (blobSize > quint32(size - currPos - 4))
+                    return msg.valuesCount > 0;
+
+                currPos = align4(currPos + 4 + int(blobSize));
+            }
+            break;
+            case 't':
+            {
+                // A OSC timestamp would be helpful to defer
+                // value changes, but since QLC+ plugins don't support
+                // such thing, let's skip it.
+                currPos += 8;
+            }
+            break;
+            default: break;
+        }
+    }
+
+    return true;
+}
+
+void OSCPacketizer::parseBundle(const char* data, int size, QVector<Message>& messages, QVector<uchar>& values)
+{
+    // 8 bytes for '#bundle\0' and 8 bytes for a timestamp that we don't handle
+    int bufPos = 16;
+
+    // a bundle contains other bundles or messages, each one starting with its size
+    while (bufPos + 4 <= size)
+    {
+        int msgSize = int(readUInt32(data + bufPos));
+        bufPos += 4;
+
+        if (msgSize <= 0 || bufPos + msgSize > size)
+            return;
+
+        const char* msgData = data + bufPos;
+        if (msgSize >= 16 && qstrncmp(msgData, "#bundle", 8) == 0)
+        {
+            parseBundle(msgData, msgSize, messages, values);
+        }
+        else
+        {
+            Message msg;
+            if (parseMessage(msgData, msgSize, msg, values) == true)
+                messages.append(msg);
+        }
+
+        bufPos += msgSize;
+    }
+}
+
+int OSCPacketizer::parsePacket(QByteArray const& data, QVector<Message>& messages, QVector<uchar>& values)
+{
+    // resizing keeps the capacity reserved by the caller
+    messages.resize(0);
+    values.resize(0);
+
+    const char* buf = data.constData();
+    int size = data.size();
+
+    if (size == 0)
+        return 0;
+
+    // check wether we need to parse a bundle or a single message
+    if (buf[0] == '#')
+    {
+        if (size < 20 || qstrncmp(buf, "#bundle", 8) != 0)
+        {
+            qWarning() << "[OSC] Found an unsupported message type !" << data;
+            return 0;
+        }
+        parseBundle(buf, size, messages, values);
+    }
+    else
+    {
+        Message msg;
+        if (parseMessage(buf, size, msg, values) == true)
+            messages.append(msg);
+    }
+
+    return messages.count();
+}
@@ -20,8 +20,7 @@
 #include <QHostAddress>
 #include <QByteArray>
 #include <QString>
-#include <QHash>
-#include <QPair>
+#include <QVector>
 
 #ifndef OSCPACKETIZER_H
 #define OSCPACKETIZER_H
@@ -71,27 +70,57 @@ public:
     /*********************************************************************
      * Receiver functions
      *********************************************************************/
+public:
+    /** A message parsed from a received OSC packet */
+    struct Message
+    {
+        /** The OSC path, pointing into the packet data (not null terminated) */
+        const char* path;
+        int pathLength;
+
+        /** Position and number of the message values in the values buffer */
+        int valuesIndex;
+        int valuesCount;
+    };
+
 private:
     /**
      * Extract an OSC message received from a buffer.
-     * As a result, it returns the extracted OSC path and values
-     * (empty if invalid)
+     * The extracted values are appended to $values
      *
      * @param data the buffer containing the OSC message
-     * @param path the OSC path extracted from the buffer
-     * @param values the array of values extracted from the buffer
+     * @param size the size of the OSC message in bytes
+     * @param msg the message extracted from the buffer
+     * @param values the array where the extracted values are appended
      * @return true on successful parsing, otherwise false
      */
-    bool parseMessage(QByteArray const& data, QString& path, QByteArray& values);
+    bool parseMessage(const char* data, int size, Message& msg, QVector<uchar>& values);
+
+    /**
+     * Extract the OSC messages of a bundle received from a buffer,
+     * including the ones of nested bundles.
+     *
+     * @param data the buffer containing the OSC bundle
+     * @param size the size of the OSC bundle in bytes
+     * @param messages the list where the extracted messages are appended
+     * @param values the array where the extracted values are appended
+     */
+    void parseBundle(const char* data, int size, QVector<Message>& messages, QVector<uchar>& values);
+
 public:
     /**
      * Parse a OSC packet received from the network.
+     * Nothing is copied from $data, so the returned messages are valid
+     * as long as $data is. Both $messages and $values are cleared first
+     * and keep their capacity, so nothing is allocated when the same
+     * buffers are reused for every packet.
      *
      * @param data the payload of a UDP packet received from the network
-     * @return a list of couples of OSC path/values
+     * @param messages the list of the OSC messages found in $data
+     * @param values the values of all the messages found in $data
+     * @return the number of messages found
      */
-    QList<QPair<QString, QByteArray> > parsePacket(QByteArray const& data);
-
+    int parsePacket(QByteArray const& data, QVector<Message>& messages, QVector<uchar>& values);
 };
 
 #endif
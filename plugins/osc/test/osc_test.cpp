@@ -0,0 +1,320 @@
+/*
+  Q Light Controller Plus
+  osc_test.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QtTest>
+#include <cstring>
+
+#define private public
+#include "osc_test.h"
+#include "oscpacketizer.h"
+#undef private
+
+/****************************************************************************
+ * Packet helpers
+ ****************************************************************************/
+
+/** An OSC string: null terminated and padded to a multiple of 4 bytes */
+static QByteArray oscString(const char* str)
+{
+    QByteArray data(str);
+    data.append('\0');
+    while (data.size() % 4)
+        data.append('\0');
+    return data;
+}
+
+static QByteArray oscInt(quint32 value)
+{
+    QByteArray data;
+    data.append(char(value >> 24));
+    data.append(char(value >> 16));
+    data.append(char(value >> 8));
+    data.append(char(value));
+    return data;
+}
+
+static QByteArray oscFloat(float value)
+{
+    quint32 iVal;
+    memcpy(&iVal, &value, sizeof(iVal));
+    return oscInt(iVal);
+}
+
+static QByteArray oscBundle(const QList<QByteArray>& elements)
+{
+    // the timestamp 1 means "immediately"
+    QByteArray data = oscString("#bundle") + oscInt(0) + oscInt(1);
+    foreach (const QByteArray& element, elements)
+        data += oscInt(quint32(element.size())) + element;
+    return data;
+}
+
+static QByteArray messagePath(const OSCPacketizer::Message& msg)
+{
+    return QByteArray(msg.path, msg.pathLength);
+}
+
+/****************************************************************************
+ * OSC tests
+ ****************************************************************************/
+
+void OSC_Test::parseAlignedTags()
+{
+    OSCPacketizer op;
+    QVector<OSCPacketizer::Message> messages;
+    QVector<uchar> values;
+
+    // path and tags are a multiple of 4 bytes, so they're followed by 4 zeros
+    QByteArray packet = oscString("/abc") + oscString(",iii") +
+                        oscInt(1) + oscInt(2) + oscInt(255);
+    QCOMPARE(packet.size(), 8 + 8 + 12);
+
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+    QCOMPARE(messagePath(messages[0]), QByteArray("/abc"));
+    QCOMPARE(messages[0].valuesIndex, 0);
+    QCOMPARE(messages[0].valuesCount, 3);
+    QCOMPARE(values.count(), 3);
+    QCOMPARE(values[0], uchar(1));
+    QCOMPARE(values[1], uchar(2));
+    QCOMPARE(values[2], uchar(255));
+}
+
+void OSC_Test::parseMisalignedTags()
+{
+    OSCPacketizer op;
+    QVector<OSCPacketizer::Message> messages;
+    QVector<uchar> values;
+
+    // path and tags are padded to the next multiple of 4 bytes
+    QByteArray packet = oscString("/ab") + oscString(",if") + oscInt(42) + oscFloat(0.5);
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+    QCOMPARE(messagePath(messages[0]), QByteArray("/ab"));
+    QCOMPARE(messages[0].valuesCount, 2);
+    QCOMPARE(values[0], uchar(42));
+    QCOMPARE(values[1], uchar(127));
+
+    packet = oscString("/a/bcd") + oscString(",f") + oscFloat(0.25);
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+    QCOMPARE(messagePath(messages[0]), QByteArray("/a/bcd"));
+    QCOMPARE(messages[0].valuesCount, 1);
+    QCOMPARE(values[0], uchar(63));
+}
+
+void OSC_Test::parseStringsAndBlobs()
+{
+    OSCPacketizer op;
+    QVector<OSCPacketizer::Message> messages;
+    QVector<uchar> values;
+
+    // strings and blobs are skipped, including their padding
+    QByteArray blob = oscInt(3) + QByteArray("xyz") + QByteArray(1, '\0');
+    QByteArray packet = oscString("/mixed") + oscString(",sbi") +
+                        oscString("hello") + blob + oscInt(9);
+
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+    QCOMPARE(messages[0].valuesCount, 1);
+    QCOMPARE(values[0], uchar(9));
+
+    // timestamps are skipped
+    packet = oscString("/time") + oscString(",ti") + oscInt(0) + oscInt(1) + oscInt(5);
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+    QCOMPARE(messages[0].valuesCount, 1);
+    QCOMPARE(values[0], uchar(5));
+}
+
+void OSC_Test::parseTruncated()
+{
+    OSCPacketizer op;
+    QVector<OSCPacketizer::Message> messages;
+    QVector<uchar> values;
+
+    // the values received before the end are kept
+    QByteArray packet = oscString("/ab") + oscString(",ii") + oscInt(1);
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+    QCOMPARE(messages[0].valuesCount, 1);
+    QCOMPARE(values[0], uchar(1));
+
+    // a message without values
+    packet = oscString("/ab") + oscString(",i");
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+    QCOMPARE(messages[0].valuesCount, 0);
+
+    // a value cut in half
+    packet = oscString("/ab") + oscString(",i") + oscInt(1).left(2);
+    QCOMPARE(op.parsePacket(packet, messages, values), 0);
+
+    // a blob larger than the packet
+    packet = oscString("/ab") + oscString(",bi") + oscInt(100) + QByteArray("xyz") + oscInt(1);
+    QCOMPARE(op.parsePacket(packet, messages, values), 0);
+
+    // a path without terminator
+    packet = QByteArray("/abc");
+    QCOMPARE(op.parsePacket(packet, messages, values), 0);
+
+    // a path without tags
+    packet = oscString("/abc");
+    QCOMPARE(op.parsePacket(packet, messages, values), 0);
+
+    // tags without terminator
+    packet = oscString("/ab") + QByteArray(",i");
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+    QCOMPARE(messages[0].valuesCount, 0);
+}
+
+void OSC_Test::parseInvalid()
+{
+    OSCPacketizer op;
+    QVector<OSCPacketizer::Message> messages;
+    QVector<uchar> values;
+
+    QCOMPARE(op.parsePacket(QByteArray(), messages, values), 0);
+
+    // an empty path
+    QByteArray packet = oscString("") + oscString(",i") + oscInt(1);
+    QCOMPARE(op.parsePacket(packet, messages, values), 0);
+
+    // tags not starting with a comma
+    packet = oscString("/ab") + oscString("ii") + oscInt(1) + oscInt(2);
+    QCOMPARE(op.parsePacket(packet, messages, values), 0);
+
+    // not a bundle
+    packet = oscString("#foo") + oscInt(0) + oscInt(1) + oscInt(0);
+    QCOMPARE(op.parsePacket(packet, messages, values), 0);
+
+    // a bundle too short to contain anything
+    packet = oscString("#bundle") + oscInt(0) + oscInt(1);
+    QCOMPARE(op.parsePacket(packet, messages, values), 0);
+}
+
+void OSC_Test::parseBundle()
+{
+    OSCPacketizer op;
+    QVector<OSCPacketizer::Message> messages;
+    QVector<uchar> values;
+
+    QList<QByteArray> elements;
+    elements << oscString("/a") + oscString(",i") + oscInt(10);
+    elements << oscString("/bcd") + oscString(",ii") + oscInt(20) + oscInt(30);
+    QByteArray packet = oscBundle(elements);
+
+    QCOMPARE(op.parsePacket(packet, messages, values), 2);
+    QCOMPARE(messagePath(messages[0]), QByteArray("/a"));
+    QCOMPARE(messages[0].valuesIndex, 0);
+    QCOMPARE(messages[0].valuesCount, 1);
+    QCOMPARE(messagePath(messages[1]), QByteArray("/bcd"));
+    QCOMPARE(messages[1].valuesIndex, 1);
+    QCOMPARE(messages[1].valuesCount, 2);
+
+    QCOMPARE(values.count(), 3);
+    QCOMPARE(values[0], uchar(10));
+    QCOMPARE(values[1], uchar(20));
+    QCOMPARE(values[2], uchar(30));
+}
+
+void OSC_Test::parseNestedBundles()
+{
+    OSCPacketizer op;
+    QVector<OSCPacketizer::Message> messages;
+    QVector<uchar> values;
+
+    QList<QByteArray> inner;
+    inner << oscString("/z") + oscString(",i") + oscInt(3);
+
+    QList<QByteArray> middle;
+    middle << oscString("/y") + oscString(",i") + oscInt(2);
+    middle << oscBundle(inner);
+
+    QList<QByteArray> outer;
+    outer << oscString("/x") + oscString(",i") + oscInt(1);
+    outer << oscBundle(middle);
+    outer << oscString("/w") + oscString(",i") + oscInt(4);
+
+    QByteArray packet = oscBundle(outer);
+
+    // messages are returned in the order they appear in the packet
+    QCOMPARE(op.parsePacket(packet, messages, values), 4);
+    QCOMPARE(messagePath(messages[0]), QByteArray("/x"));
+    QCOMPARE(messagePath(messages[1]), QByteArray("/y"));
+    QCOMPARE(messagePath(messages[2]), QByteArray("/z"));
+    QCOMPARE(messagePath(messages[3]), QByteArray("/w"));
+
+    for (int i = 0; i < 4; i++)
+    {
+        QCOMPARE(messages[i].valuesIndex, i);
+        QCOMPARE(messages[i].valuesCount, 1);
+        QCOMPARE(values[i], uchar(i + 1));
+    }
+}
+
+void OSC_Test::parseTruncatedBundle()
+{
+    OSCPacketizer op;
+    QVector<OSCPacketizer::Message> messages;
+    QVector<uchar> values;
+
+    QList<QByteArray> elements;
+    elements << oscString("/a") + oscString(",i") + oscInt(10);
+
+    // an element larger than the rest of the packet
+    QByteArray packet = oscBundle(elements) + oscInt(64) + oscString("/b") + oscString(",i");
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+    QCOMPARE(messagePath(messages[0]), QByteArray("/a"));
+
+    // an empty element
+    packet = oscBundle(elements) + oscInt(0) + oscString("/b") + oscString(",i") + oscInt(20);
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+
+    // a size cut in half
+    packet = oscBundle(elements) + oscInt(12).left(2);
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+
+    // a nested bundle larger than its element is not read past the element
+    QList<QByteArray> inner;
+    inner << oscString("/z") + oscString(",i") + oscInt(3);
+    QByteArray nested = oscBundle(inner);
+    packet = oscString("#bundle") + oscInt(0) + oscInt(1) +
+             oscInt(quint32(nested.size() - 4)) + nested;
+    QCOMPARE(op.parsePacket(packet, messages, values), 0);
+}
+
+void OSC_Test::parseReusesBuffers()
+{
+    OSCPacketizer op;
+    QVector<OSCPacketizer::Message> messages;
+    QVector<uchar> values;
+    messages.reserve(16);
+    values.reserve(256);
+
+    QList<QByteArray> elements;
+    elements << oscString("/a") + oscString(",i") + oscInt(10);
+    elements << oscString("/b") + oscString(",ii") + oscInt(20) + oscInt(30);
+    QByteArray bundle = oscBundle(elements);
+    QCOMPARE(op.parsePacket(bundle, messages, values), 2);
+
+    // previous results are cleared, capacity is kept
+    QByteArray packet = oscString("/c") + oscString(",i") + oscInt(40);
+    QCOMPARE(op.parsePacket(packet, messages, values), 1);
+    QCOMPARE(messages.count(), 1);
+    QCOMPARE(values.count(), 1);
+    QCOMPARE(values[0], uchar(40));
+    QVERIFY(messages.capacity() >= 16);
+    QVERIFY(values.capacity() >= 256);
+}
+
+QTEST_MAIN(OSC_Test)
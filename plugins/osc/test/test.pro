@@ -0,0 +1,17 @@
+include(../../../variables.pri)
+include(../../../coverage.pri)
+
+TEMPLATE = app
+LANGUAGE = C++
+TARGET   = osc_test
+
+QT      += core testlib network
+QT      -= gui
+
+INCLUDEPATH += ../../interfaces
+INCLUDEPATH += ../src
+DEPENDPATH  += ../src
+
+# Test sources
+HEADERS += osc_test.h ../src/oscpacketizer.h
+SOURCES += osc_test.cpp ../src/oscpacketizer.cpp
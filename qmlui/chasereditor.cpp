@@ -40,7 +40,7 @@ QVariant ChaserEditor::stepsList() const
 
     if (m_chaser != NULL)
     {
-        foreach(ChaserStep step, m_chaser->steps())
+        foreach(const ChaserStep &step, m_chaser->steps())
         {
             QVariantMap stepMap;
             stepMap.insert("funcID", step.fid);
@@ -71,15 +71,18 @@ QVariant ChaserEditor::stepsList() const
                 break;
             }
 
+            uint duration = step.duration;
+            uint hold = step.hold;
+
             switch (m_chaser->durationMode())
             {
                 default:
                 case Chaser::Common:
-                    step.duration = m_chaser->duration();
-                    step.hold = Function::speedSubstract(step.duration, step.fadeIn);
+                    duration = m_chaser->duration();
+                    hold = Function::speedSubstract(duration, step.fadeIn);
                 case Chaser::PerStep:
-                    stepMap.insert("hold", Function::speedToString(step.hold));
-                    stepMap.insert("duration", Function::speedToString(step.duration));
+                    stepMap.insert("hold", Function::speedToString(hold));
+                    stepMap.insert("duration", Function::speedToString(duration));
                 break;
             }
 
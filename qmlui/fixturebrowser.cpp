@@ -35,6 +35,12 @@ FixtureBrowser::FixtureBrowser(QQuickView *view, Doc *doc, QObject *parent)
     Q_ASSERT(m_view != NULL);
 }
 
+FixtureBrowser::~FixtureBrowser()
+{
+    if (m_definition != NULL)
+        m_definition->deref();
+}
+
 QStringList FixtureBrowser::manufacturers()
 {
     QStringList mfList = m_doc->fixtureDefCache()->manufacturers();
@@ -61,7 +67,18 @@ QStringList FixtureBrowser::modes(QString manufacturer, QString model)
 {
     QStringList modesList;
 
-    m_definition = m_doc->fixtureDefCache()->fixtureDef(manufacturer, model);
+    QLCFixtureDef *definition = m_doc->fixtureDefCache()->fixtureDef(manufacturer, model);
+
+    // keep the browsed definition loaded and release the previous one
+    if (definition != m_definition)
+    {
+        if (definition != NULL)
+            definition->ref();
+        if (m_definition != NULL)
+            m_definition->deref();
+        m_definition = definition;
+        m_doc->fixtureDefCache()->releaseUnused();
+    }
 
     if (m_definition != NULL)
     {
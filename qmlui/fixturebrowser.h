@@ -33,6 +33,7 @@ class FixtureBrowser : public QObject
 
 public:
     FixtureBrowser(QQuickView *view, Doc *doc, QObject *parent = 0);
+    ~FixtureBrowser();
 
     Q_INVOKABLE QStringList manufacturers();
     Q_INVOKABLE int genericIndex();
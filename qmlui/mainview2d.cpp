@@ -371,18 +371,16 @@ void MainView2D::updateFixture(Fixture *fixture)
             {
                 if(colorSet)
                     break;
-                foreach(QLCCapability *cap, ch->capabilities())
+                QLCCapability *cap = ch->searchCapability(value);
+                if (cap != NULL)
                 {
-                    if (value >= cap->min() && value <= cap->max())
+                    QColor wheelColor = cap->resourceColor1();
+                    if (wheelColor.isValid())
                     {
-                        QColor wheelColor = cap->resourceColor1();
-                        if (wheelColor.isValid())
-                        {
-                            QMetaObject::invokeMethod(fxItem, "setHeadColor",
-                                    Q_ARG(QVariant, 0),
-                                    Q_ARG(QVariant, wheelColor));
-                            colorSet = true;
-                        }
+                        QMetaObject::invokeMethod(fxItem, "setHeadColor",
+                                Q_ARG(QVariant, 0),
+                                Q_ARG(QVariant, wheelColor));
+                        colorSet = true;
                     }
                 }
             }
@@ -392,23 +390,21 @@ void MainView2D::updateFixture(Fixture *fixture)
                 if (goboSet)
                     break;
 
-                foreach(QLCCapability *cap, ch->capabilities())
+                QLCCapability *cap = ch->searchCapability(value);
+                if (cap != NULL)
                 {
-                    if (value >= cap->min() && value <= cap->max())
+                    QString resName = cap->resourceName();
+
+                    if(resName.isEmpty() == false && resName.contains("open.png") == false)
                     {
-                        QString resName = cap->resourceName();
-
-                        if(resName.isEmpty() == false && resName.contains("open.png") == false)
-                        {
-                            QMetaObject::invokeMethod(fxItem, "setGoboPicture",
-                                    Q_ARG(QVariant, 0),
-                                    Q_ARG(QVariant, resName));
-                            // here we don't look for any other gobos, so if a
-                            // fixture has more than one gobo wheel, the second
-                            // one will be skipped if the first one has been set
-                            // to a non-open gobo
-                            goboSet = true;
-                        }
+                        QMetaObject::invokeMethod(fxItem, "setGoboPicture",
+                                Q_ARG(QVariant, 0),
+                                Q_ARG(QVariant, resName));
+                        // here we don't look for any other gobos, so if a
+                        // fixture has more than one gobo wheel, the second
+                        // one will be skipped if the first one has been set
+                        // to a non-open gobo
+                        goboSet = true;
                     }
                 }
             }
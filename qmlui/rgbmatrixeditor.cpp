@@ -20,6 +20,7 @@
 #include <QTimer>
 #include <QDebug>
 
+#include "rgbmatrixpreview.h"
 #include "rgbmatrixeditor.h"
 
 #include "rgbmatrix.h"
@@ -31,6 +32,8 @@ RGBMatrixEditor::RGBMatrixEditor(QQuickView *view, Doc *doc, QObject *parent)
     : FunctionEditor(view, doc, parent)
     , m_matrix(NULL)
     , m_previewTimer(new QTimer(this))
+    , m_previewRenderer(new RGBMatrixPreview(this))
+    , m_previewIterator(0)
 {
     m_view->rootContext()->setContextProperty("rgbMatrixEditor", this);
 
@@ -40,6 +43,7 @@ RGBMatrixEditor::RGBMatrixEditor(QQuickView *view, Doc *doc, QObject *parent)
 RGBMatrixEditor::~RGBMatrixEditor()
 {
     m_previewTimer->stop();
+    m_previewRenderer->stop();
     m_view->rootContext()->setContextProperty("rgbMatrixEditor", NULL);
 }
 
@@ -140,6 +144,7 @@ void RGBMatrixEditor::setStartColor(QColor algoStartColor)
 
     m_matrix->setStartColor(algoStartColor);
     m_matrix->calculateColorDelta();
+    m_previewRenderer->restart(m_matrix);
 
     emit startColorChanged(algoStartColor);
 }
@@ -159,6 +164,7 @@ void RGBMatrixEditor::setEndColor(QColor algoEndColor)
 
     m_matrix->setEndColor(algoEndColor);
     m_matrix->calculateColorDelta();
+    m_previewRenderer->restart(m_matrix);
 
     emit endColorChanged(algoEndColor);
     if (algoEndColor.isValid())
@@ -179,6 +185,7 @@ void RGBMatrixEditor::setHasEndColor(bool hasEndCol)
     {
         m_matrix->setEndColor(QColor());
         m_matrix->calculateColorDelta();
+        m_previewRenderer->restart(m_matrix);
     }
     emit hasEndColorChanged(hasEndCol);
 }
@@ -204,8 +211,11 @@ void RGBMatrixEditor::setAlgoText(QString text)
         if (algo->text() == text)
             return;
 
-        QMutexLocker algorithmLocker(&m_matrix->algorithmMutex());
-        algo->setText(text);
+        {
+            QMutexLocker algorithmLocker(&m_matrix->algorithmMutex());
+            algo->setText(text);
+        }
+        m_previewRenderer->restart(m_matrix);
         emit algoTextChanged(text);
     }
 }
@@ -235,8 +245,11 @@ void RGBMatrixEditor::setAlgoImagePath(QString path)
         if (algo->filename() == path)
             return;
 
-        QMutexLocker algorithmLocker(&m_matrix->algorithmMutex());
-        algo->setFilename(path);
+        {
+            QMutexLocker algorithmLocker(&m_matrix->algorithmMutex());
+            algo->setFilename(path);
+        }
+        m_previewRenderer->restart(m_matrix);
         emit algoImagePathChanged(path);
     }
 }
@@ -319,6 +332,9 @@ void RGBMatrixEditor::setScriptStringProperty(QString paramName, QString value)
     RGBScript *script = static_cast<RGBScript*> (m_matrix->algorithm());
     script->setProperty(paramName, value);
     m_matrix->setProperty(paramName, value);
+
+    // the preview renders a copy of the algorithm
+    m_previewRenderer->restart(m_matrix);
 }
 
 void RGBMatrixEditor::setScriptIntProperty(QString paramName, int value)
@@ -330,6 +346,9 @@ void RGBMatrixEditor::setScriptIntProperty(QString paramName, int value)
     RGBScript *script = static_cast<RGBScript*> (m_matrix->algorithm());
     script->setProperty(paramName, QString::number(value));
     m_matrix->setProperty(paramName, QString::number(value));
+
+    // the preview renders a copy of the algorithm
+    m_previewRenderer->restart(m_matrix);
 }
 
 
@@ -351,6 +370,7 @@ void RGBMatrixEditor::setRunOrder(int runOrder)
         return;
 
     m_matrix->setRunOrder(Function::RunOrder(runOrder));
+    m_previewRenderer->restart(m_matrix);
     emit runOrderChanged(runOrder);
 }
 
@@ -368,6 +388,7 @@ void RGBMatrixEditor::setDirection(int direction)
         return;
 
     m_matrix->setDirection(Function::Direction(direction));
+    m_previewRenderer->restart(m_matrix);
     emit directionChanged(direction);
 }
 
@@ -399,42 +420,9 @@ void RGBMatrixEditor::slotPreviewTimeout()
 
     if (m_previewIterator >= m_matrix->duration())
     {
-        int stepsCount = m_matrix->stepsCount();
-        //qDebug() << "previewTimeout. Step:" << m_previewStep;
-        if (m_matrix->runOrder() == RGBMatrix::PingPong)
-        {
-            if (m_previewDirection == Function::Forward && (m_previewStep + 1) == stepsCount)
-                m_previewDirection = Function::Backward;
-            else if (m_previewDirection == Function::Backward && (m_previewStep - 1) < 0)
-                m_previewDirection = Function::Forward;
-        }
-
-        if (m_previewDirection == Function::Forward)
-        {
-            m_previewStep++;
-            if (m_previewStep >= stepsCount)
-            {
-                m_previewStep = 0;
-                m_matrix->setStepColor(m_matrix->startColor());
-            }
-            else
-                m_matrix->updateStepColor(m_previewStep);
-        }
-        else
-        {
-            m_previewStep--;
-            if (m_previewStep < 0)
-            {
-                m_previewStep = stepsCount - 1;
-                if (m_matrix->endColor().isValid())
-                    m_matrix->setStepColor(m_matrix->endColor());
-                else
-                    m_matrix->setStepColor(m_matrix->startColor());
-            }
-            else
-                m_matrix->updateStepColor(m_previewStep);
-        }
-        map = m_matrix->previewMap(m_previewStep);
+        // the next step is not rendered yet. Try again on the next timeout
+        if (m_previewRenderer->takeFrame(map) == false)
+            return;
         m_previewIterator = 0;
 /*
         for (int y = 0; y < map.size(); y++)
@@ -485,31 +473,12 @@ void RGBMatrixEditor::initPreviewData()
         m_previewData.append(QVariant(QColor(0, 0, 0, 0)));
 
     if (m_matrix == NULL)
-        return;
-
-    m_previewDirection = m_matrix->direction();
-
-    if (m_previewDirection == Function::Forward)
-    {
-        m_matrix->setStepColor(m_matrix->startColor());
-    }
-    else
     {
-        if (m_matrix->endColor().isValid())
-            m_matrix->setStepColor(m_matrix->endColor());
-        else
-            m_matrix->setStepColor(m_matrix->startColor());
+        m_previewRenderer->stop();
+        return;
     }
 
-    m_matrix->calculateColorDelta();
-
-    if (m_previewDirection == Function::Forward)
-    {
-        m_previewStep = 0;
-    }
-    else
-    {
-        m_previewStep = m_matrix->stepsCount() - 1;
-    }
+    m_previewRenderer->restart(m_matrix);
+    m_previewIterator = 0;
     m_previewTimer->start(MasterTimer::tick());
 }
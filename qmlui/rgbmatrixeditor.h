@@ -23,6 +23,7 @@
 #include "functioneditor.h" 
 
 class Doc;
+class RGBMatrixPreview;
 class RGBMatrix;
 class FixtureGroup;
 
@@ -158,9 +159,9 @@ signals:
 private:
     /** A timer to perform a timed preview of the RGBMatrix pattern */
     QTimer* m_previewTimer;
+    /** Renders the preview frames on a worker thread */
+    RGBMatrixPreview* m_previewRenderer;
     uint m_previewIterator;
-    Function::Direction m_previewDirection;
-    int m_previewStep;
 
     // exchange variable with the QML world
     QVariantList m_previewData;
@@ -166,6 +166,10 @@ AddFixture::~AddFixture()
     }
 
     settings.setValue(SETTINGS_EXPANDED, expanded);
+
+    /* The fixtures have been added by now, so the definitions
+       that have just been browsed can be released */
+    m_doc->fixtureDefCache()->releaseUnused();
 }
 
 /*****************************************************************************
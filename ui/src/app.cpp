@@ -55,6 +55,7 @@
 #include "rgbscriptscache.h"
 #include "qlcfixturedef.h"
 #include "qlcconfig.h"
+#include "qlctrace.h"
 #include "qlcfile.h"
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
@@ -106,6 +107,7 @@ App::App()
     , m_controlBlackoutAction(NULL)
     , m_controlPanicAction(NULL)
     , m_dumpDmxAction(NULL)
+    , m_recordTraceAction(NULL)
     , m_liveEditAction(NULL)
     , m_liveEditVirtualConsoleAction(NULL)
 
@@ -680,6 +682,11 @@ void App::initActions()
     m_dumpDmxAction->setShortcut(QKeySequence(tr("CTRL+D", "Control|Dump DMX")));
     connect(m_dumpDmxAction, SIGNAL(triggered()), this, SLOT(slotDumpDmxIntoFunction()));
 
+    m_recordTraceAction = new QAction(QIcon(":/record.png"), tr("Record an engine performance trace"), this);
+    m_recordTraceAction->setCheckable(true);
+    m_recordTraceAction->setChecked(QLCTrace::isRecording());
+    connect(m_recordTraceAction, SIGNAL(triggered(bool)), this, SLOT(slotRecordTrace(bool)));
+
     m_controlPanicAction = new QAction(QIcon(":/panic.png"), tr("Stop ALL functions!"), this);
     m_controlPanicAction->setShortcut(QKeySequence("CTRL+SHIFT+ESC"));
     connect(m_controlPanicAction, SIGNAL(triggered(bool)), this, SLOT(slotControlPanic()));
@@ -746,6 +753,9 @@ void App::initToolBar()
     widget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
     m_toolbar->addWidget(widget);
     m_toolbar->addAction(m_dumpDmxAction);
+#ifdef QLC_TRACING
+    m_toolbar->addAction(m_recordTraceAction);
+#endif
     m_toolbar->addAction(m_liveEditAction);
     m_toolbar->addAction(m_liveEditVirtualConsoleAction);
     m_toolbar->addSeparator();
@@ -1107,6 +1117,33 @@ void App::slotDumpDmxIntoFunction()
         return;
 }
 
+void App::slotRecordTrace(bool record)
+{
+    if (record == true)
+    {
+        QLCTrace::clear();
+        QLCTrace::start();
+        return;
+    }
+
+    QLCTrace::stop();
+
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Save engine trace"),
+                                                    QDir::homePath(),
+                                                    tr("Chrome trace files (*.json)"));
+    if (fileName.isEmpty() == true)
+        return;
+
+    if (fileName.endsWith(".json") == false)
+        fileName.append(".json");
+
+    if (QLCTrace::exportChromeTrace(fileName) == false)
+    {
+        QMessageBox::warning(this, tr("Unable to save the engine trace"),
+                             tr("The trace could not be written to %1").arg(fileName));
+    }
+}
+
 void App::slotFunctionLiveEdit()
 {
     FunctionSelection fs(this, m_doc);
@@ -1278,6 +1315,7 @@ QFile::FileError App::loadXML(const QString& fileName)
     /* Set the workspace path before loading the new XML. In this way local files
        can be loaded even if the workspace file has been moved */
     m_doc->setWorkspacePath(QFileInfo(fileName).absolutePath());
+    m_doc->stateJournal()->setWorkspace(fileName);
 
     if (doc->dtdName() == KXMLQLCWorkspace)
     {
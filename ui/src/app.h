@@ -152,6 +152,7 @@ public slots:
     void slotFadeAndStopAll();
     void slotRunningFunctionsChanged();
     void slotDumpDmxIntoFunction();
+    void slotRecordTrace(bool record);
     void slotFunctionLiveEdit();
     void slotLiveEditVirtualConsole();
 
@@ -173,6 +174,7 @@ private:
     QAction* m_controlBlackoutAction;
     QAction* m_controlPanicAction;
     QAction* m_dumpDmxAction;
+    QAction* m_recordTraceAction;
     QAction* m_liveEditAction;
     QAction* m_liveEditVirtualConsoleAction;
 
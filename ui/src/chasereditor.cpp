@@ -272,7 +272,7 @@ void ChaserEditor::selectStepAtTime(quint32 time)
             timeIncr = m_chaser->duration();
         else // Chaser::PerStep
         {
-            timeIncr += m_chaser->stepAt(i).duration;
+            timeIncr += m_chaser->steps().at(i).duration;
         }
         if (time < stepTime + timeIncr)
         {
@@ -1227,10 +1227,10 @@ void ChaserEditor::applyStepValues()
 void ChaserEditor::printSteps()
 {
     int i = 0;
-    QListIterator <ChaserStep> it(m_chaser->steps());
+    QVectorIterator <ChaserStep> it(m_chaser->steps());
     while (it.hasNext() == true)
     {
-        ChaserStep st(it.next());
+        const ChaserStep &st(it.next());
         qDebug() << "Step #" << i << ": id: " << st.fid << ": fadeIn: " << st.fadeIn << ", fadeOut: " << st.fadeOut << ", duration: " << st.duration;
         if (st.values.count() > 0)
             qDebug() << "-----> values found: " << st.values.count();
@@ -39,6 +39,7 @@
 #include "fixtureselection.h"
 #include "speeddialwidget.h"
 #include "efxpreviewarea.h"
+#include "efxpreview.h"
 #include "efxeditor.h"
 #include "fixture.h"
 #include "apputil.h"
@@ -68,6 +69,7 @@ EFXEditor::EFXEditor(QWidget* parent, EFX* efx, Doc* doc)
     , m_doc(doc)
     , m_efx(efx)
     , m_previewArea(NULL)
+    , m_previewGeometry(NULL)
     , m_points(NULL)
     , m_speedDials(NULL)
 {
@@ -201,6 +203,10 @@ void EFXEditor::initMovementPage()
     m_previewFrame->layout()->setMargin(0);
     m_previewFrame->layout()->addWidget(m_previewArea);
 
+    m_previewGeometry = new EFXPreview(this);
+    connect(m_previewGeometry, SIGNAL(geometryReady()),
+            this, SLOT(slotPreviewGeometryReady()));
+
     /* Get supported algorithms and fill the algorithm combo with them */
     m_algorithmCombo->addItems(EFX::algorithmList());
 
@@ -1057,11 +1063,28 @@ void EFXEditor::redrawPreview()
         return;
 
     QPolygonF polygon;
-    m_efx->preview(polygon);
+    QVector <QPolygonF> fixturePoints;
+
+    /* Paths not cached yet are computed in background, and only
+     * for the latest parameters, so dragging a knob doesn't block */
+    if (m_previewGeometry->request(m_efx, polygon, fixturePoints) == true)
+        updatePreview(polygon, fixturePoints);
+}
 
+void EFXEditor::slotPreviewGeometryReady()
+{
+    QPolygonF polygon;
     QVector <QPolygonF> fixturePoints;
-    m_efx->previewFixtures(fixturePoints);
- 
+
+    if (m_previewGeometry->takeGeometry(polygon, fixturePoints) == true)
+        updatePreview(polygon, fixturePoints);
+}
+
+void EFXEditor::updatePreview(const QPolygonF &polygon, const QVector<QPolygonF> &fixturePoints)
+{
+    if (polygon.isEmpty())
+        return;
+
     m_previewArea->setPolygon(polygon);
     m_previewArea->setFixturePolygons(fixturePoints);
 
@@ -31,6 +31,7 @@
 
 class SpeedDialWidget;
 class EFXPreviewArea;
+class EFXPreview;
 class Doc;
 
 class EfxUiState;
@@ -86,6 +87,7 @@ private slots:
 
 private:
     EFXPreviewArea* m_previewArea;
+    EFXPreview* m_previewGeometry;
     QPolygon* m_points;
     QTimer m_testTimer;
 
@@ -156,8 +158,11 @@ private slots:
     void slotForwardClicked();
     void slotBackwardClicked();
 
+    void slotPreviewGeometryReady();
+
 private:
     void redrawPreview();
+    void updatePreview(const QPolygonF& polygon, const QVector<QPolygonF>& fixturePoints);
 };
 
 /** @} */
@@ -48,6 +48,7 @@ void EFXPreviewArea::setPolygon(const QPolygonF& polygon)
 {
     m_original = polygon;
     m_scaled = scale(m_original, size());
+    update();
 }
 
 void EFXPreviewArea::setFixturePolygons(const QVector<QPolygonF> &fixturePoints)
@@ -60,19 +61,34 @@ void EFXPreviewArea::setFixturePolygons(const QVector<QPolygonF> &fixturePoints)
         m_originalFixturePoints[i] = QPolygonF(fixturePoints[i]);
         m_fixturePoints[i] = scale(m_originalFixturePoints[i], size());
     }
+
+    updateMarkerRects();
+    update();
 }
 
 void EFXPreviewArea::draw(int timerInterval)
 {
     m_timer.stop();
 
-    m_iter = 0;
+    restart();
     m_timer.start(timerInterval);
 }
 
 void EFXPreviewArea::slotTimeout()
 {
-    repaint();
+    /* Repaint only where the markers were and where they are now.
+     * The path and the background don't move */
+    foreach (QRect rect, m_markerRects)
+        update(rect);
+
+    m_iter++;
+    if (m_iter >= m_scaled.size())
+        m_iter = 0;
+
+    updateMarkerRects();
+
+    foreach (QRect rect, m_markerRects)
+        update(rect);
 }
 
 QPolygonF EFXPreviewArea::scale(const QPolygonF& poly, const QSize& target)
@@ -89,6 +105,29 @@ QPolygonF EFXPreviewArea::scale(const QPolygonF& poly, const QSize& target)
     return scaled;
 }
 
+QRect EFXPreviewArea::markerRect(int index, const QPointF &point) const
+{
+    QRect circle = QRectF(point.x() - 8, point.y() - 8, 16, 16).toAlignedRect();
+    QRect text = fontMetrics().boundingRect(QString::number(index + 1));
+    text.translate(point.x() - 4, point.y() + 5);
+
+    // leave room for the pen width
+    return circle.united(text).adjusted(-2, -2, 2, 2);
+}
+
+void EFXPreviewArea::updateMarkerRects()
+{
+    m_markerRects.clear();
+
+    for (int i = 0; i < m_fixturePoints.size(); ++i)
+    {
+        if (m_iter < m_fixturePoints.at(i).size())
+            m_markerRects.append(markerRect(i, m_fixturePoints.at(i).at(m_iter)));
+        else
+            m_markerRects.append(QRect());
+    }
+}
+
 void EFXPreviewArea::resizeEvent(QResizeEvent* e)
 {
     m_scaled = scale(m_original, e->size());
@@ -97,6 +136,8 @@ void EFXPreviewArea::resizeEvent(QResizeEvent* e)
     {
         m_fixturePoints[i] = scale(m_originalFixturePoints[i], e->size());
     }
+    updateMarkerRects();
+
     QWidget::resizeEvent(e);
 }
 
@@ -109,12 +150,18 @@ void EFXPreviewArea::paintEvent(QPaintEvent* e)
     QPointF point;
     QColor color = Qt::white;
 
+    /* Painting is clipped to the exposed region, so during the animation
+     * only the areas around the moving markers are actually drawn */
     if (m_gradientBg)
-        painter.drawImage(painter.window(), Gradient::getRGBGradient(256, 256));
+    {
+        if (m_gradient.size() != size())
+            m_gradient = Gradient::getRGBGradient(width(), height());
+        painter.drawImage(e->rect(), m_gradient, e->rect());
+    }
     else
     {
         color.setAlpha(m_bgAlpha);
-        painter.fillRect(rect(), color);
+        painter.fillRect(e->rect(), color);
     }
 
     /* Crosshairs */
@@ -124,9 +171,6 @@ void EFXPreviewArea::paintEvent(QPaintEvent* e)
     painter.drawLine(width() >> 1, 0, width() >> 1, height());
     painter.drawLine(0, height() >> 1, width(), height() >> 1);
 
-    if (m_iter < m_scaled.size())
-        m_iter++;
-
     /* Plain points with text color */
     color = palette().color(QPalette::Text);
     pen.setColor(color);
@@ -136,15 +180,6 @@ void EFXPreviewArea::paintEvent(QPaintEvent* e)
     // Draw the points from the point array
     if (m_iter < m_scaled.size() && m_iter >= 0)
     {
-        /*
-        // draw origin
-        color = color.lighter(100 + (m_points.size() / 100));
-        pen.setColor(color);
-        painter.setPen(pen);
-        point = m_points.point(m_iter);
-        painter.drawEllipse(point.x() - 4, point.y() - 4, 8, 8);
-        */
-
         painter.setBrush(Qt::white);
         pen.setColor(Qt::black);
 
@@ -153,23 +188,24 @@ void EFXPreviewArea::paintEvent(QPaintEvent* e)
         // drawing from the end -- so that lower numbers are on top
         for (int i = m_fixturePoints.size() - 1; i >= 0; --i)
         {
+            // skip the markers that have not moved
+            if (i < m_markerRects.size() && e->region().intersects(m_markerRects.at(i)) == false)
+                continue;
+            if (m_iter >= m_fixturePoints.at(i).size())
+                continue;
+
             point = m_fixturePoints.at(i).at(m_iter);
             painter.drawEllipse(point, 8, 8);
             painter.drawText(point.x() - 4, point.y() + 5, QString::number(i+1));
         }
     }
-    else
-    {
-        //m_timer.stop();
-
-        //Change old behaviour from stop to restart
-        restart();
-    }
 }
 
 void EFXPreviewArea::restart ()
 {
     m_iter = 0;
+    updateMarkerRects();
+    update();
 }
 
 void EFXPreviewArea::showGradientBackground(bool enable)
@@ -181,4 +217,5 @@ void EFXPreviewArea::showGradientBackground(bool enable)
 void EFXPreviewArea::setBackgroundAlpha(int alpha)
 {
     m_bgAlpha = alpha;
+    update();
 }
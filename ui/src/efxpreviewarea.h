@@ -22,7 +22,10 @@
 
 #include <QPolygon>
 #include <QWidget>
+#include <QVector>
 #include <QTimer>
+#include <QImage>
+#include <QRect>
 
 #include "ui_efxeditor.h"
 #include "efx.h"
@@ -88,6 +91,13 @@ private slots:
     /** Animation timeout */
     void slotTimeout();
 
+private:
+    /** Return the area covered by the marker of the fixture at $index */
+    QRect markerRect(int index, const QPointF& point) const;
+
+    /** Update m_markerRects for the current animation position */
+    void updateMarkerRects();
+
 private:
     /** Points that are drawn in the preview area */
     QPolygonF m_scaled;
@@ -102,6 +112,13 @@ private:
     /** Animation position */
     int m_iter;
 
+    /** The areas covered by the fixture markers at the current position.
+     *  On each animation step, only these areas are repainted */
+    QVector <QRect> m_markerRects;
+
+    /** The color map background, scaled to the widget size */
+    QImage m_gradient;
+
     /** Flag to enable/disable a color map background */
     bool m_gradientBg;
 
@@ -63,6 +63,7 @@ InputOutputManager::InputOutputManager(QWidget* parent, Doc* doc)
     , m_deleteUniverseAction(NULL)
     , m_uniNameEdit(NULL)
     , m_uniPassthroughCheck(NULL)
+    , m_uniBypassCheck(NULL)
     , m_editor(NULL)
     , m_editorUniverse(UINT_MAX)
 {
@@ -122,6 +123,15 @@ InputOutputManager::InputOutputManager(QWidget* parent, Doc* doc)
     m_uniPassthroughCheck->setFont(font);
     m_toolbar->addWidget(m_uniPassthroughCheck);
 
+    m_uniBypassCheck = new QCheckBox(tr("Low latency"), this);
+    m_uniBypassCheck->setToolTip(tr("Forward input frames to the output right away, "
+                                    "while no function is running on this universe"));
+    m_uniBypassCheck->setLayoutDirection(Qt::RightToLeft);
+    m_uniBypassCheck->setFont(font);
+    // only meaningful in passthrough mode
+    m_uniBypassCheck->setEnabled(m_uniPassthroughCheck->isChecked());
+    m_toolbar->addWidget(m_uniBypassCheck);
+
     m_splitter->widget(0)->layout()->addWidget(m_toolbar);
 
     connect(m_uniNameEdit, SIGNAL(textChanged(QString)),
@@ -129,6 +139,11 @@ InputOutputManager::InputOutputManager(QWidget* parent, Doc* doc)
 
     connect(m_uniPassthroughCheck, SIGNAL(toggled(bool)),
             this, SLOT(slotPassthroughChanged(bool)));
+    connect(m_uniPassthroughCheck, SIGNAL(toggled(bool)),
+            m_uniBypassCheck, SLOT(setEnabled(bool)));
+
+    connect(m_uniBypassCheck, SIGNAL(toggled(bool)),
+            this, SLOT(slotPassthroughBypassChanged(bool)));
 
     /* Universes list */
     m_list = new QListWidget(this);
@@ -212,6 +227,7 @@ void InputOutputManager::updateList()
         m_uniNameEdit->setEnabled(true);
         m_uniNameEdit->setText(m_ioMap->getUniverseNameByIndex(0));
         m_uniPassthroughCheck->setChecked(m_ioMap->getUniversePassthrough(0));
+        m_uniBypassCheck->setChecked(m_ioMap->getUniversePassthroughBypass(0));
     }
 }
 
@@ -323,6 +339,7 @@ void InputOutputManager::slotCurrentItemChanged()
     int uniIdx = m_list->currentRow();
     m_uniNameEdit->setText(m_ioMap->getUniverseNameByIndex(uniIdx));
     m_uniPassthroughCheck->setChecked(m_ioMap->getUniversePassthrough(uniIdx));
+    m_uniBypassCheck->setChecked(m_ioMap->getUniversePassthroughBypass(uniIdx));
 }
 
 void InputOutputManager::slotMappingChanged()
@@ -422,6 +439,17 @@ void InputOutputManager::slotPassthroughChanged(bool checked)
     m_doc->inputOutputMap()->saveDefaults();
 }
 
+void InputOutputManager::slotPassthroughBypassChanged(bool checked)
+{
+    QListWidgetItem *currItem = m_list->currentItem();
+    if (currItem == NULL)
+        return;
+
+    int uniIdx = m_list->currentRow();
+    m_ioMap->setUniversePassthroughBypass(uniIdx, checked);
+    m_doc->inputOutputMap()->saveDefaults();
+}
+
 void InputOutputManager::showEvent(QShowEvent *ev)
 {
     Q_UNUSED(ev);
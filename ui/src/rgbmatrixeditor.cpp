@@ -34,6 +34,7 @@
 #include <QDebug>
 #include <QMutex>
 
+#include "rgbmatrixpreview.h"
 #include "fixtureselection.h"
 #include "speeddialwidget.h"
 #include "rgbmatrixeditor.h"
@@ -62,8 +63,8 @@ RGBMatrixEditor::RGBMatrixEditor(QWidget* parent, RGBMatrix* mtx, Doc* doc)
     , m_speedDials(NULL)
     , m_scene(new QGraphicsScene(this))
     , m_previewTimer(new QTimer(this))
+    , m_previewRenderer(new RGBMatrixPreview(this))
     , m_previewIterator(0)
-    , m_previewStep(0)
 {
     Q_ASSERT(doc != NULL);
     Q_ASSERT(mtx != NULL);
@@ -93,6 +94,7 @@ RGBMatrixEditor::RGBMatrixEditor(QWidget* parent, RGBMatrix* mtx, Doc* doc)
 RGBMatrixEditor::~RGBMatrixEditor()
 {
     m_previewTimer->stop();
+    m_previewRenderer->stop();
 
     if (m_testButton->isChecked() == true)
         m_matrix->stopAndWait();
@@ -494,32 +496,7 @@ bool RGBMatrixEditor::createPreviewItems()
         return false;
     }
 
-    m_previewDirection = m_matrix->direction();
-
-    if (m_previewDirection == Function::Forward)
-    {
-        m_matrix->setStepColor(m_matrix->startColor());
-    }
-    else
-    {
-        if (m_matrix->endColor().isValid())
-            m_matrix->setStepColor(m_matrix->endColor());
-        else
-            m_matrix->setStepColor(m_matrix->startColor());
-    }
-
-    m_matrix->calculateColorDelta();
-
-    if (m_previewDirection == Function::Forward)
-    {
-        m_previewStep = 0;
-    }
-    else
-    {
-        m_previewStep = m_matrix->stepsCount() - 1;
-    }
-
-    RGBMap map = m_matrix->previewMap(m_previewStep);
+    RGBMap map = m_previewRenderer->restart(m_matrix);
 
     if (map.isEmpty())
         return false;
@@ -575,42 +552,9 @@ void RGBMatrixEditor::slotPreviewTimeout()
     uint elapsed = 0;
     while (m_previewIterator >= MAX(m_matrix->duration(), MasterTimer::tick()))
     {
-        int stepsCount = m_matrix->stepsCount();
-        //qDebug() << "previewTimeout. Step:" << m_previewStep;
-        if (m_matrix->runOrder() == RGBMatrix::PingPong)
-        {
-            if (m_previewDirection == Function::Forward && (m_previewStep + 1) == stepsCount)
-                m_previewDirection = Function::Backward;
-            else if (m_previewDirection == Function::Backward && (m_previewStep - 1) < 0)
-                m_previewDirection = Function::Forward;
-        }
-
-        if (m_previewDirection == Function::Forward)
-        {
-            m_previewStep++;
-            if (m_previewStep >= stepsCount)
-            {
-                m_previewStep = 0;
-                m_matrix->setStepColor(m_matrix->startColor());
-            }
-            else
-                m_matrix->updateStepColor(m_previewStep);
-        }
-        else
-        {
-            m_previewStep--;
-            if (m_previewStep < 0)
-            {
-                m_previewStep = stepsCount - 1;
-                if (m_matrix->endColor().isValid())
-                    m_matrix->setStepColor(m_matrix->endColor());
-                else
-                    m_matrix->setStepColor(m_matrix->startColor());
-            }
-            else
-                m_matrix->updateStepColor(m_previewStep);
-        }
-        map = m_matrix->previewMap(m_previewStep);
+        // the next step is not rendered yet. Try again on the next timeout
+        if (m_previewRenderer->takeFrame(map) == false)
+            break;
 
         m_previewIterator -= MAX(m_matrix->duration(), MasterTimer::tick());
         elapsed += MAX(m_matrix->duration(), MasterTimer::tick());
@@ -945,6 +889,7 @@ void RGBMatrixEditor::slotTestClicked()
     if (m_testButton->isChecked() == true)
     {
         m_previewTimer->stop();
+        m_previewRenderer->stop();
         m_matrix->start(m_doc->masterTimer(), functionParent());
     }
     else
@@ -981,11 +926,13 @@ void RGBMatrixEditor::slotModeChanged(Doc::Mode mode)
             m_matrix->stopAndWait();
         m_testButton->setChecked(false);
         m_previewTimer->stop();
+        m_previewRenderer->stop();
         m_testButton->setEnabled(false);
     }
     else
     {
-        m_previewTimer->start(MasterTimer::tick());
+        if (createPreviewItems() == true)
+            m_previewTimer->start(MasterTimer::tick());
         m_testButton->setEnabled(true);
     }
 }
@@ -1167,6 +1114,10 @@ void RGBMatrixEditor::slotPropertyComboChanged(QString value)
         QString pName = combo->property("pName").toString();
         script->setProperty(pName, value);
         m_matrix->setProperty(pName, value);
+
+        // the preview renders a copy of the algorithm
+        if (m_testButton->isChecked() == false)
+            m_previewRenderer->restart(m_matrix);
     }
 }
 
@@ -1181,6 +1132,10 @@ void RGBMatrixEditor::slotPropertySpinChanged(int value)
         QString pName = spin->property("pName").toString();
         script->setProperty(pName, QString::number(value));
         m_matrix->setProperty(pName, QString::number(value));
+
+        // the preview renders a copy of the algorithm
+        if (m_testButton->isChecked() == false)
+            m_previewRenderer->restart(m_matrix);
     }
 }
 
@@ -28,6 +28,7 @@
 #include "qlcpoint.h"
 #include "doc.h"
 
+class RGBMatrixPreview;
 class SpeedDialWidget;
 class QGraphicsScene;
 class RGBItem;
@@ -124,14 +125,13 @@ private:
     RGBMatrix* m_matrix; // The RGBMatrix being edited
 
     QList <RGBScript> m_scripts;
-    Function::Direction m_previewDirection;
 
     SpeedDialWidget *m_speedDials;
 
     QGraphicsScene* m_scene;
     QTimer* m_previewTimer;
+    RGBMatrixPreview* m_previewRenderer;
     uint m_previewIterator;
-    int m_previewStep;
     QHash<QLCPoint, RGBItem*> m_previewHash;
 };
 
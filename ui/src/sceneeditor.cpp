@@ -504,13 +504,14 @@ void SceneEditor::slotPaste()
         }
         else
         {
+            QList<SceneValue> clipboardVals = clipboard->getSceneValues();
             foreach(FixtureConsole *fc, m_consoleList.values())
             {
                 if (fc == NULL)
                     continue;
                 quint32 fxi = fc->fixture();
                 QList<SceneValue>thisFixtureVals;
-                foreach(SceneValue val, clipboard->getSceneValues())
+                foreach(SceneValue val, clipboardVals)
                 {
                     if (val.fxi == fxi)
                         thisFixtureVals.append(val);
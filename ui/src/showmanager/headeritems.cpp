@@ -17,10 +17,15 @@
   limitations under the License.
 */ 
 
+#include <QStyleOptionGraphicsItem>
 #include <QPainter>
+#include <qmath.h>
 
 #include "headeritems.h"
 
+/** Width in pixels reserved to a time label, on the right of its bar */
+#define TIME_LABEL_WIDTH    50
+
 /****************************************************************************
  *
  * Header item
@@ -35,6 +40,8 @@ ShowHeaderItem::ShowHeaderItem(int width)
     , m_BPMValue(120)
     , m_type(Time)
 {
+    // paint() draws only the exposed area
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
 }
 
 void ShowHeaderItem::mousePressEvent(QGraphicsSceneMouseEvent *event)
@@ -50,7 +57,6 @@ QRectF ShowHeaderItem::boundingRect() const
 
 void ShowHeaderItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
-    Q_UNUSED(option);
     Q_UNUSED(widget);
 
     // draw base background
@@ -61,9 +67,12 @@ void ShowHeaderItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *op
     if (m_type > Time)
         m_timeStep = ((float)(120 * HALF_SECOND_WIDTH) / (float)m_BPMValue) / (float)m_timeScale;
 
-    // draw vertical timing lines and time labels
+    // draw vertical timing lines and time labels of the exposed area only.
+    // Labels are drawn on the right of their bar, so start a bit earlier
+    int firstStep = qMax(0, int(qFloor((option->exposedRect.left() - TIME_LABEL_WIDTH) / m_timeStep)));
+    int lastStep = qMin(qCeil(m_width / m_timeStep), int(qCeil(option->exposedRect.right() / m_timeStep)) + 1);
     int tmpSec = 0;
-    for (int i = 0; i < m_width / m_timeStep; i++)
+    for (int i = firstStep; i < lastStep; i++)
     {
         float xpos = ((float)i * m_timeStep) + 1;
         painter->setPen(QPen( QColor(250, 250, 250, 255), 1));
@@ -90,7 +99,7 @@ void ShowHeaderItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *op
             }
             else
             {
-                tmpSec++;
+                tmpSec = (i / m_timeHit) + 1;
                 painter->drawText(xpos - 4, 15, QString("%1").arg(tmpSec));
             }
         }
@@ -17,6 +17,7 @@
   limitations under the License.
 */
 
+#include <QStyleOptionGraphicsItem>
 #include <QApplication>
 #include <QPainter>
 #include <QMenu>
@@ -26,13 +27,23 @@
 #include "chaserstep.h"
 #include "trackitem.h"
 
+/** Below this width in pixels, steps are drawn as plain delimiters */
+#define MIN_DETAILED_STEP_WIDTH  4
+/** Minimum distance in pixels between two drawn delimiters */
+#define MIN_DELIMITER_DISTANCE   2
+
 SequenceItem::SequenceItem(Chaser *seq, ShowFunction *func)
     : ShowItem(func)
     , m_chaser(seq)
     , m_selectedStep(-1)
+    , m_maxFadeOut(0)
+    , m_positionsTimeScale(0)
 {
     Q_ASSERT(seq != NULL);
 
+    // paint() draws only the exposed area
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+
     if (func->color().isValid())
         setColor(func->color());
     else
@@ -41,6 +52,7 @@ SequenceItem::SequenceItem(Chaser *seq, ShowFunction *func)
     if (func->duration() == 0)
         func->setDuration(seq->totalDuration());
 
+    updateStepTimings();
     calculateWidth();
 
     connect(m_chaser, SIGNAL(changed(quint32)),
@@ -60,33 +72,87 @@ void SequenceItem::calculateWidth()
     setWidth(newWidth);
 }
 
+void SequenceItem::updateStepTimings()
+{
+    const QVector <ChaserStep> &steps = m_chaser->steps();
+    bool commonFadeIn = m_chaser->fadeInMode() == Chaser::Common;
+    bool commonFadeOut = m_chaser->fadeOutMode() == Chaser::Common;
+    bool commonDuration = m_chaser->durationMode() == Chaser::Common;
+    quint32 offset = 0;
+
+    m_stepOffsets.resize(steps.count() + 1);
+    m_stepFadeIn.resize(steps.count());
+    m_stepFadeOut.resize(steps.count());
+    m_maxFadeOut = 0;
+
+    for (int i = 0; i < steps.count(); i++)
+    {
+        const ChaserStep &step = steps.at(i);
+
+        m_stepOffsets[i] = offset;
+        m_stepFadeIn[i] = commonFadeIn ? m_chaser->fadeInSpeed() : step.fadeIn;
+        m_stepFadeOut[i] = commonFadeOut ? m_chaser->fadeOutSpeed() : step.fadeOut;
+        m_maxFadeOut = qMax(m_maxFadeOut, m_stepFadeOut.at(i));
+        offset += commonDuration ? m_chaser->duration() : step.duration;
+    }
+    m_stepOffsets[steps.count()] = offset;
+
+    // invalidate the positions of the current time scale
+    m_positionsTimeScale = 0;
+}
+
+void SequenceItem::updateStepPositions()
+{
+    float timeScale = 50/(float)m_timeScale;
+
+    m_stepPositions.resize(m_stepOffsets.count());
+    for (int i = 0; i < m_stepOffsets.count(); i++)
+        m_stepPositions[i] = (timeScale * (float)m_stepOffsets.at(i)) / 1000;
+
+    m_positionsTimeScale = m_timeScale;
+}
+
 void SequenceItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
-    float xpos = 0;
     float timeScale = 50/(float)m_timeScale;
-    int stepIdx = 0;
 
     ShowItem::paint(painter, option, widget);
 
     if (this->isSelected() == false)
         m_selectedStep = -1;
 
-    foreach (ChaserStep step, m_chaser->steps())
+    if (m_positionsTimeScale != m_timeScale)
+        updateStepPositions();
+
+    int stepsCount = m_stepFadeIn.count();
+    if (stepsCount == 0)
+    {
+        ShowItem::postPaint(painter);
+        return;
+    }
+
+    // fade out lines extend beyond the end of their step
+    float maxFadeOutWidth = (timeScale * (float)m_maxFadeOut) / 1000;
+    float exposedLeft = option->exposedRect.left() - maxFadeOutWidth;
+    float exposedRight = option->exposedRect.right();
+
+    // find the first step ending inside the exposed area
+    int stepIdx = int(qUpperBound(m_stepPositions.constBegin() + 1, m_stepPositions.constEnd(),
+                                  exposedLeft) - m_stepPositions.constBegin()) - 1;
+
+    // very long sequences are drawn with less details when zoomed out
+    bool detailed = m_stepPositions.last() / stepsCount >= MIN_DETAILED_STEP_WIDTH;
+    float lastDelimiter = -MIN_DELIMITER_DISTANCE;
+
+    for (; stepIdx < stepsCount && m_stepPositions.at(stepIdx) <= exposedRight; stepIdx++)
     {
-        uint stepFadeIn = step.fadeIn;
-        uint stepFadeOut = step.fadeOut;
-        uint stepDuration = step.duration;
-        if (m_chaser->fadeInMode() == Chaser::Common)
-            stepFadeIn = m_chaser->fadeInSpeed();
-        if (m_chaser->fadeOutMode() == Chaser::Common)
-            stepFadeOut = m_chaser->fadeOutSpeed();
-        if (m_chaser->durationMode() == Chaser::Common)
-            stepDuration = m_chaser->duration();
+        float xpos = m_stepPositions.at(stepIdx);
+        float stepWidth = m_stepPositions.at(stepIdx + 1) - xpos;
 
         // draw fade in line
-        if (stepFadeIn > 0)
+        if (detailed && m_stepFadeIn.at(stepIdx) > 0)
         {
-            int fadeXpos = xpos + ((timeScale * (float)stepFadeIn) / 1000);
+            int fadeXpos = xpos + ((timeScale * (float)m_stepFadeIn.at(stepIdx)) / 1000);
             // doesn't even draw it if too small
             if (fadeXpos - xpos > 5)
             {
@@ -94,7 +160,6 @@ void SequenceItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *opti
                 painter->drawLine(xpos, TRACK_HEIGHT - 4, fadeXpos, 1);
             }
         }
-        float stepWidth = ((timeScale * (float)stepDuration) / 1000);
         // draw selected step
         if (stepIdx == m_selectedStep)
         {
@@ -104,14 +169,18 @@ void SequenceItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *opti
         }
         xpos += stepWidth;
 
-        // draw step vertical delimiter
-        painter->setPen(QPen(Qt::white, 1));
-        painter->drawLine(xpos, 1, xpos, TRACK_HEIGHT - 5);
+        // draw step vertical delimiter, skipping the ones overlapping the previous
+        if (xpos - lastDelimiter >= MIN_DELIMITER_DISTANCE)
+        {
+            painter->setPen(QPen(Qt::white, 1));
+            painter->drawLine(xpos, 1, xpos, TRACK_HEIGHT - 5);
+            lastDelimiter = xpos;
+        }
 
         // draw fade out line
-        if (stepFadeOut > 0)
+        if (detailed && m_stepFadeOut.at(stepIdx) > 0)
         {
-            int fadeXpos = xpos + ((timeScale * (float)stepFadeOut) / 1000);
+            int fadeXpos = xpos + ((timeScale * (float)m_stepFadeOut.at(stepIdx)) / 1000);
             // doesn't even draw it if too small
             if (fadeXpos - xpos > 5)
             {
@@ -119,7 +188,6 @@ void SequenceItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *opti
                 painter->drawLine(xpos, 1, fadeXpos, TRACK_HEIGHT - 4);
             }
         }
-        stepIdx++;
     }
 
     ShowItem::postPaint(painter);
@@ -158,6 +226,7 @@ Chaser *SequenceItem::getChaser()
 void SequenceItem::slotSequenceChanged(quint32)
 {
     prepareGeometryChange();
+    updateStepTimings();
     calculateWidth();
     if (m_function)
         m_function->setDuration(m_chaser->totalDuration());
@@ -22,6 +22,7 @@
 
 #include <QGraphicsItem>
 #include <QObject>
+#include <QVector>
 #include <QAction>
 #include <QFont>
 
@@ -73,12 +74,29 @@ private:
     /** Calculate sequence width for paint() and boundingRect() */
     void calculateWidth();
 
+    /** Rebuild the step timings table from the Chaser steps */
+    void updateStepTimings();
+
+    /** Rebuild the step pixel positions for the current time scale */
+    void updateStepPositions();
+
 private:
     /** Reference to the actual Chaser Function which holds the sequence steps */
     Chaser *m_chaser;
 
     /** index of the selected step for highlighting (-1 if none) */
     int m_selectedStep;
+
+    /** Start time of each step in milliseconds, plus the sequence end time */
+    QVector<quint32> m_stepOffsets;
+    /** Fade in/out times of each step, with the Chaser speed modes applied */
+    QVector<quint32> m_stepFadeIn;
+    QVector<quint32> m_stepFadeOut;
+    quint32 m_maxFadeOut;
+
+    /** m_stepOffsets in pixels, valid for m_positionsTimeScale */
+    QVector<float> m_stepPositions;
+    int m_positionsTimeScale;
 };
 
 /** @} */
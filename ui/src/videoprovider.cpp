@@ -89,6 +89,10 @@ VideoWidget::VideoWidget(Video *video, QObject *parent)
             this, SLOT(slotSourceUrlChanged(QString)));
     connect(m_video, SIGNAL(requestPlayback()),
             this, SLOT(slotPlaybackVideo()));
+    connect(m_video, SIGNAL(requestPreload(quint32)),
+            this, SLOT(slotPreloadVideo(quint32)));
+    connect(m_video, SIGNAL(requestCancelPreload()),
+            this, SLOT(slotCancelPreload()));
     connect(m_video, SIGNAL(requestPause(bool)),
             this, SLOT(slotSetPause(bool)));
     connect(m_video, SIGNAL(requestStop()),
@@ -218,6 +222,31 @@ void VideoWidget::slotPlaybackVideo()
     m_videoPlayer->play();
 }
 
+void VideoWidget::slotPreloadVideo(quint32 startTime)
+{
+    if (m_video->isRunning() || m_videoPlayer->state() != QMediaPlayer::StoppedState)
+        return;
+
+    if (m_videoWidget == NULL)
+    {
+        m_videoWidget = new QVideoWidget;
+        m_videoWidget->setStyleSheet("background-color:black;");
+        m_videoPlayer->setVideoOutput(m_videoWidget);
+    }
+
+    // a paused player opens the media and buffers the first frame,
+    // so playback can start right away
+    if (m_videoPlayer->isSeekable())
+        m_videoPlayer->setPosition(startTime);
+    m_videoPlayer->pause();
+}
+
+void VideoWidget::slotCancelPreload()
+{
+    if (m_video->isRunning() == false && m_videoPlayer->state() == QMediaPlayer::PausedState)
+        m_videoPlayer->stop();
+}
+
 void VideoWidget::slotSetPause(bool enable)
 {
     if (enable)
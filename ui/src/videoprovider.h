@@ -42,6 +42,8 @@ protected slots:
     void slotStatusChanged(QMediaPlayer::MediaStatus status);
     void slotMetaDataChanged(QString key, QVariant data);
     void slotPlaybackVideo();
+    void slotPreloadVideo(quint32 startTime);
+    void slotCancelPreload();
     void slotSetPause(bool enable);
     void slotStopVideo();
     void slotBrightnessAdjust(int value);
@@ -396,10 +396,10 @@ void VCCueList::updateStepList()
     if (ch == NULL)
         return;
 
-    QListIterator <ChaserStep> it(ch->steps());
+    QVectorIterator <ChaserStep> it(ch->steps());
     while (it.hasNext() == true)
     {
-        ChaserStep step(it.next());
+        const ChaserStep &step(it.next());
 
         Function* function = m_doc->function(step.fid);
         Q_ASSERT(function != NULL);
@@ -588,7 +588,7 @@ void VCCueList::slotFunctionNameChanged(quint32 fid)
         Chaser* ch = chaser();
         if (ch == NULL)
             return;
-        foreach (ChaserStep step, ch->steps())
+        foreach (const ChaserStep &step, ch->steps())
         {
             if (step.fid == fid)
             {
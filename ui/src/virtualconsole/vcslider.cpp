@@ -92,13 +92,13 @@ VCSlider::VCSlider(QWidget* parent, Doc* doc) : VCWidget(parent, doc)
     m_levelHighLimit = UCHAR_MAX;
 
     m_levelValue = 0;
-    m_levelValueChanged = false;
+    m_levelSequence = 0;
     m_monitorEnabled = false;
     m_monitorValue = 0;
 
     m_playbackFunction = Function::invalidId();
     m_playbackValue = 0;
-    m_playbackValueChanged = false;
+    m_playbackSequence = 0;
 
     m_widgetMode = WSlider;
 
@@ -561,12 +561,10 @@ bool VCSlider::channelsMonitorEnabled() const
 
 void VCSlider::setLevelValue(uchar value)
 {
-    m_levelValueMutex.lock();
     m_levelValue = value;
     if (m_monitorEnabled == true)
         m_monitorValue = m_levelValue;
-    m_levelValueChanged = true;
-    m_levelValueMutex.unlock();
+    m_levelMailbox.post(value);
 }
 
 uchar VCSlider::levelValue() const
@@ -601,9 +599,9 @@ void VCSlider::slotMonitorDMXValueChanged(int value)
             m_monitorValue = 255 - value;
         else
             m_monitorValue = value;
-        m_levelValueMutex.lock();
         m_levelValue = m_monitorValue;
-        m_levelValueMutex.unlock();
+        // follow the DMX output without writing it back
+        m_levelMailbox.store(m_monitorValue);
         if (m_slider)
             m_slider->blockSignals(true);
         setSliderValue(m_monitorValue, true);
@@ -705,7 +703,7 @@ void VCSlider::slotClickAndGoColorChanged(QRgb color)
         m_slider->setValue(128);
 
     // let's force a value change to cover all the HTP/LTP cases
-    m_levelValueChanged = true;
+    m_levelMailbox.post(m_levelValue);
 }
 
 void VCSlider::slotClickAndGoLevelAndPresetChanged(uchar level, QImage img)
@@ -765,10 +763,8 @@ void VCSlider::setPlaybackValue(uchar value)
     if (m_externalMovement == true)
         return;
 
-    m_playbackValueMutex.lock();
     m_playbackValue = value;
-    m_playbackValueChanged = true;
-    m_playbackValueMutex.unlock();
+    m_playbackMailbox.post(value);
 }
 
 uchar VCSlider::playbackValue() const
@@ -855,9 +851,13 @@ void VCSlider::writeDMXLevel(MasterTimer* timer, QList<Universe *> universes)
 {
     Q_UNUSED(timer);
 
-    QMutexLocker locker(&m_levelValueMutex);
+    /* Pick up the latest value posted by the UI */
+    quint32 postedLevel = 0;
+    bool levelChanged = m_levelMailbox.fetch(postedLevel, m_levelSequence);
+    uchar level = uchar(postedLevel);
+    quint32 levelTimestamp = levelChanged ? m_levelMailbox.timestamp() : 0;
 
-    uchar modLevel = m_levelValue;
+    uchar modLevel = level;
     bool mixedDMXlevels = false;
     int monitorSliderValue = -1;
 
@@ -867,7 +867,7 @@ void VCSlider::writeDMXLevel(MasterTimer* timer, QList<Universe *> universes)
     {
         float f = 0;
         if (m_slider)
-            f = SCALE(float(m_levelValue), float(m_slider->minimum()),
+            f = SCALE(float(level), float(m_slider->minimum()),
                       float(m_slider->maximum()), float(0), float(200));
 
         if ((uchar)f != 0)
@@ -882,7 +882,7 @@ void VCSlider::writeDMXLevel(MasterTimer* timer, QList<Universe *> universes)
     {
         float f = 0;
         if (m_slider)
-            f = SCALE(float(m_levelValue), float(m_slider->minimum()),
+            f = SCALE(float(level), float(m_slider->minimum()),
                       float(m_slider->maximum()), float(0), float(200));
         if ((uchar)f != 0)
         {
@@ -893,7 +893,7 @@ void VCSlider::writeDMXLevel(MasterTimer* timer, QList<Universe *> universes)
         }
     }
 
-    if (m_monitorEnabled == true && m_levelValueChanged == false)
+    if (m_monitorEnabled == true && levelChanged == false)
     {
         QListIterator <LevelChannel> it(m_levelChannels);
         while (it.hasNext() == true)
@@ -914,7 +914,7 @@ void VCSlider::writeDMXLevel(MasterTimer* timer, QList<Universe *> universes)
                     if (monitorSliderValue == -1)
                     {
                         monitorSliderValue = chValue;
-                        //qDebug() << "Monitor DMX value:" << monitorSliderValue << "level value:" << m_levelValue;
+                        //qDebug() << "Monitor DMX value:" << monitorSliderValue << "level value:" << level;
                     }
                     else
                     {
@@ -965,7 +965,7 @@ void VCSlider::writeDMXLevel(MasterTimer* timer, QList<Universe *> universes)
                 group = QLCChannel::Intensity;
 
             if (group != QLCChannel::Intensity &&
-                m_levelValueChanged == false)
+                levelChanged == false)
             {
                 /* Value has not changed and this is not an intensity channel.
                    LTP in effect. */
@@ -994,10 +994,13 @@ void VCSlider::writeDMXLevel(MasterTimer* timer, QList<Universe *> universes)
             }
 
             if (uni < universes.count())
+            {
                 universes[uni]->write(dmx_ch, modLevel * intensity());
+                if (levelChanged == true)
+                    universes[uni]->markInputTimestamp(levelTimestamp);
+            }
         }
     }
-    m_levelValueChanged = false;
 }
 
 void VCSlider::writeDMXPlayback(MasterTimer* timer, QList<Universe *> ua)
@@ -1008,13 +1011,11 @@ void VCSlider::writeDMXPlayback(MasterTimer* timer, QList<Universe *> ua)
     if (function == NULL || mode() == Doc::Design)
         return;
 
-    /* Grab current values inside a locked mutex */
-    m_playbackValueMutex.lock();
-    uchar value = m_playbackValue;
-    bool changed = m_playbackValueChanged;
+    /* Pick up the latest value posted by the UI */
+    quint32 postedValue = 0;
+    bool changed = m_playbackMailbox.fetch(postedValue, m_playbackSequence);
+    uchar value = uchar(postedValue);
     qreal pIntensity = qreal(value) / qreal(UCHAR_MAX);
-    m_playbackValueChanged = false;
-    m_playbackValueMutex.unlock();
 
     if (changed == true)
     {
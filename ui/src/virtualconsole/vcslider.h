@@ -21,11 +21,11 @@
 #ifndef VCSLIDER_H
 #define VCSLIDER_H
 
-#include <QMutex>
 #include <QList>
 
 #include "clickandgoslider.h"
 #include "clickandgowidget.h"
+#include "valuemailbox.h"
 #include "knobwidget.h"
 #include "dmxsource.h"
 #include "vcwidget.h"
@@ -332,9 +332,12 @@ protected:
     uchar m_levelLowLimit;
     uchar m_levelHighLimit;
 
-    QMutex m_levelValueMutex;
-    bool m_levelValueChanged;
+    /** The level value, as set by the UI */
     uchar m_levelValue;
+    /** The latest level value, picked up by writeDMXLevel() at each tick */
+    ValueMailbox m_levelMailbox;
+    /** The last m_levelMailbox sequence seen by writeDMXLevel() */
+    int m_levelSequence;
 
     bool m_monitorEnabled;
     uchar m_monitorValue;
@@ -384,8 +387,8 @@ protected slots:
 protected:
     quint32 m_playbackFunction;
     uchar m_playbackValue;
-    bool m_playbackValueChanged;
-    QMutex m_playbackValueMutex;
+    ValueMailbox m_playbackMailbox;
+    int m_playbackSequence;
 
 private:
     FunctionParent functionParent() const;
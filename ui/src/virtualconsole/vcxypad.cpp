@@ -167,6 +167,7 @@ VCXYPad::VCXYPad(QWidget* parent, Doc* doc) : VCWidget(parent, doc)
     m_padInteraction = false;
     m_sliderInteraction = false;
     m_inputValueChanged = false;
+    m_positionSequence = 0;
 
     slotModeChanged(m_doc->mode());
     setLiveEdit(m_liveEdit);
@@ -359,11 +360,11 @@ void VCXYPad::writeXYFixtures(MasterTimer *timer, QList<Universe *> universes)
 {
     Q_UNUSED(timer);
 
-    if (m_area->hasPositionChanged() == true)
-    {
-        // This call also resets the m_changed flag in m_area
-        QPointF pt = m_area->position();
+    QPointF pt;
+    quint32 timestamp = 0;
 
+    if (m_area->fetchPosition(pt, m_positionSequence, &timestamp) == true)
+    {
         /* Scale XY coordinate values to 0.0 - 1.0 */
         qreal x = SCALE(pt.x(), qreal(0), qreal(256), qreal(0), qreal(1));
         qreal y = SCALE(pt.y(), qreal(0), qreal(256), qreal(0), qreal(1));
@@ -375,7 +376,10 @@ void VCXYPad::writeXYFixtures(MasterTimer *timer, QList<Universe *> universes)
         foreach (VCXYPadFixture fixture, m_fixtures)
         {
             if (fixture.isEnabled())
+            {
                 fixture.writeDMX(x, y, universes);
+                fixture.markInputTimestamp(universes, timestamp);
+            }
         }
     }
 
@@ -408,7 +412,10 @@ void VCXYPad::writeScenePositions(MasterTimer *timer, QList<Universe *> universe
     if (m_scene == NULL || m_scene->isRunning() == false)
         return;
 
-    QPointF pt = m_area->position();
+    QPointF pt;
+    quint32 timestamp = 0;
+    bool changed = m_area->fetchPosition(pt, m_positionSequence, &timestamp);
+
     uchar panCoarse = uchar(qFloor(pt.x()));
     uchar panFine = uchar((pt.x() - qFloor(pt.x())) * 256);
     uchar tiltCoarse = uchar(qFloor(pt.y()));
@@ -452,6 +459,9 @@ void VCXYPad::writeScenePositions(MasterTimer *timer, QList<Universe *> universe
             }
         }
         fxMap[sc.m_fixture] = QPointF(x, y);
+
+        if (changed == true)
+            universes.at(sc.m_universe)->markInputTimestamp(timestamp);
     }
 
     foreach(QPointF pt, fxMap.values())
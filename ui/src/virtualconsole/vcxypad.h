@@ -199,6 +199,9 @@ private:
     bool m_sliderInteraction;
     bool m_inputValueChanged;
 
+    /** The last m_area position sequence seen by writeDMX() */
+    int m_positionSequence;
+
     /*********************************************************************
      * Presets
      *********************************************************************/
@@ -97,6 +97,7 @@ void VCXYPadArea::setPosition(const QPointF& point)
             m_dmxPos.setY(MAX_DMX_VALUE);
 
         m_changed = true;
+        postPosition(m_dmxPos);
     }
     m_mutex.unlock();
 
@@ -110,6 +111,7 @@ void VCXYPadArea::nudgePosition(qreal dx, qreal dy)
     m_dmxPos.setY(CLAMP(m_dmxPos.y() + dy, qreal(0), MAX_DMX_VALUE));
 
     m_changed = true;
+    postPosition(m_dmxPos);
 
     m_mutex.unlock();
 
@@ -124,6 +126,28 @@ bool VCXYPadArea::hasPositionChanged()
     return changed;
 }
 
+bool VCXYPadArea::fetchPosition(QPointF &point, int &sequence, quint32 *timestamp) const
+{
+    quint32 packed = 0;
+    bool changed = m_positionMailbox.fetch(packed, sequence);
+
+    point.setX(qreal(packed >> 16) / 256.0);
+    point.setY(qreal(packed & 0xFFFF) / 256.0);
+
+    if (timestamp != NULL)
+        *timestamp = m_positionMailbox.timestamp();
+
+    return changed;
+}
+
+void VCXYPadArea::postPosition(const QPointF &point)
+{
+    quint32 x = quint32(CLAMP(qRound(point.x() * 256), 0, 0xFFFF));
+    quint32 y = quint32(CLAMP(qRound(point.y() * 256), 0, 0xFFFF));
+
+    m_positionMailbox.post((x << 16) | y);
+}
+
 void VCXYPadArea::slotFixturePositions(const QVariantList positions)
 {
     if (positions == m_fixturePositions)
@@ -25,6 +25,7 @@
 #include <QMutex>
 #include <QFrame>
 
+#include "valuemailbox.h"
 #include "doc.h"
 
 class EFXPreviewArea;
@@ -68,6 +69,17 @@ public:
     /** Check if the position has changed since the last currentXYPosition() call */
     bool hasPositionChanged();
 
+    /**
+     * Read the latest position without locking. This is meant to be called
+     * by the MasterTimer thread, at each tick.
+     *
+     * @param point The current position
+     * @param sequence The last sequence seen by the caller, updated on return
+     * @param timestamp If not NULL, it is set to the time of the last change
+     * @return true if the position has changed since $sequence
+     */
+    bool fetchPosition(QPointF& point, int& sequence, quint32* timestamp = NULL) const;
+
 signals:
     void positionChanged(const QPointF& point);
 
@@ -81,6 +93,9 @@ private:
     /** Compute m_windowPos from mdmxPos */
     void updateWindowPos();
 
+    /** Post $point to m_positionMailbox. Must be called with m_mutex locked */
+    void postPosition(const QPointF& point);
+
     QString positionString() const;
 
     QString angleString() const;
@@ -99,6 +114,9 @@ private:
     mutable bool m_changed;
     mutable QMutex m_mutex;
 
+    /** The latest position for the engine, packed as 8.8 fixed point X and Y */
+    ValueMailbox m_positionMailbox;
+
     /** Used to display active point - blue */
     QPixmap m_activePixmap;
 
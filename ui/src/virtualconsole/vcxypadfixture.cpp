@@ -541,6 +541,20 @@ void VCXYPadFixture::writeDMX(qreal xmul, qreal ymul, QList<Universe *> universe
     }
 }
 
+void VCXYPadFixture::markInputTimestamp(QList<Universe *> universes, quint32 timestamp)
+{
+    if (m_xMSB == QLCChannel::invalid() || m_yMSB == QLCChannel::invalid())
+        return;
+
+    int uni = m_xMSB >> 9;
+    if (uni < universes.count())
+        universes[uni]->markInputTimestamp(timestamp);
+
+    uni = m_yMSB >> 9;
+    if (uni < universes.count())
+        universes[uni]->markInputTimestamp(timestamp);
+}
+
 void VCXYPadFixture::readDMX(QList<Universe*> universes, qreal & xmul, qreal & ymul)
 {
     xmul = -1;
@@ -169,6 +169,10 @@ public:
     /** Write the value using x & y multipliers for the actual range */
     void writeDMX(qreal xmul, qreal ymul, QList<Universe*> universes);
 
+    /** Notify the universes of this fixture that a position posted
+     *  at $timestamp has been written (see ValueMailbox) */
+    void markInputTimestamp(QList<Universe*> universes, quint32 timestamp);
+
     /** Read position from the current universe */
     void readDMX(QList<Universe*> universes, qreal & xmul, qreal & ymul);
 
@@ -8,6 +8,13 @@ cd plugins\artnet\src
 IF NOT %ERRORLEVEL%==0 exit /B %ERRORLEVEL%
 popd
 
+REM OSC test
+pushd .
+cd plugins\osc\test
+osc_test.exe
+IF NOT %ERRORLEVEL%==0 exit /B %ERRORLEVEL%
+popd
+
 REM Enttec wing test
 pushd .
 cd plugins\ewinginput\src
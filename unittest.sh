@@ -162,6 +162,21 @@ if [ $RESULT != 0 ]; then
 fi
 popd
 
+#############################################################################
+# OSC tests
+#############################################################################
+
+$SLEEPCMD
+pushd .
+cd plugins/osc/test
+$TESTPREFIX ./test.sh
+RESULT=$?
+if [ $RESULT != 0 ]; then
+	echo "${RESULT} OSC unit tests failed. Please fix before commit."
+	exit $RESULT
+fi
+popd
+
 #############################################################################
 # Final judgment
 #############################################################################
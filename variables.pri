@@ -29,6 +29,10 @@ CONFIG         -= release
 # Disable this when making a release
 CONFIG         += debug
 
+# Compile in the engine trace points (see engine/src/qlctrace.h)
+# Enable with: qmake CONFIG+=qlctrace
+CONFIG(qlctrace): DEFINES += QLC_TRACING
+
 !macx:!ios: {
  system( g++ --version | grep -e "4.6.[0-9]" ) {
    #message("g++ version 4.6 found")
@@ -49,12 +49,14 @@ SOURCES = qhttpserver/http_parser.c \
 HEADERS += commonjscss.h \
            webaccess.h \
            webaccessconfiguration.h \
+           webaccessserver.h \
            webaccesssimpledesk.h
 
 unix:!macx: HEADERS += webaccessnetwork.h
 
 SOURCES += webaccess.cpp \
            webaccessconfiguration.cpp \
+           webaccessserver.cpp \
            webaccesssimpledesk.cpp
 
 unix:!macx: SOURCES += webaccessnetwork.cpp
@@ -20,11 +20,13 @@
 #include <QDebug>
 #include <QProcess>
 #include <QSettings>
+#include <QThread>
 
 #include "webaccess.h"
 
 #include "webaccessconfiguration.h"
 #include "webaccesssimpledesk.h"
+#include "webaccessserver.h"
 #include "webaccessnetwork.h"
 #include "vcaudiotriggers.h"
 #include "virtualconsole.h"
@@ -48,10 +50,6 @@
 #include "audiocapture.h"
 #include "audiorenderer.h"
 
-#include "qhttpserver.h"
-#include "qhttprequest.h"
-#include "qhttpresponse.h"
-#include "qhttpconnection.h"
 
 #define AUTOSTART_PROJECT_NAME "autostart.qxw"
 
@@ -65,15 +63,30 @@ WebAccess::WebAccess(Doc *doc, VirtualConsole *vcInstance, SimpleDesk *sdInstanc
     Q_ASSERT(m_doc != NULL);
     Q_ASSERT(m_vc != NULL);
 
-    m_httpServer = new QHttpServer(this);
-    connect(m_httpServer, SIGNAL(newRequest(QHttpRequest*, QHttpResponse*)),
-            this, SLOT(slotHandleRequest(QHttpRequest*, QHttpResponse*)));
-    connect(m_httpServer, SIGNAL(webSocketDataReady(QHttpConnection*,QString)),
-            this, SLOT(slotHandleWebSocketRequest(QHttpConnection*,QString)));
-    connect(m_httpServer, SIGNAL(webSocketConnectionClose(QHttpConnection*)),
-            this, SLOT(slotHandleWebSocketClose(QHttpConnection*)));
-
-    m_httpServer->listen(QHostAddress::Any, 9999);
+    /* Sockets, HTTP parsing and websocket framing run on their own thread,
+     * so that remote clients can't slow down the UI */
+    m_serverThread = new QThread(this);
+    m_serverThread->setObjectName("WebAccess");
+    m_server = new WebAccessServer(9999);
+    m_server->moveToThread(m_serverThread);
+
+    connect(m_serverThread, SIGNAL(started()),
+            m_server, SLOT(slotStart()));
+    connect(m_serverThread, SIGNAL(finished()),
+            m_server, SLOT(deleteLater()));
+
+    connect(m_server, SIGNAL(pageRequested(quint32,QString,QByteArray)),
+            this, SLOT(slotHandlePageRequest(quint32,QString,QByteArray)));
+    connect(m_server, SIGNAL(webSocketRequestsReady()),
+            this, SLOT(slotHandleWebSocketRequests()));
+    connect(this, SIGNAL(pageReady(quint32,QByteArray)),
+            m_server, SLOT(slotSendPage(quint32,QByteArray)));
+    connect(this, SIGNAL(webSocketReply(quint32,QByteArray)),
+            m_server, SLOT(slotSendWebSocketMessage(quint32,QByteArray)));
+    connect(this, SIGNAL(webSocketBroadcast(QByteArray)),
+            m_server, SLOT(slotBroadcastWebSocketMessage(QByteArray)));
+
+    m_serverThread->start();
 
 #if defined(Q_WS_X11) || defined(Q_OS_LINUX)
     m_netConfig = new WebAccessNetwork();
@@ -85,46 +98,28 @@ WebAccess::WebAccess(Doc *doc, VirtualConsole *vcInstance, SimpleDesk *sdInstanc
 
 WebAccess::~WebAccess()
 {
+    // the server is deleted when its thread finishes
+    m_serverThread->quit();
+    m_serverThread->wait();
+
 #if defined(Q_WS_X11) || defined(Q_OS_LINUX)
     delete m_netConfig;
 #endif
-    foreach(QHttpConnection *conn, m_webSocketsList)
-        delete conn;
 }
 
-void WebAccess::slotHandleRequest(QHttpRequest *req, QHttpResponse *resp)
+void WebAccess::slotHandlePageRequest(quint32 requestId, QString url, QByteArray body)
 {
-    QString reqUrl = req->url().toString();
     QString content;
 
-    qDebug() << Q_FUNC_INFO << req->methodString() << req->url();
-
-    if (reqUrl == "/qlcplusWS")
-    {
-        resp->setHeader("Upgrade", "websocket");
-        resp->setHeader("Connection", "Upgrade");
-        QByteArray hash = resp->getWebSocketHandshake(req->header("sec-websocket-key"));
-        //QByteArray hash = resp->getWebSocketHandshake("zTvHabaaTOEORzqK+d1yxw==");
-        qDebug() << "Websocket handshake:" << hash;
-        resp->setHeader("Sec-WebSocket-Accept", hash);
-        QHttpConnection *conn = resp->enableWebSocket(true);
-        if (conn != NULL)
-            m_webSocketsList.append(conn);
-
-        resp->writeHead(101);
-        resp->end(QByteArray());
-
-        return;
-    }
-    else if (reqUrl == "/loadProject")
+    if (url == "/loadProject")
     {
-        QByteArray projectXML = req->body();
+        QByteArray projectXML = body;
 
         projectXML.remove(0, projectXML.indexOf("\n\r\n") + 3);
         projectXML.truncate(projectXML.lastIndexOf("\n\r\n"));
 
         //qDebug() << "Project XML:\n\n" << QString(projectXML) << "\n\n";
-        qDebug() << "Workspace XML received. Content-Length:" << req->headers().value("content-length") << projectXML.size();
+        qDebug() << "Workspace XML received. Size:" << projectXML.size();
 
         QByteArray postReply =
                 QString("<html><head>\n<meta http-equiv=\"content-type\" content=\"text/html; charset=utf-8\" />\n"
@@ -135,10 +130,7 @@ void WebAccess::slotHandleRequest(QHttpRequest *req, QHttpResponse *resp)
                 + tr("Loading project...") +
                 "</div></body></html>").toUtf8();
 
-        resp->setHeader("Content-Type", "text/html");
-        resp->setHeader("Content-Length", QString::number(postReply.size()));
-        resp->writeHead(200);
-        resp->end(postReply);
+        emit pageReady(requestId, postReply);
 
         m_pendingProjectLoaded = false;
 
@@ -146,9 +138,9 @@ void WebAccess::slotHandleRequest(QHttpRequest *req, QHttpResponse *resp)
 
         return;
     }
-    else if (reqUrl == "/loadFixture")
+    else if (url == "/loadFixture")
     {
-        QByteArray fixtureXML = req->body();
+        QByteArray fixtureXML = body;
         int fnamePos = fixtureXML.indexOf("filename=") + 10;
         QString fxName = fixtureXML.mid(fnamePos, fixtureXML.indexOf("\"", fnamePos) - fnamePos);
 
@@ -167,81 +159,41 @@ void WebAccess::slotHandleRequest(QHttpRequest *req, QHttpResponse *resp)
                       " window.location = \"/config\"\n"
                       "</script></head></html>").toUtf8();
 
-        resp->setHeader("Content-Type", "text/html");
-        resp->setHeader("Content-Length", QString::number(postReply.size()));
-        resp->writeHead(200);
-        resp->end(postReply);
+        emit pageReady(requestId, postReply);
 
         return;
     }
-    else if (reqUrl == "/config")
+    else if (url == "/config")
     {
         content = WebAccessConfiguration::getHTML(m_doc);
     }
-    else if (reqUrl == "/simpleDesk")
+    else if (url == "/simpleDesk")
     {
         content = WebAccessSimpleDesk::getHTML(m_doc, m_sd);
     }
   #if defined(Q_WS_X11) || defined(Q_OS_LINUX)
-    else if (reqUrl == "/system")
+    else if (url == "/system")
     {
         content = m_netConfig->getHTML();
     }
   #endif
-    else if (reqUrl.endsWith(".png"))
-    {
-        if (sendFile(resp, QString(":%1").arg(reqUrl), "image/png") == true)
-            return;
-    }
-    else if (reqUrl.endsWith(".css"))
-    {
-        QString clUri = reqUrl.mid(1);
-        if (sendFile(resp, QString("%1%2%3").arg(QLCFile::systemDirectory(WEBFILESDIR).path())
-                     .arg(QDir::separator()).arg(clUri), "text/css") == true)
-            return;
-    }
-    else if (reqUrl.endsWith(".js"))
-    {
-        QString clUri = reqUrl.mid(1);
-        if (sendFile(resp, QString("%1%2%3").arg(QLCFile::systemDirectory(WEBFILESDIR).path())
-                     .arg(QDir::separator()).arg(clUri), "text/javascript") == true)
-            return;
-    }
-    else if (reqUrl.endsWith(".html"))
-    {
-        QString clUri = reqUrl.mid(1);
-        if (sendFile(resp, QString("%1%2%3").arg(QLCFile::systemDirectory(WEBFILESDIR).path())
-                     .arg(QDir::separator()).arg(clUri), "text/html") == true)
-            return;
-    }
-    else if (reqUrl != "/")
-    {
-        resp->writeHead(404);
-        resp->setHeader("Content-Type", "text/plain");
-        resp->setHeader("Content-Length", "14");
-        resp->end(QByteArray("404 Not found"));
-        return;
-    }
-    else
+    else if (url == "/")
         content = getVCHTML();
 
-    // Prepare the message we're going to send
-    QByteArray contentArray = content.toUtf8();
+    // the message is encoded and sent on the server thread
+    emit pageReady(requestId, content.toUtf8());
+}
 
-    // Send HTTP reply to the client
-    resp->setHeader("Content-Type", "text/html");
-    resp->setHeader("Content-Length", QString::number(contentArray.size()));
-    resp->writeHead(200);
-    resp->end(contentArray);
+void WebAccess::slotHandleWebSocketRequests()
+{
+    QList< QPair<quint32, QString> > requests = m_server->takeWebSocketRequests();
 
-    return;
+    for (int i = 0; i < requests.count(); i++)
+        handleWebSocketRequest(requests.at(i).first, requests.at(i).second);
 }
 
-void WebAccess::slotHandleWebSocketRequest(QHttpConnection *conn, QString data)
+void WebAccess::handleWebSocketRequest(quint32 connId, QString data)
 {
-    if (conn == NULL)
-        return;
-
     qDebug() << "[websocketDataHandler]" << data;
 
     QStringList cmdList = data.split("|");
@@ -330,7 +282,7 @@ void WebAccess::slotHandleWebSocketRequest(QHttpConnection *conn, QString data)
             if (m_netConfig->updateNetworkFile(cmdList) == true)
             {
                 QString wsMessage = QString("ALERT|" + tr("Network configuration changed. Reboot to apply the changes."));
-                conn->webSocketWrite(QHttpConnection::TextFrame, wsMessage.toUtf8());
+                emit webSocketReply(connId, wsMessage.toUtf8());
                 return;
             }
             else
@@ -349,7 +301,7 @@ void WebAccess::slotHandleWebSocketRequest(QHttpConnection *conn, QString data)
             else
                 emit storeAutostartProject(asName);
             QString wsMessage = QString("ALERT|" + tr("Autostart configuration changed"));
-            conn->webSocketWrite(QHttpConnection::TextFrame, wsMessage.toUtf8());
+            emit webSocketReply(connId, wsMessage.toUtf8());
             return;
         }
         else if (cmdList.at(1) == "REBOOT")
@@ -512,7 +464,7 @@ void WebAccess::slotHandleWebSocketRequest(QHttpConnection *conn, QString data)
         }
         //qDebug() << "Simple desk channels:" << wsAPIMessage;
 
-        conn->webSocketWrite(QHttpConnection::TextFrame, wsAPIMessage.toUtf8());
+        emit webSocketReply(connId, wsAPIMessage.toUtf8());
         return;
     }
     else if(cmdList[0] == "CH")
@@ -526,8 +478,6 @@ void WebAccess::slotHandleWebSocketRequest(QHttpConnection *conn, QString data)
 
         return;
     }
-    else if(cmdList[0] == "POLL")
-        return;
 
     if (data.contains("|") == false)
         return;
@@ -596,37 +546,9 @@ void WebAccess::slotHandleWebSocketRequest(QHttpConnection *conn, QString data)
     }
 }
 
-void WebAccess::slotHandleWebSocketClose(QHttpConnection *conn)
-{
-    m_webSocketsList.removeOne(conn);
-}
-
-bool WebAccess::sendFile(QHttpResponse *response, QString filename, QString contentType)
-{
-    QFile resFile(filename);
-    if (resFile.open(QIODevice::ReadOnly))
-    {
-        QByteArray resContent = resFile.readAll();
-        qDebug() << "Resource file length:" << resContent.length();
-        resFile.close();
-
-        response->setHeader("Content-Type", contentType);
-        response->setHeader("Content-Length", QString::number(resContent.size()));
-        response->writeHead(200);
-        response->end(resContent);
-
-        return true;
-    }
-    else
-        qDebug() << "Failed to open file:" << filename;
-
-    return false;
-}
-
 void WebAccess::sendWebSocketMessage(QByteArray message)
 {
-    foreach(QHttpConnection *conn, m_webSocketsList)
-        conn->webSocketWrite(QHttpConnection::TextFrame, message);
+    emit webSocketBroadcast(message);
 }
 
 QString WebAccess::getWidgetHTML(VCWidget *widget)
@@ -38,10 +38,8 @@ class VCLabel;
 class VCFrame;
 class Doc;
 
-class QHttpServer;
-class QHttpRequest;
-class QHttpResponse;
-class QHttpConnection;
+class WebAccessServer;
+class QThread;
 
 class WebAccess : public QObject
 {
@@ -52,8 +50,8 @@ public:
     ~WebAccess();
 
 private:
-    bool sendFile(QHttpResponse *response, QString filename, QString contentType);
     void sendWebSocketMessage(QByteArray message);
+    void handleWebSocketRequest(quint32 connId, QString data);
 
     QString getWidgetHTML(VCWidget *widget);
     QString getFrameHTML(VCFrame *frame);
@@ -70,9 +68,8 @@ private:
     QString getSimpleDeskHTML();
 
 protected slots:
-    void slotHandleRequest(QHttpRequest *req, QHttpResponse *resp);
-    void slotHandleWebSocketRequest(QHttpConnection *conn, QString data);
-    void slotHandleWebSocketClose(QHttpConnection *conn);
+    void slotHandlePageRequest(quint32 requestId, QString url, QByteArray body);
+    void slotHandleWebSocketRequests();
 
     void slotVCLoaded();
     void slotButtonToggled(bool on);
@@ -92,8 +89,9 @@ protected:
     WebAccessNetwork *m_netConfig;
 #endif
 
-    QHttpServer *m_httpServer;
-    QList<QHttpConnection *> m_webSocketsList;
+    /** The HTTP server and the thread it runs on */
+    QThread *m_serverThread;
+    WebAccessServer *m_server;
 
     bool m_pendingProjectLoaded;
 
@@ -102,6 +100,11 @@ signals:
     void loadProject(QString xmlData);
     void storeAutostartProject(QString filename);
 
+    /** Queued to the server thread */
+    void pageReady(quint32 requestId, QByteArray content);
+    void webSocketReply(quint32 connId, QByteArray message);
+    void webSocketBroadcast(QByteArray message);
+
 public slots:
 
 };
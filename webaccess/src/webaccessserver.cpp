@@ -0,0 +1,247 @@
+/*
+  Q Light Controller Plus
+  webaccessserver.cpp
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <QMutexLocker>
+#include <QDebug>
+#include <QFile>
+#include <QDir>
+
+#include "webaccessserver.h"
+#include "qlcconfig.h"
+#include "qlcfile.h"
+
+#include "qhttpserver.h"
+#include "qhttprequest.h"
+#include "qhttpresponse.h"
+#include "qhttpconnection.h"
+
+WebAccessServer::WebAccessServer(quint16 port, QObject *parent)
+    : QObject(parent)
+    , m_port(port)
+    , m_httpServer(NULL)
+    , m_lastId(0)
+{
+}
+
+WebAccessServer::~WebAccessServer()
+{
+    foreach(QHttpConnection *conn, m_webSockets)
+    {
+        disconnect(conn, SIGNAL(destroyed(QObject*)),
+                   this, SLOT(slotConnectionDestroyed(QObject*)));
+        delete conn;
+    }
+}
+
+void WebAccessServer::slotStart()
+{
+    m_httpServer = new QHttpServer(this);
+    connect(m_httpServer, SIGNAL(newRequest(QHttpRequest*, QHttpResponse*)),
+            this, SLOT(slotHandleRequest(QHttpRequest*, QHttpResponse*)));
+    connect(m_httpServer, SIGNAL(webSocketDataReady(QHttpConnection*,QString)),
+            this, SLOT(slotHandleWebSocketRequest(QHttpConnection*,QString)));
+    connect(m_httpServer, SIGNAL(webSocketConnectionClose(QHttpConnection*)),
+            this, SLOT(slotHandleWebSocketClose(QHttpConnection*)));
+
+    if (m_httpServer->listen(QHostAddress::Any, m_port) == false)
+        qWarning() << Q_FUNC_INFO << "Unable to listen on port" << m_port;
+}
+
+void WebAccessServer::slotHandleRequest(QHttpRequest *req, QHttpResponse *resp)
+{
+    QString reqUrl = req->url().toString();
+
+    qDebug() << Q_FUNC_INFO << req->methodString() << req->url();
+
+    if (reqUrl == "/qlcplusWS")
+    {
+        resp->setHeader("Upgrade", "websocket");
+        resp->setHeader("Connection", "Upgrade");
+        QByteArray hash = resp->getWebSocketHandshake(req->header("sec-websocket-key"));
+        qDebug() << "Websocket handshake:" << hash;
+        resp->setHeader("Sec-WebSocket-Accept", hash);
+        QHttpConnection *conn = resp->enableWebSocket(true);
+        if (conn != NULL)
+        {
+            m_webSockets.insert(++m_lastId, conn);
+            // connections might go away without a close frame
+            connect(conn, SIGNAL(destroyed(QObject*)),
+                    this, SLOT(slotConnectionDestroyed(QObject*)));
+        }
+
+        resp->writeHead(101);
+        resp->end(QByteArray());
+
+        return;
+    }
+    else if (reqUrl == "/" || reqUrl == "/loadProject" || reqUrl == "/loadFixture" ||
+             reqUrl == "/config" || reqUrl == "/simpleDesk"
+#if defined(Q_WS_X11) || defined(Q_OS_LINUX)
+             || reqUrl == "/system"
+#endif
+             )
+    {
+        // generated by WebAccess on the UI thread
+        quint32 requestId = ++m_lastId;
+        m_pendingResponses.insert(requestId, QPointer<QHttpResponse>(resp));
+        emit pageRequested(requestId, reqUrl, req->body());
+        return;
+    }
+    else if (reqUrl.endsWith(".png"))
+    {
+        if (sendFile(resp, QString(":%1").arg(reqUrl), "image/png") == true)
+            return;
+    }
+    else if (reqUrl.endsWith(".css"))
+    {
+        QString clUri = reqUrl.mid(1);
+        if (sendFile(resp, QString("%1%2%3").arg(QLCFile::systemDirectory(WEBFILESDIR).path())
+                     .arg(QDir::separator()).arg(clUri), "text/css") == true)
+            return;
+    }
+    else if (reqUrl.endsWith(".js"))
+    {
+        QString clUri = reqUrl.mid(1);
+        if (sendFile(resp, QString("%1%2%3").arg(QLCFile::systemDirectory(WEBFILESDIR).path())
+                     .arg(QDir::separator()).arg(clUri), "text/javascript") == true)
+            return;
+    }
+    else if (reqUrl.endsWith(".html"))
+    {
+        QString clUri = reqUrl.mid(1);
+        if (sendFile(resp, QString("%1%2%3").arg(QLCFile::systemDirectory(WEBFILESDIR).path())
+                     .arg(QDir::separator()).arg(clUri), "text/html") == true)
+            return;
+    }
+    else
+    {
+        resp->writeHead(404);
+        resp->setHeader("Content-Type", "text/plain");
+        resp->setHeader("Content-Length", "14");
+        resp->end(QByteArray("404 Not found"));
+        return;
+    }
+
+    // a file that could not be read
+    resp->setHeader("Content-Type", "text/html");
+    resp->setHeader("Content-Length", "0");
+    resp->writeHead(200);
+    resp->end(QByteArray());
+}
+
+void WebAccessServer::slotSendPage(quint32 requestId, QByteArray content)
+{
+    QPointer<QHttpResponse> resp = m_pendingResponses.take(requestId);
+
+    // the client might have gone in the meantime
+    if (resp.isNull())
+        return;
+
+    resp->setHeader("Content-Type", "text/html");
+    resp->setHeader("Content-Length", QString::number(content.size()));
+    resp->writeHead(200);
+    resp->end(content);
+}
+
+void WebAccessServer::slotHandleWebSocketRequest(QHttpConnection *conn, QString data)
+{
+    if (conn == NULL)
+        return;
+
+    // keep alive messages don't need the UI thread
+    if (data == "POLL")
+        return;
+
+    quint32 connId = m_webSockets.key(conn, 0);
+    if (connId == 0)
+        return;
+
+    bool notify = false;
+    {
+        QMutexLocker locker(&m_requestsMutex);
+        notify = m_requests.isEmpty();
+        m_requests.append(QPair<quint32, QString>(connId, data));
+    }
+
+    // a burst of commands (e.g. a slider being dragged) is handled at once
+    if (notify)
+        emit webSocketRequestsReady();
+}
+
+QList< QPair<quint32, QString> > WebAccessServer::takeWebSocketRequests()
+{
+    QMutexLocker locker(&m_requestsMutex);
+    QList< QPair<quint32, QString> > requests = m_requests;
+    m_requests.clear();
+    return requests;
+}
+
+void WebAccessServer::slotSendWebSocketMessage(quint32 connId, QByteArray message)
+{
+    QHttpConnection *conn = m_webSockets.value(connId, NULL);
+    if (conn != NULL)
+        conn->webSocketWrite(QHttpConnection::TextFrame, message);
+}
+
+void WebAccessServer::slotBroadcastWebSocketMessage(QByteArray message)
+{
+    foreach(QHttpConnection *conn, m_webSockets)
+        conn->webSocketWrite(QHttpConnection::TextFrame, message);
+}
+
+void WebAccessServer::slotHandleWebSocketClose(QHttpConnection *conn)
+{
+    quint32 connId = m_webSockets.key(conn, 0);
+    if (connId != 0)
+        m_webSockets.remove(connId);
+}
+
+void WebAccessServer::slotConnectionDestroyed(QObject *object)
+{
+    // the object is not a QHttpConnection anymore, so compare the pointers only
+    QMutableHashIterator<quint32, QHttpConnection *> it(m_webSockets);
+    while (it.hasNext() == true)
+    {
+        it.next();
+        if (static_cast<QObject *>(it.value()) == object)
+            it.remove();
+    }
+}
+
+bool WebAccessServer::sendFile(QHttpResponse *response, QString filename, QString contentType)
+{
+    QFile resFile(filename);
+    if (resFile.open(QIODevice::ReadOnly))
+    {
+        QByteArray resContent = resFile.readAll();
+        qDebug() << "Resource file length:" << resContent.length();
+        resFile.close();
+
+        response->setHeader("Content-Type", contentType);
+        response->setHeader("Content-Length", QString::number(resContent.size()));
+        response->writeHead(200);
+        response->end(resContent);
+
+        return true;
+    }
+    else
+        qDebug() << "Failed to open file:" << filename;
+
+    return false;
+}
@@ -0,0 +1,107 @@
+/*
+  Q Light Controller Plus
+  webaccessserver.h
+
+  Copyright (c) Massimo Callegari
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef WEBACCESSSERVER_H
+#define WEBACCESSSERVER_H
+
+#include <QPointer>
+#include <QObject>
+#include <QMutex>
+#include <QHash>
+#include <QPair>
+#include <QList>
+
+class QHttpServer;
+class QHttpRequest;
+class QHttpResponse;
+class QHttpConnection;
+
+/**
+ * WebAccessServer runs the HTTP and websocket server of WebAccess on the
+ * thread it is moved to, so that slow clients and message encoding never
+ * hold the UI thread.
+ *
+ * Static files are served directly, while the pages and the websocket
+ * commands that need the Virtual Console or the engine are handed to
+ * WebAccess on the UI thread, which sends the results back with queued
+ * signals.
+ */
+class WebAccessServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    WebAccessServer(quint16 port, QObject *parent = 0);
+    ~WebAccessServer();
+
+    /**
+     * Take the websocket commands received since the last call, as pairs of
+     * connection ID and command. Can be called from any thread.
+     */
+    QList< QPair<quint32, QString> > takeWebSocketRequests();
+
+public slots:
+    /** Create the HTTP server and start listening. Called by the server thread */
+    void slotStart();
+
+    /** Send the content of a page requested with pageRequested() */
+    void slotSendPage(quint32 requestId, QByteArray content);
+
+    /** Send a message to the websocket with the given connection ID */
+    void slotSendWebSocketMessage(quint32 connId, QByteArray message);
+
+    /** Send a message to all the connected websockets */
+    void slotBroadcastWebSocketMessage(QByteArray message);
+
+signals:
+    /** A page that needs the UI thread to be generated has been requested */
+    void pageRequested(quint32 requestId, QString url, QByteArray body);
+
+    /**
+     * Websocket commands are waiting to be taken with takeWebSocketRequests().
+     * This is emitted once until they are taken.
+     */
+    void webSocketRequestsReady();
+
+private slots:
+    void slotHandleRequest(QHttpRequest *req, QHttpResponse *resp);
+    void slotHandleWebSocketRequest(QHttpConnection *conn, QString data);
+    void slotHandleWebSocketClose(QHttpConnection *conn);
+    void slotConnectionDestroyed(QObject *object);
+
+private:
+    bool sendFile(QHttpResponse *response, QString filename, QString contentType);
+
+private:
+    quint16 m_port;
+    QHttpServer *m_httpServer;
+    quint32 m_lastId;
+
+    /** The open websockets, by connection ID */
+    QHash<quint32, QHttpConnection *> m_webSockets;
+
+    /** The responses waiting for their page content, by request ID */
+    QHash<quint32, QPointer<QHttpResponse> > m_pendingResponses;
+
+    /** The websocket commands not taken yet by the UI thread */
+    QMutex m_requestsMutex;
+    QList< QPair<quint32, QString> > m_requests;
+};
+
+#endif // WEBACCESSSERVER_H